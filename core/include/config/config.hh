@@ -118,4 +118,25 @@ namespace libcxx = ::std;
 #   define _HELIX_SUPPRESS_UNREACHABLE_WARN_POP
 #endif
 
+/// how much of the call stack the `__REGISTER_*_TRACE_BLOCK__` macros record for panics and the
+/// profiler; lower levels expand the skipped macros to nothing.
+///   HELIX_TRACE_OFF    no registration, traces show native frames only
+///   HELIX_TRACE_HELIX  Helix functions only (`__REGISTER_TRACE_BLOCK__` and the Helix form)
+///   HELIX_TRACE_FULL   Helix functions and the hybrid C++ runtime functions
+#define HELIX_TRACE_OFF   0
+#define HELIX_TRACE_HELIX 1
+#define HELIX_TRACE_FULL  2
+
+#ifndef HELIX_TRACE_LEVEL
+#   define HELIX_TRACE_LEVEL HELIX_TRACE_FULL
+#endif
+
+/// thread-locals the runtime touches on every traced call or from signal handlers: initial-exec
+/// makes each access one %fs-relative load instead of a `__tls_get_addr` call in PIC code
+#if defined(__GNUC__) || defined(__clang__)
+#   define HELIX_TLS_INITIAL_EXEC __attribute__((tls_model("initial-exec")))
+#else
+#   define HELIX_TLS_INITIAL_EXEC
+#endif
+
 #endif
\ No newline at end of file
@@ -59,9 +59,11 @@ H_NAMESPACE_BEGIN
 ///    ```
 ///
 /// ### Implementation
-/// - `$finally` wraps a callable provided at construction and executes it in its destructor.
-/// - It leverages the `$function<void()>` type for callable storage, enabling type erasure and
-///   support for various callable types such as lambdas, function pointers, and functors.
+/// - `$finally<Fn>` holds the callable provided at construction by value and runs it in its
+///   destructor, so a `finally` block costs what its body costs: there is no allocation and the
+///   compiler can inline the cleanup. `Fn` is deduced from the constructor argument.
+/// - `$finally<>` stores a `$function<void()>` for the places that need one type for every
+///   guard, such as a member or a container of guards.
 ///
 /// ### Example
 /// ```helix
@@ -74,6 +76,11 @@ H_NAMESPACE_BEGIN
 /// }
 /// ```
 ///
+/// which lowers to
+/// ```cpp
+/// $finally guard([&] { print("This runs when 'example' exits."); });  // $finally<lambda>
+/// ```
+///
 /// ### Notes
 /// - This construct is unique to Helix and designed for maximum flexibility and simplicity.
 /// - When combined with `try-catch`, it ensures code in the `finally` block executes regardless
@@ -83,32 +90,57 @@ H_NAMESPACE_BEGIN
 /// ### Design
 /// - `$finally` objects are non-copyable and non-movable to ensure that their associated callable
 ///   always runs at the intended scope exit.
-/// - The destructor executes the stored callable if one was provided at construction.
-///
-/// ### Limitations
-/// - `$finally` depends on `$function` for its callable implementation. Future work may involve
-///   reducing this dependency for tighter integration with the Helix runtime.
+/// - The destructor executes the stored callable if one was provided at construction and the
+///   guard was not dismissed.
+/// - `dismiss()` disarms the guard, for cleanup that is only needed on the failure path, and
+///   `rearm()` arms it again.
+template <typename Fn = $function<void()>>
 class $finally {
   public:
-    $finally()                            = default;
+    $finally() noexcept(libcxx::is_nothrow_default_constructible_v<Fn>)
+        : m_armed(false) {}
     $finally(const $finally &)            = delete;
     $finally($finally &&)                 = delete;
     $finally &operator=(const $finally &) = delete;
     $finally &operator=($finally &&)      = delete;
     ~$finally() {
-        if (m_fn) {
+        if (m_armed) {
             m_fn();
         }
     }
 
-    template <typename Fn>
-    explicit $finally(Fn &&fn)
-        : m_fn{std::Memory::forward<Fn>(fn)} {}
+    template <typename F>
+        requires libcxx::is_constructible_v<Fn, F &&>
+    explicit $finally(F &&fn) noexcept(libcxx::is_nothrow_constructible_v<Fn, F &&>)
+        : m_fn(std::Memory::forward<F>(fn)) {
+        // an empty `$function` or a null function pointer has nothing to run
+        if constexpr (libcxx::is_constructible_v<bool, const Fn &>) {
+            m_armed = static_cast<bool>(m_fn);
+        }
+    }
+
+    /// the callable will not run when the scope ends
+    void dismiss() noexcept { m_armed = false; }
+
+    /// undoes `dismiss`; a guard holding nothing to run stays disarmed, as it was constructed
+    void rearm() noexcept {
+        if constexpr (libcxx::is_constructible_v<bool, const Fn &>) {
+            m_armed = static_cast<bool>(m_fn);
+        } else {
+            m_armed = true;
+        }
+    }
+
+    [[nodiscard]] bool armed() const noexcept { return m_armed; }
 
   private:
-    $function<void()> m_fn;
+    Fn   m_fn{};
+    bool m_armed = true;
 };
 
+template <typename Fn>
+$finally(Fn) -> $finally<Fn>;
+
 H_NAMESPACE_END
 
 #endif  // _$_HX_CORE_M7FINALLY
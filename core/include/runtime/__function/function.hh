@@ -17,6 +17,7 @@
 #define _$_HX_CORE_M8FUNCTION
 
 #include <include/runtime/__function/function_impl.hh>
+#include <include/runtime/__function/function_ref.hh>
 
 H_NAMESPACE_BEGIN
 H_STD_NAMESPACE_BEGIN
@@ -29,6 +30,13 @@ H_STD_NAMESPACE_BEGIN
 template <typename Rt, typename... Tp>
 using Function = $function<Rt(Tp...)>;
 
+/// \typedef FunctionRef
+///
+/// The same for `$function_ref`, the non-owning form for callables that are only called before
+/// the function taking them returns.
+template <typename Rt, typename... Tp>
+using FunctionRef = $function_ref<Rt(Tp...)>;
+
 H_STD_NAMESPACE_END
 H_NAMESPACE_END
 
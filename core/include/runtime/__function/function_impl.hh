@@ -26,7 +26,7 @@ H_NAMESPACE_BEGIN
 
 /// \class $function
 ///
-/// The `$function` class is a type-erased, dynamically allocated wrapper for callable entities.
+/// The `$function` class is a type-erased wrapper for callable entities.
 /// It provides a uniform interface for invoking various callable objects, including function
 /// pointers, lambdas, and functors, with the same signature.
 template <typename Sig>
@@ -39,8 +39,7 @@ class $function;
 /// implementing higher-order functions, callbacks, and functional programming paradigms in Helix.
 ///
 /// ### Overview
-/// `$function` serves as a type-erased, dynamically allocated wrapper for various callable
-/// entities, including:
+/// `$function` serves as a type-erased wrapper for various callable entities, including:
 /// - Lambdas.
 /// - Function pointers.
 /// - Functor objects (classes with `operator()`).
@@ -66,6 +65,8 @@ class $function;
 ///     ```
 /// - **Memory Management**:
 ///   - Manages the lifetime of the callable object.
+///   - Function pointers, and callables of up to `inline_size` bytes that move without throwing,
+///     are kept inside the `$function` itself; only larger ones are allocated.
 ///   - Provides explicit control via the `reset()` method to clear the current callable.
 /// - **Copy and Move Semantics**:
 ///   - Supports both copy and move operations for flexible ownership management.
@@ -73,14 +74,17 @@ class $function;
 ///   - Can be evaluated in boolean contexts to check if it holds a callable.
 ///
 /// ### Components
-/// #### `$callable`
-/// An abstract base struct that defines the interface for all wrapped callable types:
+/// #### `Ops`
+/// The table of everything type-specific about the stored callable, one static instance per
+/// callable type, in place of a polymorphic base:
 /// - `invoke`: Executes the callable with the provided arguments.
-/// - `clone`: Creates a deep copy of the callable.
+/// - `copy`, `move`, `destroy`: Manage the storage. A null entry means the storage is copied as
+///   plain bytes, or needs no cleanup, which is the case for function pointers and small
+///   trivially copyable lambdas.
 ///
-/// #### `Callable`
-/// A templated implementation of `$callable` for a specific callable type. Manages the storage,
-/// invocation, and copying of the wrapped callable.
+/// #### `Storage`
+/// Either the callable itself, in a buffer of `inline_size` bytes, or a pointer to it when it
+/// does not fit.
 ///
 /// ### Functionality
 /// #### Construction
@@ -138,110 +142,167 @@ class $function;
 /// - Lambdas: Inline callable constructs supported by `$function`.
 template <typename Rt, typename... Tp>
 class $function<Rt(Tp...)> {
+  public:
+    /// callables up to this size are stored inline if they are pointer-aligned and move
+    /// without throwing
+    static constexpr usize inline_size = 3 * sizeof(void *);
+
   private:
-    /// \struct $callable
-    ///
-    /// The base class for all callable entities managed by `$function`. This abstract class
-    /// provides the foundation for type erasure and runtime polymorphism, enabling `$function` to
-    /// work with any callable conforming to the specified signature.
-    ///
-    /// ### Purpose
-    /// `$callable` serves as the interface for:
-    /// - Storing callable objects of arbitrary types.
-    /// - Invoking those objects with a consistent interface.
-    /// - Cloning callable objects to support copy semantics in `$function`.
-    ///
-    /// By defining the essential methods (`invoke` and `clone`), `$callable` allows `$function` to
-    /// manage and invoke callable entities without knowing their exact types at compile time.
-    ///
-    /// ### Why It Exists
-    /// `$callable` abstracts the behavior of callable objects, enabling `$function` to:
-    /// - Store various callable types uniformly.
-    /// - Avoid direct dependency on specific callable implementations.
-    /// - Provide runtime flexibility with minimal overhead.
-    ///
-    /// ### Key Methods
-    /// - **`invoke(Tp... args)`**:
-    ///   Executes the callable with the provided arguments. Each derived class implements this
-    ///   method to handle invocation for its specific callable type.
-    /// - **`clone()`**:
-    ///   Creates a deep copy of the callable object. This supports the copy constructor and
-    ///   assignment operator in `$function`.
-    ///
-    /// ### Example
-    /// The `$function` class uses `$callable` to store and manage callable entities:
-    /// ```helix
-    /// $function<void(int)> f = [](int x) { print(x); };
-    /// f(42);  // Internally calls `$callable::invoke`.
-    /// ```
-    struct $callable {
-        constexpr $callable()                                 = default;
-        constexpr $callable(const $callable &)                = default;
-        constexpr $callable &operator=(const $callable &)     = default;
-        constexpr $callable($callable &&) noexcept            = default;
-        constexpr $callable &operator=($callable &&) noexcept = default;
-        constexpr virtual ~$callable()                        = default;
-        constexpr virtual Rt         invoke(Tp... args)       = 0;
-        constexpr virtual $callable *clone() const            = 0;
+    union Storage {
+        void *heap;
+        alignas(void *) unsigned char buffer[inline_size];
+    };
+
+    struct Ops {
+        Rt (*invoke)(Storage &, Tp &&...);
+        void (*copy)(Storage &, const Storage &);
+        void (*move)(Storage &, Storage &) noexcept;
+        void (*destroy)(Storage &) noexcept;
     };
 
     template <typename T>
-    struct Callable : $callable {
-        alignas(alignof(libcxx::max_align_t)) T callable;
+    static constexpr bool stored_inline = sizeof(T) <= inline_size &&
+                                          alignof(T) <= alignof(void *) &&
+                                          libcxx::is_nothrow_move_constructible_v<T>;
 
-        constexpr Callable(typename std::Meta::reference_removed<T>
-                               &&callable)  // NOLINT(google-explicit-constructor)
-            : callable(std::Memory::forward<T>(callable)) {}
+    template <typename T>
+    static constexpr T *target(Storage &storage) noexcept {
+        if constexpr (stored_inline<T>) {
+            return libcxx::launder(reinterpret_cast<T *>(storage.buffer));
+        } else {
+            return static_cast<T *>(storage.heap);
+        }
+    }
 
-        constexpr Callable(const T &callable)  // NOLINT(google-explicit-constructor)
-            : callable(callable) {}
+    template <typename T>
+    static constexpr const T *target(const Storage &storage) noexcept {
+        return target<T>(const_cast<Storage &>(storage));
+    }
+
+    template <typename T>
+    static constexpr Rt invoke_target(Storage &storage, Tp &&...args) {
+        return (*target<T>(storage))(std::Memory::forward<Tp>(args)...);
+    }
 
-        constexpr Rt invoke(Tp... args) override {
-            return callable(std::Memory::forward<Tp>(args)...);
+    template <typename T>
+    static constexpr void copy_target(Storage &dst, const Storage &src) {
+        if constexpr (stored_inline<T>) {
+            ::new (static_cast<void *>(dst.buffer)) T(*target<T>(src));
+        } else {
+            dst.heap = std::Memory::new_aligned<T>(*target<T>(src));
         }
+    }
+
+    template <typename T>
+    static constexpr void move_target(Storage &dst, Storage &src) noexcept {
+        T *from = target<T>(src);
+        ::new (static_cast<void *>(dst.buffer)) T(std::Memory::move(*from));
+        from->~T();
+    }
 
-        constexpr $callable *clone() const override {
-            return std::Memory::new_aligned<Callable<T>>(callable);
+    template <typename T>
+    static constexpr void destroy_target(Storage &storage) noexcept {
+        if constexpr (stored_inline<T>) {
+            target<T>(storage)->~T();
+        } else {
+            std::Memory::delete_aligned(target<T>(storage));
         }
-    };
+    }
 
-    $callable *callable;
+    /// a heap callable moves by handing over its pointer, and an inline trivially copyable one
+    /// by copying the buffer, so only the rest get a `move`
+    template <typename T>
+    static constexpr Ops make_ops() noexcept {
+        Ops ops{&invoke_target<T>, nullptr, nullptr, nullptr};
 
-  public:
-    constexpr $function()
-        : callable(nullptr) {}
+        if constexpr (!stored_inline<T> || !libcxx::is_trivially_copyable_v<T>) {
+            ops.copy    = &copy_target<T>;
+            ops.destroy = &destroy_target<T>;
+        }
 
-    constexpr $function($function &&other) noexcept
-        : callable(other.callable) {
-        other.callable = nullptr;
+        if constexpr (stored_inline<T> && !libcxx::is_trivially_copyable_v<T>) {
+            ops.move = &move_target<T>;
+        }
+
+        return ops;
     }
 
-    constexpr $function(const $function &other)
-        : callable(other.callable ? other.callable->clone() : nullptr) {}
+    template <typename T>
+    static constexpr Ops ops_for = make_ops<T>();
+
+    const Ops *ops = nullptr;
+    Storage    storage;
+
+    template <typename T, typename... Args>
+    constexpr void emplace(Args &&...args) {
+        if constexpr (stored_inline<T>) {
+            ::new (static_cast<void *>(storage.buffer)) T(std::Memory::forward<Args>(args)...);
+        } else {
+            storage.heap = std::Memory::new_aligned<T>(std::Memory::forward<Args>(args)...);
+        }
+
+        ops = &ops_for<T>;
+    }
+
+    constexpr void copy_from(const $function &other) {
+        if (other.ops == nullptr) {
+            return;
+        }
+
+        if (other.ops->copy == nullptr) {
+            storage = other.storage;
+        } else {
+            other.ops->copy(storage, other.storage);
+        }
+
+        ops = other.ops;
+    }
+
+    constexpr void move_from($function &other) noexcept {
+        if (other.ops == nullptr) {
+            return;
+        }
+
+        if (other.ops->move == nullptr) {
+            storage = other.storage;
+        } else {
+            other.ops->move(storage, other.storage);
+        }
+
+        ops       = other.ops;
+        other.ops = nullptr;
+    }
+
+  public:
+    constexpr $function() noexcept {}
+
+    constexpr $function($function &&other) noexcept { move_from(other); }
+
+    constexpr $function(const $function &other) { copy_from(other); }
 
     template <typename T>
     constexpr $function(
         typename std::Meta::reference_removed<T> $call_o) {  // NOLINT(google-explicit-constructor)
-        callable = new Callable<libcxx::decay_t<T>>(std::Memory::forward<T>($call_o));  // NOLINT
+        emplace<libcxx::decay_t<T>>(std::Memory::forward<T>($call_o));
     }
 
     template <typename T>
     constexpr $function(T $call_o) {  // NOLINT(google-explicit-constructor)
-        callable = new Callable<libcxx::decay_t<T>>(std::Memory::forward<T>($call_o));  // NOLINT
+        emplace<libcxx::decay_t<T>>(std::Memory::forward<T>($call_o));
     }
 
-    constexpr $function(Rt (*func)(Tp...))  // NOLINT(google-explicit-constructor)
-        : callable(func ? new Callable<std::Meta::const_volatile_removed<Rt (*)(Tp...)>>(func)
-                        : nullptr) {}
+    constexpr $function(Rt (*func)(Tp...)) {  // NOLINT(google-explicit-constructor)
+        if (func != nullptr) {
+            emplace<Rt (*)(Tp...)>(func);
+        }
+    }
 
     constexpr ~$function() { reset(); }
 
     constexpr $function &operator=($function &&other) noexcept {
         if (this != &other) {
             reset();
-
-            callable       = other.callable;
-            other.callable = nullptr;
+            move_from(other);
         }
 
         return *this;
@@ -250,41 +311,44 @@ class $function<Rt(Tp...)> {
     constexpr $function &operator=(const $function &other) {
         if (this != &other) {
             reset();
-            callable = other.callable ? other.callable->clone() : nullptr;
+            copy_from(other);
         }
         return *this;
     }
 
     template <typename T>
     constexpr $function &operator=(T $call_o) {
-        delete callable;
-        callable = new Callable<libcxx::decay_t<T>>(std::Memory::forward<T>($call_o));  // NOLINT
+        reset();
+        emplace<libcxx::decay_t<T>>(std::Memory::forward<T>($call_o));
         return *this;
     }
 
     // Assignment for function pointers
     constexpr $function &operator=(Rt (*func)(Tp...)) {
-        delete callable;
-        callable = func ? new Callable<Rt (*)(typename std::Meta::reference_removed<Tp>...)>(func)
-                        : nullptr;
+        reset();
+        if (func != nullptr) {
+            emplace<Rt (*)(Tp...)>(func);
+        }
         return *this;
     }
 
-    explicit constexpr           operator bool() const noexcept { return callable != nullptr; }
-    [[nodiscard]] constexpr bool operator$question() const noexcept { return callable != nullptr; }
+    explicit constexpr           operator bool() const noexcept { return ops != nullptr; }
+    [[nodiscard]] constexpr bool operator$question() const noexcept { return ops != nullptr; }
 
     constexpr Rt operator()(Tp... args) {
-        if (callable == nullptr) {
+        if (ops == nullptr) {
             throw "called an unset function pointer";
         }
 
-        return callable->invoke(std::Memory::forward<Tp>(args)...);
+        return ops->invoke(storage, std::Memory::forward<Tp>(args)...);
     }
 
     constexpr void reset() noexcept {
-        if (callable) {
-            delete callable;
-            callable = nullptr;
+        if (ops != nullptr) {
+            if (ops->destroy != nullptr) {
+                ops->destroy(storage);
+            }
+            ops = nullptr;
         }
     }
 };
@@ -0,0 +1,99 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///-------------------------------------------------------------------------------- Lib-Helix ---///
+
+#ifndef _$_HX_CORE_M12FUNCTION_REF
+#define _$_HX_CORE_M12FUNCTION_REF
+
+#include <include/config/config.hh>
+
+#include <include/c++/libc++.hh>
+#include <include/runtime/__memory/memory.hh>
+
+H_NAMESPACE_BEGIN
+
+template <typename Sig>
+class $function_ref;
+
+/// \class $function_ref
+///
+/// A non-owning view of a callable, for parameters that are only called before the function
+/// taking them returns: sort comparators, visitors, `Transform::apply` and the like. It is two
+/// words, the callable's address (or the function pointer itself) and a thunk that calls it,
+/// and is trivially copyable, so binding a lambda neither allocates nor copies the lambda, and a
+/// call costs one indirect call.
+///
+/// ### Lifetime
+/// A `$function_ref` does not extend the life of what it refers to. Bound to a temporary, as in
+/// `list.sort([](a: T, b: T) -> bool { ... })`, it is valid until the end of the call it was
+/// passed to. Anything that keeps the callable past that point must take a `$function`.
+///
+/// ### Example
+/// ```helix
+/// fn for_each(items: [i32], f: std::FunctionRef<void, i32>) {
+///     for i in items {
+///         f(i);
+///     }
+/// }
+///
+/// let total: i32 = 0;
+/// for_each(items, fn (x: i32) -> void { total += x; });
+/// ```
+template <typename Rt, typename... Tp>
+class $function_ref<Rt(Tp...)> {
+  private:
+    union Bound {
+        void *object;
+        Rt (*function)(Tp...);
+    };
+
+    template <typename F>
+    static constexpr Rt call_object(Bound bound, Tp &&...args) {
+        return libcxx::invoke_r<Rt>(*static_cast<F *>(bound.object),
+                                    std::Memory::forward<Tp>(args)...);
+    }
+
+    static constexpr Rt call_function(Bound bound, Tp &&...args) {
+        return bound.function(std::Memory::forward<Tp>(args)...);
+    }
+
+    Bound bound;
+    Rt (*thunk)(Bound, Tp &&...);
+
+  public:
+    template <typename F>
+        requires(!libcxx::is_same_v<libcxx::remove_cvref_t<F>, $function_ref> &&
+                 !libcxx::is_function_v<libcxx::remove_reference_t<F>> &&
+                 libcxx::is_invocable_r_v<Rt, F &, Tp...>)
+    constexpr $function_ref(F &&callable) noexcept  // NOLINT(google-explicit-constructor)
+        : thunk(&call_object<libcxx::remove_reference_t<F>>) {
+        bound.object = const_cast<void *>(static_cast<const void *>(libcxx::addressof(callable)));
+    }
+
+    constexpr $function_ref(Rt (*func)(Tp...)) noexcept  // NOLINT(google-explicit-constructor)
+        : thunk(&call_function) {
+        bound.function = func;
+    }
+
+    constexpr $function_ref(const $function_ref &) noexcept            = default;
+    constexpr $function_ref &operator=(const $function_ref &) noexcept = default;
+
+    constexpr Rt operator()(Tp... args) const {
+        return thunk(bound, std::Memory::forward<Tp>(args)...);
+    }
+};
+
+H_NAMESPACE_END
+
+#endif  // _$_HX_CORE_M12FUNCTION_REF
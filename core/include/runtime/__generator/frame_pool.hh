@@ -0,0 +1,180 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///-------------------------------------------------------------------------------- Lib-Helix ---///
+
+#ifndef _$_HX_CORE_M10FRAME_POOL
+#define _$_HX_CORE_M10FRAME_POOL
+
+#include <include/config/config.hh>
+
+#include <include/c++/libc++.hh>
+#include <include/runtime/__memory/memory.hh>
+#include <include/types/builtins/primitives.hh>
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+namespace Memory::__internal {
+/// freed coroutine frames kept for the thread's next generator, by power-of-two size class.
+/// a loop that keeps creating generators of the same shape reuses the same block instead of
+/// going back to the allocator. frames above the largest class are not pooled
+class FramePool {
+  public:
+    static constexpr usize smallest = 64;
+    static constexpr usize classes  = 6;   ///< 64 bytes to 2 KiB
+    static constexpr usize capacity = 16;  ///< blocks kept per class
+
+    ~FramePool() {
+        closed = true;
+        for (usize c = 0; c < classes; ++c) {
+            while (count[c] != 0) {
+                ::operator delete(blocks[c][--count[c]]);
+            }
+        }
+    }
+
+    /// the size class of a request, or `classes` when it is too large to pool
+    static constexpr usize class_of(usize size) noexcept {
+        const usize c = static_cast<usize>(libcxx::bit_width((size - 1) | (smallest - 1)) -
+                                           libcxx::bit_width(smallest - 1));
+        return c < classes ? c : classes;
+    }
+
+    static void *allocate(usize size) {
+        const usize c = class_of(size);
+        if (c == classes) {
+            return ::operator new(size);
+        }
+
+        if (!closed) {
+            FramePool &pool = local();
+            if (pool.count[c] != 0) {
+                return pool.blocks[c][--pool.count[c]];
+            }
+        }
+        return ::operator new(smallest << c);
+    }
+
+    static void deallocate(void *block, usize size) noexcept {
+        const usize c = class_of(size);
+        if (c != classes && !closed) {
+            FramePool &pool = local();
+            if (pool.count[c] != capacity) {
+                pool.blocks[c][pool.count[c]++] = block;
+                return;
+            }
+        }
+        ::operator delete(block);
+    }
+
+    static FramePool &local() noexcept {
+        static thread_local FramePool pool;
+        return pool;
+    }
+
+    /// set once the thread's pool is gone; frames freed after that bypass it
+    inline static constinit thread_local bool closed = false;
+
+  private:
+    void *blocks[classes][capacity]{};
+    usize count[classes]{};
+};
+
+/// how a frame is freed. `operator delete` is only given the frame's size, so this is stored
+/// just past the frame: the pool's, or one per allocator type for frames from an allocator,
+/// which keep a copy of the allocator after it
+using FrameDeallocate = void (*)(void *frame, usize size) noexcept;
+
+/// the unit allocators are asked for, so frames keep the alignment `operator new` gives them
+struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) FrameUnit {
+    unsigned char bytes[__STDCPP_DEFAULT_NEW_ALIGNMENT__];
+};
+
+constexpr usize align_up(usize size, usize alignment) noexcept {
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
+constexpr usize trailer_offset(usize size) noexcept {
+    return align_up(size, alignof(FrameDeallocate));
+}
+
+inline void set_deallocate(void *frame, usize size, FrameDeallocate deallocate) noexcept {
+    ::new (static_cast<void *>(static_cast<unsigned char *>(frame) + trailer_offset(size)))
+        FrameDeallocate(deallocate);
+}
+
+inline void pooled_deallocate(void *frame, usize size) noexcept {
+    FramePool::deallocate(frame, trailer_offset(size) + sizeof(FrameDeallocate));
+}
+
+template <typename Alloc>
+using FrameAllocator =
+    typename libcxx::allocator_traits<Alloc>::template rebind_alloc<FrameUnit>;
+
+/// where the allocator copy sits, and the whole block in units
+template <typename Alloc>
+constexpr usize allocator_offset(usize size) noexcept {
+    return align_up(trailer_offset(size) + sizeof(FrameDeallocate), alignof(FrameAllocator<Alloc>));
+}
+
+template <typename Alloc>
+constexpr usize allocator_units(usize size) noexcept {
+    const usize bytes = allocator_offset<Alloc>(size) + sizeof(FrameAllocator<Alloc>);
+    return (bytes + sizeof(FrameUnit) - 1) / sizeof(FrameUnit);
+}
+
+template <typename Alloc>
+void allocator_deallocate(void *frame, usize size) noexcept {
+    using Traits = libcxx::allocator_traits<FrameAllocator<Alloc>>;
+
+    auto *stored = libcxx::launder(reinterpret_cast<FrameAllocator<Alloc> *>(
+        static_cast<unsigned char *>(frame) + allocator_offset<Alloc>(size)));
+    FrameAllocator<Alloc> alloc(std::Memory::move(*stored));
+    stored->~FrameAllocator<Alloc>();
+
+    Traits::deallocate(alloc, static_cast<FrameUnit *>(frame), allocator_units<Alloc>(size));
+}
+
+/// a frame from the thread's pool
+inline void *allocate_frame(usize size) {
+    void *frame = FramePool::allocate(trailer_offset(size) + sizeof(FrameDeallocate));
+    set_deallocate(frame, size, &pooled_deallocate);
+    return frame;
+}
+
+/// a frame from `alloc`, which is rebound to `FrameUnit` and must hand out plain pointers
+template <typename Alloc>
+void *allocate_frame(usize size, const Alloc &alloc) {
+    using Traits = libcxx::allocator_traits<FrameAllocator<Alloc>>;
+
+    FrameAllocator<Alloc> bytes(alloc);
+    void *frame = libcxx::to_address(Traits::allocate(bytes, allocator_units<Alloc>(size)));
+
+    set_deallocate(frame, size, &allocator_deallocate<Alloc>);
+    ::new (static_cast<void *>(static_cast<unsigned char *>(frame) + allocator_offset<Alloc>(size)))
+        FrameAllocator<Alloc>(std::Memory::move(bytes));
+    return frame;
+}
+
+inline void deallocate_frame(void *frame, usize size) noexcept {
+    const FrameDeallocate deallocate = *libcxx::launder(reinterpret_cast<FrameDeallocate *>(
+        static_cast<unsigned char *>(frame) + trailer_offset(size)));
+    deallocate(frame, size);
+}
+}  // namespace Memory::__internal
+
+H_STD_NAMESPACE_END
+H_NAMESPACE_END
+
+#endif  // _$_HX_CORE_M10FRAME_POOL
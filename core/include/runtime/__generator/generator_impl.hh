@@ -18,6 +18,7 @@
 
 #include <include/config/config.hh>
 
+#include <include/runtime/__generator/frame_pool.hh>
 #include <include/runtime/__memory/memory.hh>
 
 H_NAMESPACE_BEGIN
@@ -83,6 +84,18 @@ H_NAMESPACE_BEGIN
 /// - Provides the `yield_value` method for handling `yield` expressions.
 /// - Responsible for the coroutine's initial and final suspension points.
 ///
+/// #### Frame Allocation
+/// - Coroutine frames come from a per-thread pool of size classes instead of the global
+///   allocator, so a loop that keeps creating generators (every `for x in range(n)`) stops
+///   allocating after its first iteration.
+/// - A generator function whose first parameters are `libcxx::allocator_arg_t` and an
+///   allocator (after `self` for a method) gets its frame from that allocator instead, for
+///   callers that want an arena:
+///   ```cpp
+///   $generator<int> numbers(libcxx::allocator_arg_t, Alloc alloc, int n);
+///   numbers(libcxx::allocator_arg, arena_allocator, 10);
+///   ```
+///
 /// #### `Iter`
 /// - Provides iterator support for navigating the generator's yielded values.
 /// - Implements increment (`operator++`), dereference (`operator*`), and comparison operators.
@@ -140,6 +153,31 @@ class $generator {
         void                     await_transform() = delete;
         [[noreturn]] static void unhandled_exception() { throw; }
 
+        static void *operator new(usize size) {
+            return std::Memory::__internal::allocate_frame(size);
+        }
+
+        template <typename Alloc, typename... Args>
+        static void *operator new(usize size,
+                                  libcxx::allocator_arg_t /*unused*/,
+                                  const Alloc &alloc,
+                                  const Args &.../*unused*/) {
+            return std::Memory::__internal::allocate_frame(size, alloc);
+        }
+
+        template <typename Self, typename Alloc, typename... Args>
+        static void *operator new(usize size,
+                                  const Self & /*unused*/,
+                                  libcxx::allocator_arg_t /*unused*/,
+                                  const Alloc &alloc,
+                                  const Args &.../*unused*/) {
+            return std::Memory::__internal::allocate_frame(size, alloc);
+        }
+
+        static void operator delete(void *frame, usize size) noexcept {
+            std::Memory::__internal::deallocate_frame(frame, size);
+        }
+
         libcxx::optional<T> current_value;
     };
 
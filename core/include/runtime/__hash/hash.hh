@@ -0,0 +1,263 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///-------------------------------------------------------------------------------- Lib-Helix ---///
+
+#ifndef _$_HX_CORE_M4HASH
+#define _$_HX_CORE_M4HASH
+
+#include <include/config/config.hh>
+
+#include <include/c++/libc++.hh>
+#include <include/types/builtins/primitives.hh>
+
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+/// non-cryptographic hashing for the runtime.
+///
+/// `bytes` is wyhash (final v4): inputs up to 16 bytes cost a single 64x64->128 multiply, longer
+/// inputs are consumed 48 bytes per round over three independent lanes. it hashes memory in
+/// place, so hashing a string never copies it. `Hasher` is the streaming form that backs the
+/// `hash::Hasher` interface on the helix side, and `StringHash`/`StringEqual` are transparent, so
+/// an unordered container keyed by `string` can be probed with a `slice`, a `wchar_t *` or a
+/// `wstring_view` without building a key.
+namespace Hash {
+inline constexpr u64 default_seed = 0;
+
+namespace __internal {
+    inline constexpr u64 secret[4] = {
+        0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL, 0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL};
+
+    /// full 64x64 -> 128 bit product, low half in `a` and high half in `b`
+    HELIX_FORCE_INLINE void mum(u64 &a, u64 &b) noexcept {
+#if defined(__SIZEOF_INT128__)
+        const unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+        a                         = static_cast<u64>(r);
+        b                         = static_cast<u64>(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        a = _umul128(a, b, &b);
+#else
+        const u64 ha = a >> 32, hb = b >> 32, la = static_cast<u32>(a), lb = static_cast<u32>(b);
+        const u64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+        const u64 t  = rl + (rm0 << 32);
+        u64       c  = static_cast<u64>(t < rl);
+        const u64 lo = t + (rm1 << 32);
+        c += static_cast<u64>(lo < t);
+        a = lo;
+        b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+    }
+
+    HELIX_FORCE_INLINE u64 mix(u64 a, u64 b) noexcept {
+        mum(a, b);
+        return a ^ b;
+    }
+
+    HELIX_FORCE_INLINE u64 read8(const u8 *p) noexcept {
+        u64 v;
+        libcxx::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    HELIX_FORCE_INLINE u64 read4(const u8 *p) noexcept {
+        u32 v;
+        libcxx::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    /// 1 to 3 bytes, read without branching on the length
+    HELIX_FORCE_INLINE u64 read3(const u8 *p, usize k) noexcept {
+        return (static_cast<u64>(p[0]) << 16) | (static_cast<u64>(p[k >> 1]) << 8) | p[k - 1];
+    }
+}  // namespace __internal
+
+inline u64 bytes(const void *data, usize len, u64 seed = default_seed) noexcept {
+    using namespace __internal;
+
+    const auto *p = static_cast<const u8 *>(data);
+    u64         a = 0;
+    u64         b = 0;
+
+    seed ^= mix(seed ^ secret[0], secret[1]);
+
+    if (len <= 16) {
+        if (len >= 4) {
+            const usize off = (len >> 3) << 2;
+            a               = (read4(p) << 32) | read4(p + off);
+            b               = (read4(p + len - 4) << 32) | read4(p + len - 4 - off);
+        } else if (len > 0) {
+            a = read3(p, len);
+        }
+    } else {
+        usize i = len;
+        if (i >= 48) {
+            u64 see1 = seed;
+            u64 see2 = seed;
+            do {
+                seed = mix(read8(p) ^ secret[1], read8(p + 8) ^ seed);
+                see1 = mix(read8(p + 16) ^ secret[2], read8(p + 24) ^ see1);
+                see2 = mix(read8(p + 32) ^ secret[3], read8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i >= 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16) {
+            seed = mix(read8(p) ^ secret[1], read8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = read8(p + i - 16);
+        b = read8(p + i - 8);
+    }
+
+    a ^= secret[1];
+    b ^= seed;
+    mum(a, b);
+    return mix(a ^ secret[0] ^ len, b ^ secret[1]);
+}
+
+/// hashes a single 64-bit value; cheaper than `bytes(&v, 8)` and used for integral writes
+HELIX_FORCE_INLINE u64 word(u64 value, u64 seed = default_seed) noexcept {
+    using namespace __internal;
+    return mix(value ^ secret[0], seed ^ secret[1]);
+}
+
+namespace __internal {
+    template <typename C>
+    inline constexpr bool is_char = libcxx::is_same_v<C, char> || libcxx::is_same_v<C, wchar_t> ||
+                                    libcxx::is_same_v<C, char8_t> ||
+                                    libcxx::is_same_v<C, char16_t> ||
+                                    libcxx::is_same_v<C, char32_t>;
+
+    template <typename P>
+    concept CharPointer =
+        libcxx::is_pointer_v<P> && is_char<libcxx::remove_cv_t<libcxx::remove_pointer_t<P>>>;
+
+    template <typename T>
+    concept RawText = requires(const T &t) {
+        { t.size() } -> libcxx::convertible_to<usize>;
+    } && CharPointer<decltype(libcxx::declval<const T &>().raw())>;
+
+    template <typename T>
+    concept DataText = !RawText<T> && requires(const T &t) {
+        { t.size() } -> libcxx::convertible_to<usize>;
+    } && CharPointer<decltype(libcxx::declval<const T &>().data())>;
+
+    template <typename T>
+    concept CharPtr = CharPointer<libcxx::decay_t<T>>;
+
+    /// the code units of anything string-shaped, as a view over the original storage
+    template <typename T>
+    HELIX_FORCE_INLINE auto view_of(const T &t) noexcept {
+        if constexpr (RawText<T>) {
+            using C = libcxx::remove_cv_t<libcxx::remove_pointer_t<decltype(t.raw())>>;
+            return libcxx::basic_string_view<C>(t.raw(), t.size());
+        } else if constexpr (DataText<T>) {
+            using C = libcxx::remove_cv_t<libcxx::remove_pointer_t<decltype(t.data())>>;
+            return libcxx::basic_string_view<C>(t.data(), t.size());
+        } else {
+            using C = libcxx::remove_cv_t<libcxx::remove_pointer_t<libcxx::decay_t<T>>>;
+            return libcxx::basic_string_view<C>(t);
+        }
+    }
+}  // namespace __internal
+
+/// anything `StringHash`/`StringEqual` accept: helix strings and slices, `u8string`, the
+/// standard strings and views, and null-terminated character pointers
+template <typename T>
+concept Text = __internal::RawText<T> || __internal::DataText<T> || __internal::CharPtr<T>;
+
+/// hashes the code units of `text` in place; equal text gives equal hashes whatever its type
+template <typename T>
+    requires Text<T>
+HELIX_FORCE_INLINE u64 text(const T &value, u64 seed = default_seed) noexcept {
+    const auto v = __internal::view_of(value);
+    return bytes(v.data(), v.size() * sizeof(typename decltype(v)::value_type), seed);
+}
+
+/// streaming hasher, the native side of `hash::Hasher`
+class Hasher {
+    u64 state;
+
+  public:
+    explicit Hasher(u64 seed = default_seed) noexcept
+        : state(seed) {}
+
+    void write(const void *data, usize len) noexcept { state = bytes(data, len, state); }
+
+    template <typename T>
+        requires libcxx::is_integral_v<T> || libcxx::is_enum_v<T>
+    void write(T value) noexcept {
+        state = word(static_cast<u64>(value), state);
+    }
+
+    template <typename T>
+        requires Text<T>
+    void write(const T &value) noexcept {
+        state = text(value, state);
+    }
+
+    [[nodiscard]] u64 finish() const noexcept { return state; }
+};
+
+/// the native side of `hash::Hash`: a type that feeds itself into a `Hasher`
+template <typename T>
+concept Hashable = requires(const T &t, Hasher *hasher) { t.hash(hasher); };
+
+/// one-shot hash of anything `Hashable`, `Text` or supported by `std::hash`
+template <typename T>
+u64 of(const T &value, u64 seed = default_seed) noexcept {
+    if constexpr (Hashable<T>) {
+        Hasher hasher(seed);
+        value.hash(&hasher);
+        return hasher.finish();
+    } else if constexpr (Text<T>) {
+        return text(value, seed);
+    } else {
+        return word(static_cast<u64>(libcxx::hash<T>{}(value)), seed);
+    }
+}
+
+/// transparent hash for unordered containers keyed by any `Text`
+struct StringHash {
+    using is_transparent = void;
+
+    template <typename T>
+        requires Text<T>
+    usize operator()(const T &value) const noexcept {
+        return static_cast<usize>(text(value));
+    }
+};
+
+/// transparent equality matching `StringHash`; only text of the same code unit type compares
+struct StringEqual {
+    using is_transparent = void;
+
+    template <typename A, typename B>
+        requires Text<A> && Text<B>
+    bool operator()(const A &a, const B &b) const noexcept {
+        return __internal::view_of(a) == __internal::view_of(b);
+    }
+};
+}  // namespace Hash
+
+H_STD_NAMESPACE_END
+H_NAMESPACE_END
+
+#endif  // _$_HX_CORE_M4HASH
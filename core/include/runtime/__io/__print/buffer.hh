@@ -0,0 +1,184 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///-------------------------------------------------------------------------------- Lib-Helix ---///
+
+#ifndef _$_HX_CORE_M6BUFFER
+#define _$_HX_CORE_M6BUFFER
+
+#include <include/config/config.hh>
+
+#include <include/c++/libc++.hh>
+#include <include/runtime/__io/__input/itoa.hh>
+#include <include/types/builtins/primitives.hh>
+#include <include/types/string/transcode.hh>
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+/// the buffered standard output behind `print`.
+///
+/// every thread owns a UTF-8 buffer; `print` appends a whole call to it and the buffer reaches
+/// the descriptor with a single `write`, so there is no stdio lock or wide-to-multibyte
+/// conversion per argument. when the data goes out depends on the process-wide mode:
+///   - `Line`: at the end of any `print` that wrote a newline (the default)
+///   - `Full`: only when the buffer fills, on `std::flush()` and when the thread exits
+///   - `None`: at the end of every `print`
+/// C stdio is flushed before each write, so in `Line` and `None` mode output mixed with
+/// `printf`/`wprintf` stays in order; in `Full` mode call `std::flush()` before handing over.
+namespace Stdout {
+enum class Mode : u8 { Line, Full, None };
+
+namespace __internal {
+    inline libcxx::atomic<Mode> mode{Mode::Line};
+
+    inline void write_all(const char8_t *data, usize len) noexcept {
+        libcxx::fflush(stdout);
+
+        while (len != 0) {
+#ifdef _WIN32
+            const int chunk   = len > 0x40000000 ? 0x40000000 : static_cast<int>(len);
+            const int written = _write(1, data, static_cast<unsigned>(chunk));
+            if (written <= 0) {
+                return;
+            }
+#else
+            const ssize_t written = ::write(STDOUT_FILENO, data, len);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return;
+            }
+#endif
+            data += written;
+            len -= static_cast<usize>(written);
+        }
+    }
+}  // namespace __internal
+
+inline void set_mode(Mode mode) noexcept {
+    __internal::mode.store(mode, libcxx::memory_order_relaxed);
+}
+
+inline Mode mode() noexcept { return __internal::mode.load(libcxx::memory_order_relaxed); }
+
+class Buffer {
+  public:
+    static constexpr usize capacity = 8192;
+
+    Buffer() noexcept = default;
+    ~Buffer() { flush(); }
+
+    Buffer(const Buffer &)            = delete;
+    Buffer &operator=(const Buffer &) = delete;
+    Buffer(Buffer &&)                 = delete;
+    Buffer &operator=(Buffer &&)      = delete;
+
+    void flush() noexcept {
+        if (len != 0) {
+            __internal::write_all(data, len);
+            len = 0;
+        }
+    }
+
+    /// bytes held since the last flush
+    [[nodiscard]] usize size() const noexcept { return len; }
+
+    /// true if the held bytes contain a newline
+    [[nodiscard]] bool has_newline() const noexcept {
+        return len != 0 && libcxx::memchr(data, '\n', len) != nullptr;
+    }
+
+    void put(char8_t byte) noexcept {
+        if (len == capacity) {
+            flush();
+        }
+        data[len++] = byte;
+    }
+
+    /// raw UTF-8; anything larger than the buffer is written through
+    void append(const char8_t *bytes, usize n) noexcept {
+        if (n > capacity - len) {
+            flush();
+            if (n > capacity) {
+                __internal::write_all(bytes, n);
+                return;
+            }
+        }
+        libcxx::memcpy(data + len, bytes, n);
+        len += n;
+    }
+
+    void append(const char *bytes, usize n) noexcept {
+        append(reinterpret_cast<const char8_t *>(bytes), n);
+    }
+
+    /// wide text, encoded straight into the buffer in slices that always fit
+    template <typename WideT>
+        requires String::__internal::transcode::WideUnit<WideT>
+    void append(const WideT *text, usize n) noexcept {
+        namespace transcode = String::__internal::transcode;
+
+        constexpr usize unit_bytes = transcode::is_utf16<WideT> ? 3 : 4;
+
+        while (n != 0) {
+            if (capacity - len < unit_bytes * 2) {
+                flush();
+            }
+
+            usize take = (capacity - len) / unit_bytes;
+            if (take >= n) {
+                take = n;
+            } else if constexpr (transcode::is_utf16<WideT>) {
+                // keep a surrogate pair in one slice
+                if (static_cast<u16>(text[take - 1]) >= 0xD800 &&
+                    static_cast<u16>(text[take - 1]) <= 0xDBFF) {
+                    --take;
+                }
+            }
+
+            len += transcode::wide_to_utf8(text, take, data + len);
+            text += take;
+            n -= take;
+        }
+    }
+
+    /// any `Format::Numeric` value, formatted in place
+    template <typename T>
+    void number(const T &value) noexcept {
+        if (capacity - len < Format::max_chars<T>) {
+            flush();
+        }
+        len = static_cast<usize>(Format::to_chars(data + len, value) - data);
+    }
+
+  private:
+    usize   len = 0;
+    char8_t data[capacity];
+};
+
+/// the calling thread's buffer; it is flushed when the thread exits
+inline Buffer &buffer() noexcept {
+    thread_local Buffer instance;
+    return instance;
+}
+}  // namespace Stdout
+
+/// writes whatever the calling thread has buffered for standard output
+inline void flush() noexcept { Stdout::buffer().flush(); }
+
+H_STD_NAMESPACE_END
+H_NAMESPACE_END
+
+#endif  // _$_HX_CORE_M6BUFFER
@@ -42,6 +42,9 @@ class endl {
     explicit endl(wchar_t end)
         : end_l(end, 1) {}
 
+    /// what `print` writes in place of the newline
+    [[nodiscard]] const string &terminator() const noexcept { return end_l; }
+
   private:
     string end_l = L"\n";
 };
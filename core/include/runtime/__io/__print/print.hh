@@ -20,6 +20,8 @@
 
 #include <include/meta/meta.hh>
 #include <include/types/string/string.hh>
+#include <include/runtime/__io/__input/itoa.hh>
+#include <include/runtime/__io/__print/buffer.hh>
 #include <include/runtime/__io/__print/endl.hh>
 #include <include/runtime/__memory/memory.hh>
 #include <include/meta/type_properties.hh>
@@ -38,26 +40,93 @@ inline void enable_utf8_output() {
 #endif
 }
 
+namespace __print {
+    template <typename T>
+    concept WideRaw = requires(const T &t) {
+        { t.raw() } -> libcxx::same_as<const wchar_t *>;
+        { t.size() } -> libcxx::convertible_to<usize>;
+    };
+
+    template <typename T>
+    concept NarrowRaw = requires(const T &t) {
+        { t.raw() } -> libcxx::same_as<const char *>;
+        { t.size() } -> libcxx::convertible_to<usize>;
+    };
+
+    /// appends one argument to the thread's buffer as UTF-8, without building a `string` for
+    /// numbers, text or `endl`; anything else goes through `to_string`
+    template <typename T>
+    void write(std::Stdout::Buffer &out, T &&value) {
+        using U = libcxx::remove_cvref_t<T>;
+
+        if constexpr (libcxx::is_same_v<U, std::endl>) {
+            const string &end = value.terminator();
+            out.append(end.raw(), end.size());
+        } else if constexpr (libcxx::is_same_v<U, bool>) {
+            value ? out.append("true", 4) : out.append("false", 5);
+        } else if constexpr (libcxx::is_same_v<U, char>) {
+            out.put(static_cast<char8_t>(value));
+        } else if constexpr (libcxx::is_same_v<U, wchar_t>) {
+            out.append(&value, 1);
+        } else if constexpr (std::Format::Numeric<U>) {
+            out.number(value);
+        } else if constexpr (libcxx::is_convertible_v<const U &, const wchar_t *>) {
+            const wchar_t *str = value;
+            if (str != nullptr) {
+                out.append(str, libcxx::char_traits<wchar_t>::length(str));
+            }
+        } else if constexpr (WideRaw<U>) {
+            out.append(value.raw(), static_cast<usize>(value.size()));
+        } else if constexpr (libcxx::is_same_v<U, libcxx::wstring> ||
+                             libcxx::is_same_v<U, libcxx::wstring_view>) {
+            out.append(value.data(), value.size());
+        } else if constexpr (libcxx::is_convertible_v<const U &, const char *>) {
+            const char *str = value;
+            if (str != nullptr) {
+                out.append(str, libcxx::char_traits<char>::length(str));
+            }
+        } else if constexpr (NarrowRaw<U>) {
+            out.append(value.raw(), static_cast<usize>(value.size()));
+        } else if constexpr (libcxx::is_same_v<U, libcxx::string> ||
+                             libcxx::is_same_v<U, libcxx::string_view>) {
+            out.append(value.data(), value.size());
+        } else {
+            const string str = std::to_string(value);
+            out.append(str.raw(), str.size());
+        }
+    }
+}  // namespace __print
+
+/// writes every argument followed by a newline, unless the last argument is an `endl`, which
+/// supplies its own terminator. the whole call lands in the thread's stdout buffer and is
+/// written out according to `std::Stdout::mode()`.
 template <typename... Args>
 void print(Args &&...t) {
+    auto &out = std::Stdout::buffer();
+
+    (__print::write(out, t), ...);
+
     if constexpr (sizeof...(t) == 0) {
-        wprintf(L"\n");
-        return;
+        out.put(u8'\n');
+    } else {
+        using LastArg =
+            libcxx::remove_cvref_t<libcxx::tuple_element_t<sizeof...(t) - 1, tuple<Args...>>>;
+        if constexpr (!std::Meta::same_as<LastArg, std::endl>) {
+            out.put(u8'\n');
+        }
     }
 
-    ((wprintf(L"%ls",
-              [&]() -> const string {
-                  auto str = std::to_string(t);
-                  return str;
-              }()
-                           .raw())),
-     ...);
-
-    if constexpr (sizeof...(t) > 0) {
-        using LastArg = libcxx::tuple_element_t<sizeof...(t) - 1, tuple<Args...>>;
-        if constexpr (!std::Meta::same_as<std::Meta::const_volatile_removed<LastArg>, std::endl>) {
-            wprintf(L"\n");
-        }
+    switch (std::Stdout::mode()) {
+        case std::Stdout::Mode::Full:
+            break;
+        case std::Stdout::Mode::Line:
+            if (out.has_newline()) {
+                out.flush();
+            }
+            break;
+        case std::Stdout::Mode::None:
+            out.flush();
+            break;
     }
 }
 
@@ -22,6 +22,7 @@
 
 #include <include/config/config.hh>
 #include <include/runtime/__error/runtime_error.hh>
+#include <include/runtime/__io/__input/itoa.hh>
 #include <include/runtime/__panic/panic_config.hh>
 #include <include/types/question/question_impl.hh>
 #include <include/types/string/string.hh>
@@ -29,122 +30,275 @@
 H_NAMESPACE_BEGIN
 H_STD_NAMESPACE_BEGIN
 
-template <typename... Ty>
-inline string stringf(string fmt) {
-    return fmt;
+namespace __format {
+/// literal text between two placeholders, as a range of the format string. `escaped` is set
+/// when the range holds `\{` or `\}`, whose backslash is dropped when the text is copied.
+struct segment {
+    usize offset  = 0;
+    usize length  = 0;
+    bool  escaped = false;
+};
+
+struct parse_result {
+    usize placeholders = 0;
+    usize literal_size = 0;  // output units of all literal text, escapes already collapsed
+};
+
+/// splits `fmt` at every `{}`. the first `cap` segments are stored, the rest only counted, so a
+/// caller with the wrong number of arguments still learns how many placeholders there are.
+constexpr parse_result parse(const wchar_t *fmt, usize len, segment *seg, usize cap) noexcept {
+    parse_result result;
+    usize        start   = 0;
+    bool         escaped = false;
+
+    for (usize i = 0; i < len;) {
+        if (fmt[i] == L'\\' && i + 1 < len && (fmt[i + 1] == L'{' || fmt[i + 1] == L'}')) {
+            escaped = true;
+            ++result.literal_size;
+            i += 2;
+        } else if (fmt[i] == L'{' && i + 1 < len && fmt[i + 1] == L'}') {
+            if (result.placeholders < cap) {
+                seg[result.placeholders] = {start, i - start, escaped};
+            }
+            ++result.placeholders;
+            i += 2;
+            start   = i;
+            escaped = false;
+        } else {
+            ++result.literal_size;
+            ++i;
+        }
+    }
+
+    if (result.placeholders < cap) {
+        seg[result.placeholders] = {start, len - start, escaped};
+    }
+    return result;
+}
+
+inline wchar_t *write_segment(const wchar_t *fmt, const segment &seg, wchar_t *out) noexcept {
+    const wchar_t *src = fmt + seg.offset;
+
+    if (!seg.escaped) {
+        libcxx::char_traits<wchar_t>::copy(out, src, seg.length);
+        return out + seg.length;
+    }
+
+    for (usize i = 0; i < seg.length; ++i) {
+        if (src[i] == L'\\' && i + 1 < seg.length && (src[i + 1] == L'{' || src[i + 1] == L'}')) {
+            ++i;
+        }
+        *out++ = src[i];
+    }
+    return out;
 }
 
+// called from the consteval constructor only on a mismatch; not being constexpr is what turns
+// the mismatch into a compile error, and the name is what the diagnostic shows
+void too_few_arguments_for_format_string();
+void too_many_arguments_for_format_string();
+
+/// text that is already wide is copied straight from the argument
+struct wide_piece {
+    const wchar_t *data;
+    usize          len;
+
+    usize    size() const noexcept { return len; }
+    wchar_t *write(wchar_t *out) const noexcept {
+        libcxx::char_traits<wchar_t>::copy(out, data, len);
+        return out + len;
+    }
+};
+
+/// narrow text is UTF-8 and transcoded into place; its wide length is measured once
+struct narrow_piece {
+    const char8_t                            *data;
+    usize                                     len;
+    String::__internal::transcode::length_t   wide;
+
+    narrow_piece(const char *str, usize n) noexcept
+        : data(reinterpret_cast<const char8_t *>(str))
+        , len(n)
+        , wide(String::__internal::transcode::utf8_to_wide_length<wchar_t>(data, n)) {}
+
+    usize    size() const noexcept { return wide.units; }
+    wchar_t *write(wchar_t *out) const noexcept {
+        return out + String::__internal::transcode::utf8_to_wide(data, len, out, wide.valid);
+    }
+};
+
+/// numbers are formatted into the piece itself, so sizing the output costs nothing extra
+template <typename T>
+struct numeric_piece {
+    wchar_t buf[Format::max_chars<T>];
+    u8      len;
+
+    explicit numeric_piece(const T &value) noexcept
+        : len(static_cast<u8>(Format::to_chars(buf, value) - buf)) {}
+
+    usize    size() const noexcept { return len; }
+    wchar_t *write(wchar_t *out) const noexcept {
+        libcxx::char_traits<wchar_t>::copy(out, buf, len);
+        return out + len;
+    }
+};
+
+/// anything else goes through `to_string` once, up front, so the output can still be sized
+struct owned_piece {
+    string value;
+
+    usize    size() const noexcept { return value.size(); }
+    wchar_t *write(wchar_t *out) const noexcept {
+        libcxx::char_traits<wchar_t>::copy(out, value.raw(), value.size());
+        return out + value.size();
+    }
+};
+
+template <typename T>
+concept WideRaw = requires(const T &t) {
+    { t.raw() } -> libcxx::same_as<const wchar_t *>;
+    { t.size() } -> libcxx::convertible_to<usize>;
+};
+
+template <typename T>
+concept NarrowRaw = requires(const T &t) {
+    { t.raw() } -> libcxx::same_as<const char *>;
+    { t.size() } -> libcxx::convertible_to<usize>;
+};
+
+template <typename T>
+auto piece_of(const T &arg) {
+    using U = libcxx::remove_cvref_t<T>;
+
+    if constexpr (libcxx::is_same_v<U, bool>) {
+        return arg ? wide_piece{L"true", 4} : wide_piece{L"false", 5};
+    } else if constexpr (libcxx::is_same_v<U, wchar_t>) {
+        return wide_piece{&arg, 1};
+    } else if constexpr (Format::Numeric<U>) {
+        return numeric_piece<U>(arg);
+    } else if constexpr (libcxx::is_convertible_v<const T &, const wchar_t *>) {
+        const wchar_t *str = arg;
+        return wide_piece{str != nullptr ? str : L"",
+                          str != nullptr ? libcxx::char_traits<wchar_t>::length(str) : 0};
+    } else if constexpr (WideRaw<U>) {
+        return wide_piece{arg.raw(), static_cast<usize>(arg.size())};
+    } else if constexpr (libcxx::is_same_v<U, libcxx::wstring> ||
+                         libcxx::is_same_v<U, libcxx::wstring_view>) {
+        return wide_piece{arg.data(), arg.size()};
+    } else if constexpr (libcxx::is_convertible_v<const T &, const char *>) {
+        const char *str = arg;
+        return str != nullptr ? narrow_piece(str, libcxx::char_traits<char>::length(str))
+                              : narrow_piece("", 0);
+    } else if constexpr (NarrowRaw<U>) {
+        return narrow_piece(arg.raw(), static_cast<usize>(arg.size()));
+    } else if constexpr (libcxx::is_same_v<U, libcxx::string> ||
+                         libcxx::is_same_v<U, libcxx::string_view>) {
+        return narrow_piece(arg.data(), arg.size());
+    } else {
+        return owned_piece{to_string(arg)};
+    }
+}
+
+/// sizes the output once from the literal text and every argument, then writes both in order
+template <typename... P>
+string render(const wchar_t *fmt, const segment *seg, usize literal_size, const P &...pieces) {
+    string result;
+    result.resize(literal_size + (static_cast<usize>(0) + ... + pieces.size()));
+
+    auto *out = const_cast<wchar_t *>(result.raw());
+    usize idx = 0;
+
+    out = write_segment(fmt, seg[idx++], out);
+    ((out = pieces.write(out), out = write_segment(fmt, seg[idx++], out)), ...);
+    return result;
+}
+
+inline const string &as_format(const string &fmt) noexcept { return fmt; }
+
+template <typename Fmt>
+inline string as_format(Fmt &&fmt) {
+    return string(std::Memory::forward<Fmt>(fmt));
+}
+
+template <typename T>
+inline constexpr bool is_wide_literal =
+    libcxx::is_array_v<libcxx::remove_reference_t<T>> &&
+    libcxx::is_same_v<libcxx::remove_cv_t<libcxx::remove_extent_t<libcxx::remove_reference_t<T>>>,
+                      wchar_t>;
+}  // namespace __format
+
+/// a wide string literal checked against the argument types of a `stringf` call.
+///
+/// the literal is split into its literal segments and placeholders while compiling, so a call
+/// with the wrong number of arguments does not compile and formatting never rescans the text.
+template <typename... Ty>
+class format_string {
+    const wchar_t        *fmt;
+    __format::segment     seg[sizeof...(Ty) + 1];
+    usize                 literal_size;
+
+  public:
+    template <usize N>
+    consteval format_string(const wchar_t (&str)[N])  // NOLINT: implicit like std::format_string
+        : fmt(str)
+        , seg{}
+        , literal_size(0) {
+        usize len = 0;
+        while (len < N && str[len] != L'\0') {
+            ++len;
+        }
+
+        const auto parsed = __format::parse(str, len, seg, sizeof...(Ty) + 1);
+        if (parsed.placeholders > sizeof...(Ty)) {
+            __format::too_few_arguments_for_format_string();
+        }
+        if (parsed.placeholders < sizeof...(Ty)) {
+            __format::too_many_arguments_for_format_string();
+        }
+        literal_size = parsed.literal_size;
+    }
+
+    [[nodiscard]] const wchar_t           *raw() const noexcept { return fmt; }
+    [[nodiscard]] const __format::segment *segments() const noexcept { return seg; }
+    [[nodiscard]] usize                    literal_length() const noexcept { return literal_size; }
+};
+
 /// \include belongs to the helix standard library.
 /// \brief format a string with arguments
 ///
-/// a fmt string looks like this: "hello {} world {}" or "hello \\{ {} world \\}" (escaped braces - ony the {} gets replaced, while the \\{ changes to { and the \\} changes to })
-/// each if the args go though a to_string function and are replaced in the string
+/// a fmt string looks like this: "hello {} world {}" or "hello \\{ {} world \\}" (escaped
+/// braces - only the {} gets replaced, while the \\{ changes to { and the \\} changes to }).
+/// a wide literal is parsed at compile time and must have exactly one {} per argument; each
+/// argument is then written straight into a single buffer sized for the whole result.
 ///
 /// \param fmt the format string
 /// \param args the arguments to format into the string
 /// \return the formatted string
-// template <typename... Ty>
-// inline string stringf(string fmt, Ty &&...args) {
-//     const static string placeholder  = L"{}";
-//     const static string escape_open  = L"\\{";
-//     const static string escape_close = L"\\}";
-
-//     // logic to use
-//     // 1. find the first placeholder in the string
-//     // note its position
-//     // convert arg1 to string and replace the placeholder with the string
-//     // increment the position ticker by the length of what was just added
-//     // repeat until all args are used, if theres any mismatch then throw an error
-//     // 2. if there are no placeholders then just return the string as is
-
-//     string::string_t::size_type search_pos = 0;
-
-//     ([&] {
-//         string arg = to_string(std::Memory::forward<Ty>(args));
-
-//         usize new_pos = fmt.raw_string().find(placeholder.raw(), search_pos, placeholder.length());
-//         if (new_pos == string::string_t::npos) {
-//             _HX_MC_Q7_INTERNAL_CRASH_PANIC_M(Error::RuntimeError(L"[f-string rt]: too few arguments for format string"));
-//         }
-
-//         fmt.replace(new_pos, placeholder.length(), arg);
-
-//         // now we need to find every escaped brace from new_pos to search_pos
-//         string::string_t::size_type escape_pos = fmt.raw_string().find(escape_open.raw(), search_pos, escape_open.length());
-//         while (escape_pos != string::string_t::npos && escape_pos < new_pos) {
-//             fmt.raw_string().erase(escape_pos, 1);
-//             escape_pos = fmt.raw_string().find(escape_open.raw(), escape_pos, escape_open.length());
-//             new_pos--;
-//         }
-
-//         escape_pos = fmt.raw_string().find(escape_close.raw(), search_pos, escape_close.length());
-//         while (escape_pos != string::string_t::npos && escape_pos < new_pos) {
-//             fmt.raw_string().erase(escape_pos, 1);
-//             escape_pos = fmt.raw_string().find(escape_close.raw(), escape_pos, escape_close.length());
-//             new_pos--;
-//         }
-    
-//         search_pos = new_pos + arg.length();
-//     }(), ...);
-
-//     if (fmt.raw_string().find(placeholder.raw(), search_pos, placeholder.length()) != string::string_t::npos) {
-//         _HX_MC_Q7_INTERNAL_CRASH_PANIC_M(std::Error::RuntimeError("[f-string rt]: too many arguments for format string"));
-//     }
-
-//     // if there are any escaped braces left then remove them
-//     string::string_t::size_type escape_pos = fmt.raw_string().find(escape_open.raw(), search_pos, escape_open.length());
-//     while (escape_pos != string::string_t::npos) {
-//         fmt.raw_string().erase(escape_pos, 1);
-//         escape_pos = fmt.raw_string().find(escape_open.raw(), escape_pos, escape_open.length());
-//     }
-
-//     escape_pos = fmt.raw_string().find(escape_close.raw(), search_pos, escape_close.length());
-//     while (escape_pos != string::string_t::npos) {
-//         fmt.raw_string().erase(escape_pos, 1);
-//         escape_pos = fmt.raw_string().find(escape_close.raw(), escape_pos, escape_close.length());
-//     }
-
-//     return fmt;
-// }
-
 template <typename... Ty>
-inline string stringf(string fmt, Ty &&...args) {
-    const static string placeholder  = L"{}";
-    const static string escape_open  = L"\\{";
-    const static string escape_close = L"\\}";
-
-    string result;
-    result.raw_string().reserve(fmt.size() + (sizeof...(args) * 8));
+inline string stringf(format_string<libcxx::type_identity_t<Ty>...> fmt, Ty &&...args) {
+    return __format::render(
+        fmt.raw(), fmt.segments(), fmt.literal_length(), __format::piece_of(args)...);
+}
 
-    usize index = 0;
-    usize pos   = 0;
-    const string args_arr[] = {to_string(std::Memory::forward<Ty>(args))...};
-
-    for (size_t i = 0; i < fmt.size();) {
-        if (i + 1 < fmt.size() && fmt[i] == L'\\' && (fmt[i + 1] == L'{' || fmt[i + 1] == L'}')) {
-            result.push_back(fmt[i + 1]);
-            i += 2;
-            ++pos;
-        } else if (i + 1 < fmt.size() && fmt[i] == L'{' && fmt[i + 1] == L'}') {
-            if (index >= sizeof...(args)) {
-                _HX_MC_Q7_INTERNAL_CRASH_PANIC_M(Error::RuntimeError(L"[f-string rt]: too few format specifiers (\"{}\")"));
-            }
-            result.append(args_arr[index++]);
-            pos += args_arr[index - 1].size();
-            i   += 2;
-        } else {
-            result.push_back(fmt[i]);
-            ++i;
-            ++pos;
-        }
+/// runtime overload for formats that are not wide literals; parsed on every call, and a
+/// mismatched argument count panics instead of failing to compile.
+template <typename Fmt, typename... Ty>
+    requires(!__format::is_wide_literal<Fmt>) && libcxx::is_convertible_v<Fmt, string>
+inline string stringf(Fmt &&format, Ty &&...args) {
+    const string     &fmt = __format::as_format(std::Memory::forward<Fmt>(format));
+    __format::segment seg[sizeof...(Ty) + 1];
 
+    const auto parsed = __format::parse(fmt.raw(), fmt.size(), seg, sizeof...(Ty) + 1);
+    if (parsed.placeholders > sizeof...(Ty)) {
+        _HX_MC_Q7_INTERNAL_CRASH_PANIC_M(
+            Error::RuntimeError(L"[f-string rt]: too few arguments for format string"));
     }
-
-    if (index < sizeof...(args)) {
-        _HX_MC_Q7_INTERNAL_CRASH_PANIC_M(Error::RuntimeError(L"[f-string rt]: too many format specifiers (\"{}\")"));
+    if (parsed.placeholders < sizeof...(Ty)) {
+        _HX_MC_Q7_INTERNAL_CRASH_PANIC_M(
+            Error::RuntimeError(L"[f-string rt]: too many arguments for format string"));
     }
 
-    return result;
+    return __format::render(fmt.raw(), seg, parsed.literal_size, __format::piece_of(args)...);
 }
 
 H_STD_NAMESPACE_END
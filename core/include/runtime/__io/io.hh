@@ -18,6 +18,7 @@
 
 #include <include/config/config.hh>
 
+#include <include/runtime/__io/__print/buffer.hh>
 #include <include/runtime/__io/__print/print.hh>
 #include <include/runtime/__io/__print/endl.hh>
 #include <include/runtime/__io/__print/stringf.hh>
@@ -28,6 +28,7 @@
 #define _$_HX_CORE_M6SYSTEM
 
 #include <include/config/config.hh>
+#include <include/runtime/__function/function_impl.hh>
 #include <include/runtime/__error/runtime_error.hh>
 #include <include/runtime/__panic/panic_config.hh>
 #include <include/types/question/question_impl.hh>
@@ -111,7 +112,7 @@ struct ProcessOutput {
     ~ProcessOutput() = default;
 
     ProcessOutput &on_fail($function<void()> cb, bool include_timeout = false) {
-        on_fail_ = {include_timeout, cb};
+        on_fail_ = {include_timeout, std::Memory::move(cb)};
 
         if (((terminated && return_code != 0) || (timed_out && include_timeout))) {
             libcxx::get<1>(on_fail_)();
@@ -121,7 +122,7 @@ struct ProcessOutput {
     }
 
     ProcessOutput &on_timeout($function<void()> cb) {
-        on_timeout_ = cb;
+        on_timeout_ = std::Memory::move(cb);
 
         if (timed_out) {
             on_timeout_();
@@ -131,7 +132,7 @@ struct ProcessOutput {
     }
 
     ProcessOutput &on_success($function<void()> cb) {
-        on_success_ = cb;
+        on_success_ = std::Memory::move(cb);
 
         if (terminated && return_code == 0) {
             on_success_();
@@ -168,19 +169,19 @@ struct ProcessOutput {
 
     void append_stdout(const char *data, size_t n) {
         libcxx::lock_guard<libcxx::mutex> lg(stdout_mutex);
-        auto                              str = cstring_to_string(libcxx::string(data, n));
+        auto                              str = utf8_to_string(data, n);
         stdout_data.append(str);
         if (on_stdout) {
-            on_stdout(stdout_data.subslice(stdout_data.size() - n, n));
+            on_stdout(stdout_data.subslice(stdout_data.size() - str.size(), str.size()));
         }
     }
 
     void append_stderr(const char *data, size_t n) {
         libcxx::lock_guard<libcxx::mutex> lg(stderr_mutex);
-        auto                              str = cstring_to_string(libcxx::string(data, n));
+        auto                              str = utf8_to_string(data, n);
         stderr_data.append(str);
         if (on_stderr) {
-            on_stderr(stderr_data.subslice(stderr_data.size() - n, n));
+            on_stderr(stderr_data.subslice(stderr_data.size() - str.size(), str.size()));
         }
     }
 
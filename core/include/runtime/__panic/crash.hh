@@ -0,0 +1,412 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///-------------------------------------------------------------------------------- Lib-Helix ---///
+
+#ifndef _$_HX_CORE_M5CRASH
+#define _$_HX_CORE_M5CRASH
+
+#include <include/config/config.hh>
+
+#include <include/c++/libc++.hh>
+#include <include/runtime/__panic/stacktrace.hh>
+#include <include/types/builtins/primitives.hh>
+
+#ifndef _WIN32
+#include <execinfo.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <ucontext.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+#endif
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+/// post-mortem traces for SIGSEGV, SIGBUS and SIGABRT.
+///
+/// `install` puts a handler on an alternate signal stack that, on a crash, writes one binary
+/// record to a file descriptor opened up front, then lets the signal take its default action.
+/// the handler does not allocate: it copies the interrupted thread's `RegisterFrame` chain and
+/// raw return addresses into a static buffer and hands it to `write(2)`. the return addresses
+/// come from `backtrace`, whose unwinder can take the loader's locks, so a crash inside the
+/// unwinder or with a loader lock held can hang the handler there; `install` loads the unwinder
+/// up front so that at least its first use does not happen in the handler. nothing is symbolized
+/// in the crashing process; `helix-symbolize` (core/tools) turns records back into the usual trace
+/// using the module map stored with them. until a crash nothing runs, beyond an alternate stack
+/// per thread that calls `prepare_thread`. POSIX only.
+///
+/// a record, all integers in the writer's byte order:
+///   Header, then sections of { u32 tag; u32 length; u8 payload[length] } up to an `End` section.
+///   `Native`   u64 return addresses, innermost first; the first is the interrupted pc
+///   `Helix`    `HelixEntry` + file + function bytes per frame, innermost first
+///   `Maps`     a slice of /proc/self/maps (Linux), to be concatenated in order
+namespace Crash {
+namespace Record {
+    inline constexpr char magic[8] = {'H', 'X', 'C', 'R', 'A', 'S', 'H', '1'};
+
+    enum Tag : u32 {
+        End    = 0,
+        Native = 1,
+        Helix  = 2,
+        Maps   = 3,
+    };
+
+    struct Header {
+        char magic[8];
+        u32  signal;
+        i32  code;
+        u64  fault_address;
+        u64  pc;
+        u64  pid;
+        u64  tid;
+        u64  time;  // seconds since the epoch
+    };
+
+    struct Section {
+        u32 tag;
+        u32 length;
+    };
+
+    struct HelixEntry {
+        u32 line;
+        u16 file_length;
+        u16 func_length;
+        u8  kind;  // `Stacktrace::FrameKind`
+        u8  reserved[3];
+    };
+
+    static_assert(sizeof(Header) == 56 && sizeof(Section) == 8 && sizeof(HelixEntry) == 12);
+}  // namespace Record
+
+#ifndef _WIN32
+namespace __internal {
+    inline constexpr usize max_native = 128;
+    inline constexpr usize max_string = 512;  // longer names are cut
+    inline constexpr int   signals[]  = {SIGSEGV, SIGBUS, SIGABRT};
+
+    inline constinit int                 g_fd = -1;
+    /// the thread writing the record, or 0
+    inline constinit libcxx::atomic<long> g_crashing{0};
+    inline constinit struct sigaction    g_previous[sizeof(signals) / sizeof(int)]{};
+
+    /// appends to a static buffer and writes it out whenever it fills; only the first crashing
+    /// thread ever touches it
+    class Writer {
+      public:
+        static constexpr usize capacity = 64 * 1024;
+
+        void put(const void *data, usize n) noexcept {
+            const auto *bytes = static_cast<const unsigned char *>(data);
+            while (n != 0) {
+                if (len == capacity) {
+                    flush();
+                }
+                const usize take = n < capacity - len ? n : capacity - len;
+                libcxx::memcpy(buffer + len, bytes, take);
+                len += take;
+                bytes += take;
+                n -= take;
+            }
+        }
+
+        void section(Record::Tag tag, usize length) noexcept {
+            const Record::Section s{tag, static_cast<u32>(length)};
+            put(&s, sizeof(s));
+        }
+
+        void flush() noexcept {
+            const unsigned char *data = buffer;
+            while (len != 0) {
+                const ssize_t written = ::write(g_fd, data, len);
+                if (written < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (written <= 0) {
+                    break;
+                }
+                data += written;
+                len -= static_cast<usize>(written);
+            }
+            len = 0;
+        }
+
+      private:
+        inline static constinit unsigned char buffer[capacity]{};
+        usize                                 len = 0;
+    };
+
+    inline usize bounded_length(const char *s) noexcept {
+        usize n = 0;
+        while (s != nullptr && n < max_string && s[n] != '\0') {
+            ++n;
+        }
+        return n;
+    }
+
+    inline u64 interrupted_pc(void *context) noexcept {
+        const auto *uc = static_cast<const ucontext_t *>(context);
+        if (uc == nullptr) {
+            return 0;
+        }
+#if defined(__linux__) && defined(__x86_64__)
+        return static_cast<u64>(uc->uc_mcontext.gregs[REG_RIP]);
+#elif defined(__linux__) && defined(__aarch64__)
+        return static_cast<u64>(uc->uc_mcontext.pc);
+#elif defined(__APPLE__) && defined(__x86_64__)
+        return static_cast<u64>(uc->uc_mcontext->__ss.__rip);
+#elif defined(__APPLE__) && defined(__aarch64__)
+        return static_cast<u64>(uc->uc_mcontext->__ss.__pc);
+#else
+        return 0;
+#endif
+    }
+
+    /// nonzero and unique per live thread
+    inline long thread_id() noexcept {
+#ifdef __linux__
+        return static_cast<long>(::syscall(SYS_gettid));
+#else
+        return static_cast<long>(reinterpret_cast<uintptr_t>(::pthread_self()));
+#endif
+    }
+
+    inline void write_record(int sig, const siginfo_t *info, void *context) noexcept {
+        Writer out;
+
+        timespec now{};
+        ::clock_gettime(CLOCK_REALTIME, &now);
+
+        Record::Header header{};
+        libcxx::memcpy(header.magic, Record::magic, sizeof(header.magic));
+        header.signal        = static_cast<u32>(sig);
+        header.code          = info != nullptr ? info->si_code : 0;
+        header.fault_address = info != nullptr ? reinterpret_cast<uintptr_t>(info->si_addr) : 0;
+        header.pc            = interrupted_pc(context);
+        header.pid           = static_cast<u64>(::getpid());
+#ifdef __linux__
+        header.tid = static_cast<u64>(thread_id());
+#endif
+        header.time = static_cast<u64>(now.tv_sec);
+        out.put(&header, sizeof(header));
+
+        // start at the interrupted frame, dropping this handler and the signal trampoline
+        void     *pcs[max_native + 4];
+        const int got   = ::backtrace(pcs, static_cast<int>(max_native + 4));
+        int       first = 0;
+        while (first < got && reinterpret_cast<uintptr_t>(pcs[first]) != header.pc) {
+            ++first;
+        }
+        const bool found = first < got;
+        if (!found) {
+            first = got > 2 ? 2 : got;
+        }
+        usize native = static_cast<usize>(got - first) + (found || header.pc == 0 ? 0 : 1);
+        native       = native > max_native ? max_native : native;
+
+        out.section(Record::Native, native * sizeof(u64));
+        usize written = 0;
+        if (!found && header.pc != 0) {
+            out.put(&header.pc, sizeof(u64));
+            ++written;
+        }
+        for (int i = first; i < got && written < native; ++i, ++written) {
+            const u64 pc = reinterpret_cast<uintptr_t>(pcs[i]);
+            out.put(&pc, sizeof(pc));
+        }
+
+        usize helix_bytes = 0;
+        for (const Stacktrace::FrameSummary *f = Stacktrace::g_tls_helix_head; f != nullptr;
+             f                                 = f->prev) {
+            if (f->loc != nullptr) {
+                helix_bytes += sizeof(Record::HelixEntry) + bounded_length(f->loc->file) +
+                               bounded_length(f->loc->func);
+            }
+        }
+        out.section(Record::Helix, helix_bytes);
+        for (const Stacktrace::FrameSummary *f = Stacktrace::g_tls_helix_head; f != nullptr;
+             f                                 = f->prev) {
+            if (f->loc == nullptr) {
+                continue;
+            }
+            Record::HelixEntry entry{};
+            entry.line        = f->loc->line;
+            entry.file_length = static_cast<u16>(bounded_length(f->loc->file));
+            entry.func_length = static_cast<u16>(bounded_length(f->loc->func));
+            entry.kind        = static_cast<u8>(f->kind);
+            out.put(&entry, sizeof(entry));
+            out.put(f->loc->file, entry.file_length);
+            out.put(f->loc->func, entry.func_length);
+        }
+
+#ifdef __linux__
+        const int maps = ::open("/proc/self/maps", O_RDONLY | O_CLOEXEC);
+        if (maps >= 0) {
+            char chunk[4096];
+            for (;;) {
+                const ssize_t n = ::read(maps, chunk, sizeof(chunk));
+                if (n < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (n <= 0) {
+                    break;
+                }
+                out.section(Record::Maps, static_cast<usize>(n));
+                out.put(chunk, static_cast<usize>(n));
+            }
+            ::close(maps);
+        }
+#endif
+
+        out.section(Record::End, 0);
+        out.flush();
+    }
+
+    inline void on_crash(int sig, siginfo_t *info, void *context) {
+        const int  saved = errno;
+        const long self  = thread_id();
+        long       owner = 0;
+        if (g_crashing.compare_exchange_strong(owner, self)) {
+            write_record(sig, info, context);
+        } else if (owner != self) {
+            for (;;) {
+                ::pause();  // the first crashing thread is writing; it ends the process
+            }
+        }
+        // else this thread crashed again while writing its record: give up on the record and
+        // let the default action run, rather than wait on itself
+        errno = saved;
+
+        // the default action (a core dump, for all three) happens once the handler returns:
+        // a fault re-executes, and a raised signal is delivered as soon as it is unblocked
+        struct sigaction fallback{};
+        fallback.sa_handler = SIG_DFL;
+        sigemptyset(&fallback.sa_mask);
+        ::sigaction(sig, &fallback, nullptr);
+        if (info == nullptr || info->si_code <= 0) {
+            ::raise(sig);
+        }
+    }
+
+    /// the calling thread's alternate signal stack
+    struct AltStack {
+        void  *base = nullptr;
+        usize  size = 0;
+
+        ~AltStack() {
+            if (base != nullptr) {
+                stack_t off{};
+                off.ss_flags = SS_DISABLE;
+                ::sigaltstack(&off, nullptr);
+                ::munmap(base, size);
+            }
+        }
+    };
+}  // namespace __internal
+
+/// gives the calling thread an alternate signal stack, so a crash from a stack overflow can
+/// still be reported; `install` does this for its own thread
+inline bool prepare_thread() {
+    static thread_local __internal::AltStack stack;
+    if (stack.base != nullptr) {
+        return true;
+    }
+
+    const usize size = 64 * 1024 > static_cast<usize>(SIGSTKSZ) ? 64 * 1024 : SIGSTKSZ;
+    void       *base =
+        ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) {
+        return false;
+    }
+
+    stack_t ss{};
+    ss.ss_sp    = base;
+    ss.ss_size  = size;
+    ss.ss_flags = 0;
+    if (::sigaltstack(&ss, nullptr) != 0) {
+        ::munmap(base, size);
+        return false;
+    }
+    stack.base = base;
+    stack.size = size;
+    return true;
+}
+
+/// writes crash records to `fd`, which stays open for the life of the process and is not
+/// closed here
+inline bool install(int fd) {
+    using namespace __internal;
+    if (fd < 0) {
+        return false;
+    }
+
+    // the unwinder loads lazily on its first use; make that happen here, not in the handler
+    void *warm[1];
+    ::backtrace(warm, 1);
+
+    if (!prepare_thread()) {
+        return false;
+    }
+    g_fd = fd;
+
+    for (usize i = 0; i < sizeof(signals) / sizeof(int); ++i) {
+        struct sigaction action{};
+        action.sa_sigaction = on_crash;
+        action.sa_flags     = SA_SIGINFO | SA_ONSTACK;
+        // a second crash signal waits until the handler is done; a fault while they are blocked
+        // kills the process outright, which still dumps core
+        sigemptyset(&action.sa_mask);
+        for (const int blocked : signals) {
+            sigaddset(&action.sa_mask, blocked);
+        }
+        if (::sigaction(signals[i], &action, &g_previous[i]) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// appends crash records to the file at `path`, creating it if needed
+inline bool install(const char *path) {
+    const int fd = ::open(path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        return false;
+    }
+    if (!install(fd)) {
+        ::close(fd);
+        return false;
+    }
+    return true;
+}
+
+/// puts back the handlers `install` replaced
+inline void uninstall() {
+    using namespace __internal;
+    for (usize i = 0; i < sizeof(signals) / sizeof(int); ++i) {
+        ::sigaction(signals[i], &g_previous[i], nullptr);
+    }
+    g_fd = -1;
+}
+#endif
+}  // namespace Crash
+
+H_STD_NAMESPACE_END
+H_NAMESPACE_END
+
+#endif  // _$_HX_CORE_M5CRASH
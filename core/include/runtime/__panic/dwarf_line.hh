@@ -0,0 +1,657 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///-------------------------------------------------------------------------------- Lib-Helix ---///
+
+#ifndef _$_HX_CORE_M10DWARF_LINE
+#define _$_HX_CORE_M10DWARF_LINE
+
+#include <include/config/config.hh>
+
+#include <include/c++/libc++.hh>
+#include <include/types/builtins/primitives.hh>
+
+#if defined(__linux__) || defined(__FreeBSD__)
+#define __HELIX_DWARF_LINES__ 1
+#include <dlfcn.h>
+#include <elf.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/auxv.h>
+#endif
+#endif
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+/// source lines for native frames from the DWARF `.debug_line` of the module that holds them.
+///
+/// each ELF module is mapped once, the first time one of its addresses is looked up. every line
+/// program in it (DWARF 2 to 5) is run into one address-sorted row table, the mapping is dropped,
+/// and lookups after that are a binary search. compressed debug sections and separate debug files
+/// are not read; such modules simply have no lines. ELF platforms only.
+namespace Stacktrace::__internal {
+struct SourceLine {
+    const char *file;
+    uint32_t    line;
+};
+
+class LineTable {
+  public:
+    LineTable() = default;
+
+    /// the row covering `addr`, an address in the module's link-time address space
+    bool lookup(u64 addr, SourceLine &out) const noexcept {
+        usize lo = 0;
+        usize hi = rows.size();
+        while (lo < hi) {
+            const usize mid = lo + (hi - lo) / 2;
+            if (rows[mid].addr <= addr) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        if (lo == 0 || rows[lo - 1].line == 0) {
+            return false;  // before the first row or in a gap after an end_sequence
+        }
+        out = {files[rows[lo - 1].file].c_str(), rows[lo - 1].line};
+        return true;
+    }
+
+#ifdef __HELIX_DWARF_LINES__
+    /// maps the ELF file at `path` and indexes its line programs; `link_base` is set to the
+    /// lowest `PT_LOAD` address, which `dladdr`'s load base corresponds to
+    void load(const char *path) {
+        const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return;
+        }
+        struct stat st{};
+        void       *map = MAP_FAILED;
+        if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+            map = ::mmap(nullptr, static_cast<usize>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        ::close(fd);
+        if (map == MAP_FAILED) {
+            return;
+        }
+
+        const auto *image = static_cast<const u8 *>(map);
+        const usize size  = static_cast<usize>(st.st_size);
+        if (size > EI_CLASS && libcxx::memcmp(image, ELFMAG, SELFMAG) == 0) {
+            if (image[EI_CLASS] == ELFCLASS64) {
+                index_elf<Elf64_Ehdr, Elf64_Shdr, Elf64_Phdr>(image, size);
+            } else if (image[EI_CLASS] == ELFCLASS32) {
+                index_elf<Elf32_Ehdr, Elf32_Shdr, Elf32_Phdr>(image, size);
+            }
+        }
+        ::munmap(map, size);
+    }
+#endif
+
+    u64 link_base = 0;
+
+  private:
+    struct Row {
+        u64 addr;
+        u32 file;
+        u32 line;  // 0 marks the end of a sequence
+    };
+
+    /// a bounds-checked reader; running off the end yields zeros and clears `ok`
+    struct Cursor {
+        const u8 *p;
+        const u8 *end;
+        bool      ok = true;
+
+        template <typename T>
+        T read() noexcept {
+            T value{};
+            if (static_cast<usize>(end - p) < sizeof(T)) {
+                ok = false;
+                p  = end;
+                return value;
+            }
+            libcxx::memcpy(&value, p, sizeof(T));
+            p += sizeof(T);
+            return value;
+        }
+
+        u64 uleb() noexcept {
+            u64      value = 0;
+            unsigned shift = 0;
+            while (p < end) {
+                const u8 byte = *p++;
+                if (shift < 64) {
+                    value |= static_cast<u64>(byte & 0x7F) << shift;
+                }
+                shift += 7;
+                if ((byte & 0x80) == 0) {
+                    return value;
+                }
+            }
+            ok = false;
+            return value;
+        }
+
+        i64 sleb() noexcept {
+            i64      value = 0;
+            unsigned shift = 0;
+            u8       byte  = 0;
+            do {
+                if (p >= end) {
+                    ok = false;
+                    return value;
+                }
+                byte = *p++;
+                if (shift < 64) {
+                    value |= static_cast<i64>(static_cast<u64>(byte & 0x7F) << shift);
+                }
+                shift += 7;
+            } while ((byte & 0x80) != 0);
+            if (shift < 64 && (byte & 0x40) != 0) {
+                value |= -(static_cast<i64>(1) << shift);
+            }
+            return value;
+        }
+
+        const char *cstr() noexcept {
+            const char *s = reinterpret_cast<const char *>(p);
+            while (p < end && *p != 0) {
+                ++p;
+            }
+            if (p == end) {
+                ok = false;
+                return "";
+            }
+            ++p;
+            return s;
+        }
+
+        u64 sized(unsigned bytes) noexcept {
+            switch (bytes) {
+                case 1:
+                    return read<u8>();
+                case 2:
+                    return read<u16>();
+                case 4:
+                    return read<u32>();
+                case 8:
+                    return read<u64>();
+                default:
+                    ok = false;
+                    return 0;
+            }
+        }
+
+        void skip(u64 n) noexcept {
+            if (static_cast<u64>(end - p) < n) {
+                ok = false;
+                p  = end;
+            } else {
+                p += n;
+            }
+        }
+    };
+
+    struct Sections {
+        Cursor line{nullptr, nullptr};
+        Cursor line_str{nullptr, nullptr};
+        Cursor str{nullptr, nullptr};
+    };
+
+#ifdef __HELIX_DWARF_LINES__
+    template <typename Ehdr, typename Shdr, typename Phdr>
+    void index_elf(const u8 *image, usize size) {
+        Ehdr eh;
+        if (size < sizeof(eh)) {
+            return;
+        }
+        libcxx::memcpy(&eh, image, sizeof(eh));
+
+        link_base = ~u64(0);
+        for (usize i = 0; i < eh.e_phnum; ++i) {
+            Phdr ph;
+            if (eh.e_phoff + (i + 1) * sizeof(ph) > size) {
+                break;
+            }
+            libcxx::memcpy(&ph, image + eh.e_phoff + i * sizeof(ph), sizeof(ph));
+            if (ph.p_type == PT_LOAD && ph.p_vaddr < link_base) {
+                link_base = ph.p_vaddr & ~static_cast<u64>(ph.p_align > 1 ? ph.p_align - 1 : 0);
+            }
+        }
+        if (link_base == ~u64(0)) {
+            link_base = 0;
+        }
+
+        if (eh.e_shstrndx >= eh.e_shnum || eh.e_shoff + eh.e_shnum * sizeof(Shdr) > size) {
+            return;
+        }
+        auto section = [&](usize i) {
+            Shdr sh;
+            libcxx::memcpy(&sh, image + eh.e_shoff + i * sizeof(sh), sizeof(sh));
+            return sh;
+        };
+
+        const Shdr names = section(eh.e_shstrndx);
+        Sections   found;
+        for (usize i = 0; i < eh.e_shnum; ++i) {
+            const Shdr sh = section(i);
+            if (sh.sh_type == SHT_NOBITS || sh.sh_offset + sh.sh_size > size ||
+                names.sh_offset + sh.sh_name >= size || (sh.sh_flags & SHF_COMPRESSED) != 0) {
+                continue;
+            }
+            const char *name   = reinterpret_cast<const char *>(image + names.sh_offset + sh.sh_name);
+            const Cursor data = {image + sh.sh_offset, image + sh.sh_offset + sh.sh_size};
+            if (libcxx::strcmp(name, ".debug_line") == 0) {
+                found.line = data;
+            } else if (libcxx::strcmp(name, ".debug_line_str") == 0) {
+                found.line_str = data;
+            } else if (libcxx::strcmp(name, ".debug_str") == 0) {
+                found.str = data;
+            }
+        }
+
+        Cursor units = found.line;
+        while (units.ok && units.p < units.end) {
+            if (!run_unit(units, found)) {
+                break;
+            }
+        }
+
+        // equal addresses keep the end marker first so the row that starts there wins
+        libcxx::stable_sort(rows.begin(), rows.end(), [](const Row &a, const Row &b) {
+            return a.addr < b.addr || (a.addr == b.addr && a.line == 0 && b.line != 0);
+        });
+        rows.shrink_to_fit();
+    }
+#endif
+
+    /// a string attribute of a DWARF 5 directory or file entry
+    static const char *read_string(Cursor &c, u64 form, bool dwarf64, const Sections &s) noexcept {
+        auto at = [](const Cursor &table, u64 offset) -> const char * {
+            if (table.p == nullptr || offset >= static_cast<u64>(table.end - table.p)) {
+                return "";
+            }
+            Cursor tail{table.p + offset, table.end};
+            return tail.cstr();
+        };
+        switch (form) {
+            case 0x08:  // DW_FORM_string
+                return c.cstr();
+            case 0x1f:  // DW_FORM_line_strp
+                return at(s.line_str, c.sized(dwarf64 ? 8 : 4));
+            case 0x0e:  // DW_FORM_strp
+                return at(s.str, c.sized(dwarf64 ? 8 : 4));
+            default:
+                skip_form(c, form, dwarf64);
+                return "";
+        }
+    }
+
+    static u64 read_number(Cursor &c, u64 form, bool dwarf64) noexcept {
+        switch (form) {
+            case 0x0b:  // DW_FORM_data1
+                return c.read<u8>();
+            case 0x05:  // DW_FORM_data2
+                return c.read<u16>();
+            case 0x06:  // DW_FORM_data4
+                return c.read<u32>();
+            case 0x07:  // DW_FORM_data8
+                return c.read<u64>();
+            case 0x0f:  // DW_FORM_udata
+                return c.uleb();
+            default:
+                skip_form(c, form, dwarf64);
+                return 0;
+        }
+    }
+
+    static void skip_form(Cursor &c, u64 form, bool dwarf64) noexcept {
+        switch (form) {
+            case 0x08:
+                c.cstr();
+                break;
+            case 0x0b:
+            case 0x11:  // DW_FORM_strx1
+            case 0x25:
+                c.skip(1);
+                break;
+            case 0x05:
+            case 0x26:  // DW_FORM_strx2
+                c.skip(2);
+                break;
+            case 0x27:  // DW_FORM_strx3
+                c.skip(3);
+                break;
+            case 0x06:
+            case 0x28:  // DW_FORM_strx4
+                c.skip(4);
+                break;
+            case 0x07:
+                c.skip(8);
+                break;
+            case 0x1e:  // DW_FORM_data16
+                c.skip(16);
+                break;
+            case 0x0f:
+            case 0x1a:  // DW_FORM_strx
+                c.uleb();
+                break;
+            case 0x0e:
+            case 0x1f:
+                c.skip(dwarf64 ? 8 : 4);
+                break;
+            case 0x09:  // DW_FORM_block
+                c.skip(c.uleb());
+                break;
+            default:
+                c.ok = false;
+        }
+    }
+
+    static libcxx::string join(const char *dir, const char *name) {
+        if (name[0] == '/' || dir[0] == '\0') {
+            return name;
+        }
+        libcxx::string path = dir;
+        if (path.back() != '/') {
+            path += '/';
+        }
+        return path + name;
+    }
+
+    u32 file_id(libcxx::string path) {
+        auto [it, added] = file_ids.try_emplace(libcxx::move(path), static_cast<u32>(files.size()));
+        if (added) {
+            files.push_back(it->first);
+        }
+        return it->second;
+    }
+
+    /// reads one line-number program header and runs its opcodes into `rows`
+    bool run_unit(Cursor &units, const Sections &s) {
+        u64        length  = units.read<u32>();
+        const bool dwarf64 = length == 0xFFFFFFFF;
+        if (dwarf64) {
+            length = units.read<u64>();
+        }
+        if (!units.ok || length > static_cast<u64>(units.end - units.p)) {
+            return false;
+        }
+        Cursor unit{units.p, units.p + length};
+        units.p += length;
+
+        const u16 version = unit.read<u16>();
+        if (version < 2 || version > 5) {
+            return true;  // unknown layout: skip the unit
+        }
+        unsigned address_size = sizeof(void *);
+        if (version >= 5) {
+            address_size = unit.read<u8>();
+            unit.read<u8>();  // segment selector size
+        }
+        const u64 header_length = unit.sized(dwarf64 ? 8 : 4);
+        if (header_length > static_cast<u64>(unit.end - unit.p)) {
+            return true;
+        }
+        const u8 *program = unit.p + header_length;
+
+        const u8 min_inst = unit.read<u8>();
+        if (version >= 4) {
+            unit.read<u8>();  // maximum operations per instruction, 1 outside VLIW targets
+        }
+        unit.read<u8>();  // default_is_stmt
+        const i8 line_base   = unit.read<i8>();
+        const u8 line_range  = unit.read<u8>();
+        const u8 opcode_base = unit.read<u8>();
+        u8       lengths[256]{};
+        for (unsigned i = 1; i < opcode_base; ++i) {
+            lengths[i] = unit.read<u8>();
+        }
+        if (!unit.ok || line_range == 0) {
+            return true;
+        }
+
+        libcxx::vector<const char *> dirs;
+        libcxx::vector<u32>          unit_files;
+        if (version >= 5) {
+            auto entries = [&](auto &&take) {
+                const u8                              count = unit.read<u8>();
+                libcxx::vector<libcxx::pair<u64, u64>> format(count);
+                for (auto &f : format) {
+                    f = {unit.uleb(), unit.uleb()};
+                }
+                const u64 n = unit.uleb();
+                for (u64 i = 0; i < n && unit.ok; ++i) {
+                    const char *path = "";
+                    u64         dir  = 0;
+                    for (const auto &[type, form] : format) {
+                        if (type == 1) {  // DW_LNCT_path
+                            path = read_string(unit, form, dwarf64, s);
+                        } else if (type == 2) {  // DW_LNCT_directory_index
+                            dir = read_number(unit, form, dwarf64);
+                        } else {
+                            skip_form(unit, form, dwarf64);
+                        }
+                    }
+                    take(path, dir);
+                }
+            };
+            entries([&](const char *path, u64) { dirs.push_back(path); });
+            entries([&](const char *path, u64 dir) {
+                unit_files.push_back(file_id(join(dir < dirs.size() ? dirs[dir] : "", path)));
+            });
+        } else {
+            // index 0 is the compilation directory, which only .debug_info records
+            dirs.push_back("");
+            while (unit.ok) {
+                const char *dir = unit.cstr();
+                if (dir[0] == '\0') {
+                    break;
+                }
+                dirs.push_back(dir);
+            }
+            unit_files.push_back(file_id(""));  // files count from 1 before DWARF 5
+            while (unit.ok) {
+                const char *name = unit.cstr();
+                if (name[0] == '\0') {
+                    break;
+                }
+                const u64 dir = unit.uleb();
+                unit.uleb();  // modification time
+                unit.uleb();  // length
+                unit_files.push_back(file_id(join(dir < dirs.size() ? dirs[dir] : "", name)));
+            }
+        }
+        if (!unit.ok || unit_files.empty()) {
+            return true;
+        }
+
+        Cursor code{program, unit.end};
+        run_program(code, min_inst, line_base, line_range, opcode_base, lengths, address_size,
+                    unit_files, dirs);
+        return true;
+    }
+
+    void run_program(Cursor                             &code,
+                     u8                                  min_inst,
+                     i8                                  line_base,
+                     u8                                  line_range,
+                     u8                                  opcode_base,
+                     const u8                           *lengths,
+                     unsigned                            address_size,
+                     libcxx::vector<u32>                &unit_files,
+                     const libcxx::vector<const char *> &dirs) {
+        u64   address = 0;
+        u64   file    = 1;
+        i64   line    = 1;
+        usize first   = rows.size();
+
+        auto emit = [&] {
+            const u32 id = file < unit_files.size() ? unit_files[file] : unit_files[0];
+            rows.push_back({address, id, static_cast<u32>(line > 0 ? line : 1)});
+        };
+        auto end_sequence = [&] {
+            // a sequence starting at 0 or at a tombstone belongs to code the linker dropped
+            if (first == rows.size() || rows[first].addr == 0 || rows[first].addr >= ~u64(1)) {
+                rows.resize(first);
+            } else {
+                rows.push_back({address, 0, 0});
+            }
+            address = 0;
+            file    = 1;
+            line    = 1;
+            first   = rows.size();
+        };
+
+        while (code.ok && code.p < code.end) {
+            const u8 op = code.read<u8>();
+            if (op >= opcode_base) {
+                const u8 adjusted = op - opcode_base;
+                address += static_cast<u64>(adjusted / line_range) * min_inst;
+                line += line_base + adjusted % line_range;
+                emit();
+                continue;
+            }
+            switch (op) {
+                case 0: {  // extended opcode
+                    const u64 len = code.uleb();
+                    if (len == 0 || len > static_cast<u64>(code.end - code.p)) {
+                        code.ok = false;
+                        break;
+                    }
+                    const u8 *next = code.p + len;
+                    const u8  sub  = code.read<u8>();
+                    if (sub == 1) {  // DW_LNE_end_sequence
+                        end_sequence();
+                    } else if (sub == 2) {  // DW_LNE_set_address
+                        address = code.sized(len - 1 <= 8 ? static_cast<unsigned>(len - 1)
+                                                          : address_size);
+                    } else if (sub == 3) {  // DW_LNE_define_file
+                        const char *name = code.cstr();
+                        const u64   dir  = code.uleb();
+                        unit_files.push_back(
+                            file_id(join(dir < dirs.size() ? dirs[dir] : "", name)));
+                    }
+                    code.p = next;
+                    break;
+                }
+                case 1:  // DW_LNS_copy
+                    emit();
+                    break;
+                case 2:  // DW_LNS_advance_pc
+                    address += code.uleb() * min_inst;
+                    break;
+                case 3:  // DW_LNS_advance_line
+                    line += code.sleb();
+                    break;
+                case 4:  // DW_LNS_set_file
+                    file = code.uleb();
+                    break;
+                case 8:  // DW_LNS_const_add_pc
+                    address += static_cast<u64>((255 - opcode_base) / line_range) * min_inst;
+                    break;
+                case 9:  // DW_LNS_fixed_advance_pc
+                    address += code.read<u16>();
+                    break;
+                default:  // column, flags, isa and anything newer: skip the operands
+                    for (u8 i = 0; i < lengths[op]; ++i) {
+                        code.uleb();
+                    }
+                    break;
+            }
+        }
+        rows.resize(first);  // drop a sequence the program never ended
+    }
+
+    libcxx::vector<Row>                         rows;
+    libcxx::vector<libcxx::string>              files;
+    libcxx::unordered_map<libcxx::string, u32>  file_ids;
+};
+
+/// every module's `LineTable`, built on the first lookup that lands in it and kept after that
+class LineTables {
+  public:
+    static LineTables &instance() noexcept {
+        static LineTables tables;
+        return tables;
+    }
+
+    /// the source line of the instruction before the return address `pc`
+    bool lookup(const void *pc, SourceLine &out) {
+#ifdef __HELIX_DWARF_LINES__
+        Dl_info info{};
+        if (dladdr(pc, &info) == 0 || info.dli_fbase == nullptr) {
+            return false;
+        }
+
+        libcxx::lock_guard<libcxx::mutex> guard(lock);
+
+        auto &table = modules[reinterpret_cast<uintptr_t>(info.dli_fbase)];
+        if (table == nullptr) {
+            table = libcxx::make_unique<LineTable>();
+            table->load(module_path(info));
+        }
+
+        const u64 offset = reinterpret_cast<uintptr_t>(pc) - 1 -
+                           reinterpret_cast<uintptr_t>(info.dli_fbase);
+        return table->lookup(table->link_base + offset, out);
+#else
+        (void)pc;
+        (void)out;
+        return false;
+#endif
+    }
+
+    /// forgets every module; called when one is unloaded, since another may load at its base
+    void clear() {
+        libcxx::lock_guard<libcxx::mutex> guard(lock);
+        retired.reserve(retired.size() + modules.size());
+        for (auto &entry : modules) {
+            retired.push_back(libcxx::move(entry.second));  // a trace may still use its names
+        }
+        modules.clear();
+    }
+
+  private:
+    LineTables() = default;
+
+#ifdef __HELIX_DWARF_LINES__
+    /// `dladdr` names the main program the way it was started, which need not be openable
+    static const char *module_path(const Dl_info &info) noexcept {
+#ifdef __linux__
+        Dl_info main{};
+        if (dladdr(reinterpret_cast<void *>(getauxval(AT_PHDR)), &main) != 0 &&
+            main.dli_fbase == info.dli_fbase) {
+            return "/proc/self/exe";
+        }
+#endif
+        return info.dli_fname != nullptr ? info.dli_fname : "";
+    }
+#endif
+
+    libcxx::mutex                                                      lock;
+    libcxx::unordered_map<uintptr_t, libcxx::unique_ptr<LineTable>>   modules;
+    libcxx::vector<libcxx::unique_ptr<LineTable>>                      retired;
+};
+}  // namespace Stacktrace::__internal
+
+H_STD_NAMESPACE_END
+H_NAMESPACE_END
+
+#endif  // _$_HX_CORE_M10DWARF_LINE
@@ -45,6 +45,11 @@ namespace Panic {
 /// - **Type Constraints**: The `Frame` class enforces strong constraints on the provided type.
 ///   It ensures that the type is either copy or move constructible and implements the Helix
 ///   panic interface (`Panicking` concept).
+/// - **Cheap Construction**: Errors are returned through `T?` as ordinary control flow, so a
+///   frame keeps the file as the caller's static `const char *` (`__FILE__`), asks the object
+///   for its reason only when `reason()` is called, and shares its `FrameContext`: copies are
+///   a reference count, and a small error is stored without an allocation of its own. The
+///   file, line and `show_trace` live in the context's block, so a `Frame` is one pointer.
 ///
 /// ### Responsibilities
 /// - Store details about the panic, including:
@@ -82,8 +87,9 @@ namespace Panic {
 ///
 /// ### Notes
 /// - The default constructor is explicitly deleted to prevent creating invalid `Frame` instances.
-/// - Copy operations are also deleted to maintain unique ownership of the panic context.
-/// - Move operations are supported, allowing transfer of ownership.
+/// - Copies share the panic object; move operations transfer it.
+/// - `filename` given as `const char *` must outlive the frame, as string literals and
+///   `source_location` names do; a `string` file name is kept with the panic object.
 ///
 /// ### Interactions with FrameContext
 /// The `Frame` class heavily relies on `FrameContext` to manage the lifecycle of the panic object.
@@ -93,7 +99,7 @@ namespace Panic {
 /// - **`initialize<T>`**:
 ///   - Determines whether the type supports static (`T::operator$panic`) or instance-level
 ///     (`obj.operator$panic`) panic methods.
-///   - Constructs the panic object dynamically and wraps it in a `FrameContext`.
+///   - Moves the panic object into a `FrameContext`.
 /// - **`operator$panic`**:
 ///   - Invokes the internal panic handler.
 ///   - Calls `FrameContext::crash()` to throw the managed object.
@@ -114,17 +120,12 @@ namespace Panic {
 class Frame {
   private:
     mutable FrameContext context;
-    string               _reason;
-    string               _file;
-    usize                _line = 0;
 
     template <typename T>
         requires std ::Interface ::ClassType<T>
-    void initialize(const T *obj);
+    void initialize(T *obj);
 
   public:
-    bool show_trace = true;
-
     template <typename T>
     inline Frame(T obj, const char *filename, usize lineno);
 
@@ -148,6 +149,11 @@ class Frame {
     [[nodiscard]] inline string        reason() const;
     [[nodiscard]] inline FrameContext *get_context() const;
 
+    /// whether the default handler prints the stack trace. the flag is in the shared block, so
+    /// turning it off on one copy turns it off for every copy of the same error
+    [[nodiscard]] inline bool show_trace() const noexcept;
+    inline void               show_trace(bool show) noexcept;
+
     [[noreturn]] inline void operator$panic() const;
 };
 }  // namespace Panic
@@ -18,8 +18,9 @@
 
 #include <include/config/config.hh>
 
-#include <include/runtime/__function/function_impl.hh>
-#include <include/types/type_erasure/erasure_base.hh>
+#include <include/c++/libc++.hh>
+#include <include/types/string/basic.hh>
+#include <include/types/type_erasure/type_id.hh>
 
 H_NAMESPACE_BEGIN
 H_STD_NAMESPACE_BEGIN
@@ -28,47 +29,40 @@ namespace Panic {
 /// \class FrameContext
 ///
 /// `FrameContext` is a core component of the Helix language's panic handling system.
-/// It provides dynamic management for objects, integrating type-erasure techniques
+/// It owns the object a frame panics with, integrating type-erasure techniques
 /// with panic handling and exception propagation.
 ///
 /// ### Design Details
-/// - **Dynamic Management**: Stores objects of arbitrary types using the `TypeErasure`
-///   interface, allowing for flexible and type-safe storage.
-/// - **Panic Integration**: Supports Helix's panic system by associating objects
-///   with panic messages and enabling their propagation as exceptions.
-/// - **Safe Cleanup**: Ensures all managed objects are properly destroyed when
-///   the `FrameContext` is destructed or reassigned.
+/// - **Shared State**: The object lives in one reference-counted block shared by every
+///   copy of the context, so copying a frame (or a `T?` holding one) is a counter bump.
+///   The block also holds the frame's `Origin`, which keeps a `Frame` one pointer wide.
+/// - **Inline Storage**: Objects up to `inline_size` bytes are moved into the block
+///   itself; larger ones get an allocation of their own. Blocks are recycled through a
+///   small per-thread cache, so a thread that keeps returning errors stops allocating.
+/// - **Static Dispatch**: Everything type-specific (destroying, throwing, the panic
+///   reason and the type itself) sits in one constant table per type, with no wrappers
+///   on the heap.
+/// - **Safe Cleanup**: The object is destroyed when the last context sharing it is
+///   destructed or reassigned.
 ///
 /// ### Responsibilities
-/// - Manage the lifecycle of dynamically allocated objects.
+/// - Manage the lifetime of the panicking object.
 /// - Facilitate panic handling and exception throwing for managed objects.
-/// - Provide interfaces for cloning, comparison, and access to the stored object.
-///
-/// ### Usage in Helix
-/// `FrameContext` is typically used within Helix's panic handling system. When a
-/// panic occurs, `FrameContext` manages the offending object, ensuring it is
-/// correctly propagated and destroyed.
-///
-/// ### Key Features
-/// - **Type Erasure**: Uses `TypeErasure` to manage objects of arbitrary types.
-/// - **Panic Propagation**: Supports throwing the managed object as an exception
-///   using the Helix panic mechanism.
-/// - **Lifecycle Management**: Ensures proper cleanup of objects, preventing memory
-///   leaks and undefined behavior.
+/// - Provide the panic reason, the type, and access to the stored object.
 ///
 /// ### Implementation Notes
 /// - The constructor accepts any object type that satisfies the constraints
-///   defined by Helix's `Panicking` concept.
+///   defined by Helix's `Panicking` concept, and moves (or copies) it in.
 /// - The `crash()` method propagates the managed object as an exception, terminating
 ///   the current context.
-/// - Copy and move constructors ensure the `FrameContext` can be safely duplicated
-///   or transferred.
+/// - Copies share the object; the object is never mutated after construction, so
+///   sharing is not observable.
 ///
 /// ### Example
 /// \code{.cpp}
 /// // Creating a FrameContext with a custom object
-/// MyError *error = new MyError();
-/// FrameContext context(error);
+/// MyError error;
+/// FrameContext context(&error);
 ///
 /// // Accessing the managed object
 /// void *obj = context.object();
@@ -77,17 +71,68 @@ namespace Panic {
 /// context.crash();
 /// \endcode
 class FrameContext {
+  public:
+    /// objects up to this size (and the default alignment) are stored without an allocation
+    static constexpr usize inline_size = 64;
+
+    /// where the frame holding this context was raised
+    struct Origin {
+        const char *file = "";  ///< a static string, unless `owned_file` is set
+        string      owned_file;  ///< a file name the frame was given at runtime
+        usize       line = 0;
+
+        /// set on one copy of the frame, seen by all of them; atomic since copies of a frame
+        /// may be handled on different threads
+        libcxx::atomic<bool> show_trace{true};
+    };
+
   private:
-    std::TypeErasure                   *error;    ///< The error object.
-    $function<void(std::TypeErasure *)> handler;  ///< The panic handler.
+    /// what the context needs from the object's type, one constant table per type
+    struct Ops {
+        TypeId                   id;
+        const libcxx::type_info *type;  ///< for the name only; matching goes through `id`
+        void (*destroy)(void *) noexcept;
+        string (*reason)(const void *);
+        void (*throw_object)(void *);
+    };
+
+    /// the object and what every copy of the context shares
+    struct State {
+        libcxx::atomic<usize> refs{1};
+        const Ops            *ops    = nullptr;
+        void                 *object = nullptr;  ///< into `buffer`, or a separate allocation
+        Origin                origin;
+
+        alignas(libcxx::max_align_t) unsigned char buffer[inline_size];
+    };
+
+    State *state = nullptr;
+
+    template <typename T>
+    static constexpr bool stored_inline =
+        sizeof(T) <= inline_size && alignof(T) <= alignof(libcxx::max_align_t);
 
     template <typename T>
-    [[noreturn]] static constexpr void throw_object(std::TypeErasure *);
+    [[noreturn]] static constexpr void throw_object(void *);
+
+    template <typename T>
+    static void destroy_object(void *object) noexcept;
+
+    template <typename T>
+    static string reason_of(const void *object);
+
+    template <typename T>
+    static constexpr Ops ops_for = {
+        TypeId::of<T>(), &typeid(T), &destroy_object<T>, &reason_of<T>, &throw_object<T>};
+
+    static inline State *acquire();
+    static inline void   release(State *block) noexcept;
+    static inline void   unref(State *block) noexcept;
 
   public:
-    inline FrameContext();
-    inline FrameContext(const FrameContext &other);
-    inline FrameContext &operator=(const FrameContext &other);
+    inline FrameContext() noexcept = default;
+    inline FrameContext(const FrameContext &other) noexcept;
+    inline FrameContext &operator=(const FrameContext &other) noexcept;
     inline FrameContext(FrameContext &&other) noexcept;
     inline FrameContext &operator=(FrameContext &&other) noexcept;
     inline ~FrameContext();
@@ -99,8 +144,17 @@ class FrameContext {
     [[nodiscard]] inline void  *object() const;
     [[nodiscard]] inline string type_name() const;
 
+    /// the object's panic message, produced on each call rather than stored
+    [[nodiscard]] inline string reason() const;
+
+    /// the origin shared by every copy, or null for an empty context
+    [[nodiscard]] inline Origin *origin() const noexcept;
+
     inline bool operator!=(const libcxx::type_info *rhs) const;
     inline bool operator==(const libcxx::type_info *rhs) const;
+
+    /// whether the object is exactly a given type; one pointer compare within a module
+    inline bool operator==(TypeId rhs) const noexcept;
 };
 };  // namespace Panic
 
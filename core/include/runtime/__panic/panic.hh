@@ -35,7 +35,7 @@ template <typename T>
 ) {
     if constexpr (Panic::Interface::Panicking<T>) {
         auto frame = std::Panic::Frame(error, location.file_name(), location.line());
-        frame.show_trace = false;
+        frame.show_trace(false);
         HX_FN_Vi_Q5_13_helixpanic_handler_Q3_5_5_stdPanicFrame_C_PK_Rv(&frame);
         throw error; // Ensure the program terminates after the panic handler is executed
     } else {
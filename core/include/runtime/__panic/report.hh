@@ -0,0 +1,294 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///-------------------------------------------------------------------------------- Lib-Helix ---///
+
+#ifndef _$_HX_CORE_M6REPORT
+#define _$_HX_CORE_M6REPORT
+
+#include <include/config/config.hh>
+
+#include <include/c++/libc++.hh>
+#include <include/runtime/__io/__print/buffer.hh>
+#include <include/runtime/__panic/stacktrace.hh>
+#include <include/types/types.hh>
+
+#ifndef _WIN32
+#ifdef __APPLE__
+#include <mach-o/dyld.h>
+#include <mach-o/loader.h>
+#else
+#include <dlfcn.h>
+#include <link.h>
+#endif
+#endif
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+namespace Stacktrace {
+/// what kind of binary a module path names, as the panic report labels it
+enum class ModuleFormat : u8 {
+    Unknown,
+    Elf,
+    MachO,
+};
+
+namespace __internal {
+    /// the loaded modules by path, read from the loader's own tables instead of from disk. it is
+    /// built on the first lookup and rebuilt only when a lookup misses after modules were added.
+    /// Windows traces carry no native frames, so it is empty there and labels come from the
+    /// file extension
+    class ModuleTable {
+      public:
+        static ModuleTable &instance() noexcept {
+            static ModuleTable table;
+            return table;
+        }
+
+        ModuleFormat format_of(libcxx::string_view path) {
+            libcxx::lock_guard<libcxx::mutex> guard(lock);
+            if (auto it = formats.find(path); it != formats.end()) {
+                return it->second;
+            }
+            if (rebuild()) {
+                if (auto it = formats.find(path); it != formats.end()) {
+                    return it->second;
+                }
+            }
+            return ModuleFormat::Unknown;
+        }
+
+      private:
+        struct Hash {
+            using is_transparent = void;
+            usize operator()(libcxx::string_view s) const noexcept {
+                return libcxx::hash<libcxx::string_view>{}(s);
+            }
+        };
+
+        ModuleTable() = default;
+
+        /// re-reads the module list if it changed since the last read; true if it did
+        bool rebuild() {
+#if defined(_WIN32)
+            return false;
+#elif defined(__APPLE__)
+            const u32 count = _dyld_image_count();
+            if (count == seen) {
+                return false;
+            }
+            seen = count;
+            for (u32 i = 0; i < count; ++i) {
+                if (const char *name = _dyld_get_image_name(i); name != nullptr) {
+                    formats.emplace(name, ModuleFormat::MachO);
+                }
+            }
+            return true;
+#else
+            u64 adds = 0;
+            dl_iterate_phdr(
+                [](struct dl_phdr_info *info, size_t size, void *data) -> int {
+                    if (size >= offsetof(struct dl_phdr_info, dlpi_adds) + sizeof(info->dlpi_adds)) {
+                        *static_cast<u64 *>(data) = info->dlpi_adds;
+                    }
+                    return 1;
+                },
+                &adds);
+            if (adds != 0 && adds == seen) {
+                return false;
+            }
+            seen = adds;
+
+            struct Found {
+                libcxx::vector<cstring> names;
+                const void             *main_base = nullptr;
+            } found;
+            dl_iterate_phdr(
+                [](struct dl_phdr_info *info, size_t, void *data) -> int {
+                    auto &out = *static_cast<Found *>(data);
+                    if (info->dlpi_name != nullptr && info->dlpi_name[0] != '\0') {
+                        out.names.emplace_back(info->dlpi_name);
+                    } else if (out.main_base == nullptr) {
+                        // the main program is listed without a name; look it up outside the
+                        // iteration, which holds the loader's lock
+                        for (int i = 0; i < info->dlpi_phnum; ++i) {
+                            if (info->dlpi_phdr[i].p_type == PT_LOAD) {
+                                out.main_base = reinterpret_cast<const void *>(
+                                    info->dlpi_addr + info->dlpi_phdr[i].p_vaddr);
+                                break;
+                            }
+                        }
+                    }
+                    return 0;
+                },
+                &found);
+
+            for (cstring &name : found.names) {
+                formats.emplace(libcxx::move(name), ModuleFormat::Elf);
+            }
+            Dl_info main{};
+            if (found.main_base != nullptr &&
+                dladdr(const_cast<void *>(found.main_base), &main) != 0 &&
+                main.dli_fname != nullptr) {
+                formats.emplace(main.dli_fname, ModuleFormat::Elf);  // the name dladdr reports
+            }
+            return true;
+#endif
+        }
+
+        libcxx::mutex                                                        lock;
+        libcxx::unordered_map<cstring, ModuleFormat, Hash, libcxx::equal_to<>> formats;
+        u64                                                                  seen = 0;
+    };
+
+    /// the report of the panic being rendered on this thread; it keeps its capacity, so only
+    /// a thread's first panic allocates
+    inline cstring &report_buffer() {
+        static thread_local cstring buffer = [] {
+            cstring b;
+            b.reserve(32 * 1024);
+            return b;
+        }();
+        return buffer;
+    }
+
+    inline void append(cstring &out, const string &text) {
+        namespace transcode = String::__internal::transcode;
+
+        const usize at = out.size();
+        out.resize(at + transcode::wide_to_utf8_length(text.raw(), text.size()));
+        transcode::wide_to_utf8(
+            text.raw(), text.size(), reinterpret_cast<char8_t *>(out.data() + at));
+    }
+
+    /// the ` (elf)`-style label after a module path, or nothing for a source file
+    inline libcxx::string_view format_label(const char *file) {
+        switch (ModuleTable::instance().format_of(file)) {
+            case ModuleFormat::Elf:
+                return " (elf)";
+            case ModuleFormat::MachO:
+                return " (mach-o)";
+            case ModuleFormat::Unknown:
+                break;
+        }
+
+        const libcxx::string_view path(file);
+        const usize               dot = path.rfind('.');
+        if (dot == libcxx::string_view::npos || path.find('/', dot) != libcxx::string_view::npos) {
+            return "";
+        }
+        const libcxx::string_view ext = path.substr(dot);
+        if (ext == ".exe") {
+            return " (exe)";
+        }
+        if (ext == ".dll") {
+            return " (dll)";
+        }
+        if (ext == ".lib") {
+            return " (lib)";
+        }
+        if (ext == ".so" || ext == ".dylib") {
+            return " (shared object)";
+        }
+        if (ext == ".a") {
+            return " (unix archive)";
+        }
+        return "";
+    }
+}  // namespace __internal
+
+/// what the default panic handler reports
+struct PanicReport {
+    string error_type;
+    string reason;
+    string file;
+    usize  line = 0;
+};
+
+/// renders `report` and, when `frames` is not null, the trace that led to it into one buffer and
+/// writes it to standard output in a single `write`. nothing is read from disk: module formats
+/// come from `ModuleTable` and names from `resolve`
+inline void write_panic_report(const PanicReport &report, const FrameSummary *frames) {
+    constexpr libcxx::string_view bold         = "\033[1m";
+    constexpr libcxx::string_view reset        = "\033[0m";
+    constexpr libcxx::string_view red          = "\033[31m";
+    constexpr libcxx::string_view cyan         = "\033[36m";
+    constexpr libcxx::string_view light_green  = "\033[92m";
+    constexpr libcxx::string_view light_cyan   = "\033[96m";
+    constexpr libcxx::string_view light_yellow = "\033[93m";
+    constexpr libcxx::string_view light_red    = "\033[91m";
+
+    cstring &out = __internal::report_buffer();
+    out.clear();
+
+    if (frames != nullptr) {
+        ((out += '\n') += cyan) += bold;
+        (((out += "Stack trace ") += reset) += "(most recent call last):") += reset;
+        out += '\n';
+    }
+
+    for (const FrameSummary *cur = frames; cur != nullptr; cur = cur->prev) {
+        if (cur->loc == nullptr) {
+            continue;
+        }
+        const Location &loc = *cur->loc;
+
+        if (cur->prev == nullptr) {
+            // the innermost frame is the panic itself
+            ((out += "        panic at ") += light_yellow);
+            __internal::append(out, report.file);
+            ((((out += reset) += ':') += light_yellow) += libcxx::to_string(report.line)) += reset;
+            out += '\n';
+            break;
+        }
+
+        (out += "    ") += light_green;
+        if (cur->kind == FrameKind::Native) {
+            out += loc.func;
+        } else {
+            __internal::append(
+                out, ABI::strip_helix_prefix(ABI::demangle_partial(loc.function_name())));
+        }
+        (out += reset) += ":\n";
+
+        ((out += "      at ") += light_yellow) += loc.file;
+        out += reset;
+        if (loc.line != 0) {
+            (((out += ':') += light_yellow) += libcxx::to_string(loc.line)) += reset;
+        }
+        if (const auto label = __internal::format_label(loc.file); !label.empty()) {
+            ((out += light_cyan) += label) += reset;
+        }
+        out += '\n';
+    }
+
+    if (frames != nullptr) {
+        out += '\n';
+    }
+    (((out += red) += bold) += "panic") += reset;
+    (((out += ": ") += light_red) += bold);
+    __internal::append(out, report.error_type);
+    (((out += reset) += '(') += light_green) += '"';
+    __internal::append(out, report.reason);
+    ((out += '"') += reset) += ")\n";
+
+    std::flush();  // whatever the thread printed before the panic goes first
+    Stdout::__internal::write_all(reinterpret_cast<const char8_t *>(out.data()), out.size());
+}
+}  // namespace Stacktrace
+
+H_STD_NAMESPACE_END
+H_NAMESPACE_END
+
+#endif  // _$_HX_CORE_M6REPORT
@@ -20,6 +20,8 @@
 #include <include/c++/libc++.hh>
 #include <include/runtime/__io/__print/print.hh>
 #include <include/runtime/__io/__print/stringf.hh>
+#include <include/runtime/__panic/dwarf_line.hh>
+#include <include/runtime/__panic/symbol_cache.hh>
 #include <include/types/types.hh>
 
 #ifdef _WIN32
@@ -37,6 +39,9 @@
 #endif
 #endif
 
+/// what every trace site sees unless a narrower `HELIX_NO_TRACE` shadows it
+inline constexpr bool helix_trace_enabled = true;
+
 H_NAMESPACE_BEGIN
 H_STD_NAMESPACE_BEGIN
 
@@ -55,52 +60,39 @@ enum class FrameKind : uint8_t {
     Hybrid = 1,
     Native = 2,
 };
+/// where a traced function lives: pointers to the compile-time `__FILE__` and function name
+/// strings (UTF-8) and the line. registration sites declare these `static constexpr`, so they
+/// cost 24 bytes of `.rodata` and no initialization; they are only widened when a trace is
+/// rendered.
 struct Location {
-    const wchar_t *file;
-    const wchar_t *func;
-    uint32_t       line;
-
-    wchar_t file_buf[1024];
-    wchar_t func_buf[1024];
-
-    static void char_to_wchar(const char *src, wchar_t *dst, size_t dst_cap) {
-        if (!src || !dst || dst_cap == 0) {
-            return;
-        }
-
-        size_t converted = mbstowcs(dst, src, dst_cap - 1);
-        if (converted == (size_t)-1) {
-            dst[0] = L'\0';
-        } else {
-            dst[converted] = L'\0';
-        }
+    const char *file = "";
+    const char *func = "";
+    uint32_t    line = 0;
+
+    constexpr Location() = default;
+    constexpr Location(const char *f, const char *fn, uint32_t l)
+        : file(f != nullptr ? f : "")
+        , func(fn != nullptr ? fn : "")
+        , line(l) {}
+
+    string file_name() const {
+        return utf8_to_string(file, libcxx::char_traits<char>::length(file));
     }
-
-    Location(const char *f, const char *fn, uint32_t l)
-        : file(file_buf)
-        , func(func_buf)
-        , line(l) {
-        char_to_wchar(f, file_buf, sizeof(file_buf) / sizeof(wchar_t));
-        char_to_wchar(fn, func_buf, sizeof(func_buf) / sizeof(wchar_t));
-    }
-
-    Location()
-        : file(L"")
-        , func(L"")
-        , line(0) {
-        file_buf[0] = L'\0';
-        func_buf[0] = L'\0';
+    string function_name() const {
+        return utf8_to_string(func, libcxx::char_traits<char>::length(func));
     }
 };
 
+static_assert(sizeof(Location) <= 3 * sizeof(void *), "Location must stay three words");
+
 #if defined(_MSC_VER)
 #  pragma warning(push)
 #  pragma warning(disable : 4324) // structure was padded due to alignment specifier
 #endif
 
 struct alignas(16) FrameSummary {  // exactly 32 bytes on 64-bit and 16 bytes on 32-bit
-    Location     *loc;
-    FrameSummary *prev;
+    const Location *loc;
+    FrameSummary   *prev;
     FrameKind     kind;
 };
 
@@ -110,22 +102,42 @@ struct alignas(16) FrameSummary {  // exactly 32 bytes on 64-bit and 16 bytes on
 #endif
 
 #if defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER)
-inline thread_local FrameSummary *g_tls_helix_head = nullptr;
+HELIX_TLS_INITIAL_EXEC inline thread_local FrameSummary *g_tls_helix_head = nullptr;
 #else
 inline const FrameSummary *g_tls_helix_head = nullptr;
 #endif
 
 struct RegisterFrame {
-    FrameSummary frame{};
+    FrameSummary frame;
+
+    /// a frame `enter` must link before it is destroyed, unless it never leaves constant
+    /// evaluation. the trace macros use this form so the `Location` can be declared where
+    /// constant evaluation never reaches it
+    constexpr RegisterFrame() noexcept {}
 
     explicit RegisterFrame(const Location *loc, const FrameKind kind = FrameKind::Hybrid) noexcept {
-        frame.loc        = const_cast<Location *>(loc);
+        enter(loc, kind);
+    }
+
+    /// links `loc` onto this thread's trace until this frame is destroyed
+    void enter(const Location *loc, const FrameKind kind = FrameKind::Hybrid) noexcept {
+        frame.loc        = loc;
         frame.prev       = g_tls_helix_head;
         frame.kind       = kind;
+        // the frame must be complete before it is reachable: a signal handler (the profiler)
+        // may walk the chain between any two instructions of this thread
+        libcxx::atomic_signal_fence(libcxx::memory_order_release);
         g_tls_helix_head = &frame;
     }
 
-    ~RegisterFrame() noexcept { g_tls_helix_head = frame.prev; }
+    constexpr ~RegisterFrame() noexcept {
+        if !consteval {
+            // without this a leaf body that calls nothing lets the compiler drop the link and
+            // the unlink as dead stores, hiding the frame from a signal taken inside it
+            libcxx::atomic_signal_fence(libcxx::memory_order_release);
+            g_tls_helix_head = frame.prev;
+        }
+    }
 
     RegisterFrame(const RegisterFrame &)            = delete;
     RegisterFrame &operator=(const RegisterFrame &) = delete;
@@ -133,253 +145,345 @@ struct RegisterFrame {
     RegisterFrame &operator=(RegisterFrame &&)      = delete;
 };
 
+/// what a trace macro declares in a scope that opted out with `HELIX_NO_TRACE`
+struct NoFrame {
+    constexpr void enter(const Location *, const FrameKind = FrameKind::Hybrid) noexcept {}
+};
+
+template <bool Enabled>
+using ScopeFrame = libcxx::conditional_t<Enabled, RegisterFrame, NoFrame>;
+
 #if defined(_MSC_VER) && _MSC_VER < 1940
 #  error "Helix requires MSVC 19.14 (VS 2017 15.7) or newer for constexpr tracing support."
 #endif
 
+// the frame is declared in the caller's scope so it stays linked until the function returns;
+// the `Location` is constant-initialized and only reached outside constant evaluation. a scope
+// that names `HELIX_NO_TRACE` shadows `helix_trace_enabled` and gets an empty `NoFrame` instead
+#if HELIX_TRACE_LEVEL >= HELIX_TRACE_HELIX
 #define __REGISTER_TRACE_BLOCK__(file_cstr, line_num, var_n)                   \
-    if !consteval {                                                            \
-      static ::helix::std::Stacktrace::Location var_n{                         \
-          (file_cstr), __HELIX_FUNCNAME__, static_cast<uint32_t>(line_num)};   \
-      ::helix::std::Stacktrace::RegisterFrame _hx_scope(                       \
-          &var_n, std::Stacktrace::FrameKind::Helix);                          \
+    ::helix::std::Stacktrace::ScopeFrame<helix_trace_enabled> _hx_scope;       \
+    if constexpr (helix_trace_enabled) {                                       \
+      if !consteval {                                                          \
+        static constexpr ::helix::std::Stacktrace::Location var_n{             \
+            (file_cstr), __HELIX_FUNCNAME__, static_cast<uint32_t>(line_num)}; \
+        _hx_scope.enter(&var_n, ::helix::std::Stacktrace::FrameKind::Helix);   \
+      }                                                                        \
     }
 
 #define __REGISTER_HELIX_TRACE_BLOCK__(file_cstr, line_num, func_cstr, var_n)  \
-    if !consteval {                                                            \
-      static ::helix::std::Stacktrace::Location var_n{                         \
-          (file_cstr), (func_cstr), static_cast<uint32_t>(line_num)};          \
-      ::helix::std::Stacktrace::RegisterFrame _hx_scope(                       \
-          &var_n, std::Stacktrace::FrameKind::Helix);                          \
+    ::helix::std::Stacktrace::ScopeFrame<helix_trace_enabled> _hx_scope;       \
+    if constexpr (helix_trace_enabled) {                                       \
+      if !consteval {                                                          \
+        static constexpr ::helix::std::Stacktrace::Location var_n{             \
+            (file_cstr), (func_cstr), static_cast<uint32_t>(line_num)};        \
+        _hx_scope.enter(&var_n, ::helix::std::Stacktrace::FrameKind::Helix);   \
+      }                                                                        \
     }
+#else
+#define __REGISTER_TRACE_BLOCK__(file_cstr, line_num, var_n)
+#define __REGISTER_HELIX_TRACE_BLOCK__(file_cstr, line_num, func_cstr, var_n)
+#endif
 
+#if HELIX_TRACE_LEVEL >= HELIX_TRACE_FULL
 #define __REGISTER_HYBRID_TRACE_BLOCK__(var_n)                                 \
-    if !consteval {                                                            \
-      static ::helix::std::Stacktrace::Location var_n{                         \
-          __FILE__, __HELIX_FUNCNAME__, (static_cast<uint32_t>(__LINE__))};    \
-      ::helix::std::Stacktrace::RegisterFrame _hx_cpp_scope(&var_n);           \
+    ::helix::std::Stacktrace::ScopeFrame<helix_trace_enabled> _hx_cpp_scope;   \
+    if constexpr (helix_trace_enabled) {                                       \
+      if !consteval {                                                          \
+        static constexpr ::helix::std::Stacktrace::Location var_n{             \
+            __FILE__, __HELIX_FUNCNAME__, static_cast<uint32_t>(__LINE__)};    \
+        _hx_cpp_scope.enter(&var_n);                                           \
+      }                                                                        \
     }
+#else
+#define __REGISTER_HYBRID_TRACE_BLOCK__(var_n)
+#endif
 
-#define MAX_STACK_FRAME_DEPTH 1024
+/// opts the enclosing function or namespace out of trace registration: write it before
+/// the `__REGISTER_*_TRACE_BLOCK__` line of a hot leaf function so it keeps no frame at all
+#define HELIX_NO_TRACE [[maybe_unused]] constexpr bool helix_trace_enabled = false
 
-// when getting back trace frames we also need to capture native frames
-// so we can get a complete picture of the call stack.
-FrameSummary *capture(int max_depth = MAX_STACK_FRAME_DEPTH);
+#define MAX_STACK_FRAME_DEPTH 256
 
-#ifdef _WIN32
+/// one frame of a capture before symbolization: the shadow frame's `Location` for Helix and
+/// hybrid frames, the return address for native ones
+struct RawFrame {
+    const void *addr;
+    FrameKind   kind;
+};
 
-inline FrameSummary *capture(int max_depth) {
-    static thread_local FrameSummary s_nodes[MAX_STACK_FRAME_DEPTH];
+/// the frames of one `capture()`: the Helix shadow frames innermost first, then the native
+/// return addresses from the innermost outwards. nothing here is symbolized; `resolve` does that
+/// on demand, so a thread that never panics pays for this buffer and nothing else.
+struct Snapshot {
+    static constexpr int capacity = MAX_STACK_FRAME_DEPTH;
 
-    auto clamp_limit = [](int v) -> int {
-        if (v <= 0)
-            return MAX_STACK_FRAME_DEPTH;
-        if (v > MAX_STACK_FRAME_DEPTH)
-            return MAX_STACK_FRAME_DEPTH;
-        return v;
+    RawFrame frames[capacity];
+    int      count = 0;
+};
+
+// when getting back trace frames we also need to capture native frames
+// so we can get a complete picture of the call stack.
+const Snapshot &capture(int max_depth = MAX_STACK_FRAME_DEPTH);
+
+/// symbolizes `snapshot` into the `FrameSummary` chain `backtrace` and the panic handler walk,
+/// starting at the outermost frame. the chain belongs to the calling thread and stays valid
+/// until its next `resolve`. native frames come from the process-wide `SymbolCache` with their
+/// names already demangled and stripped, so they print as they are.
+FrameSummary *resolve(const Snapshot &snapshot);
+
+namespace __internal {
+    /// the text of a native frame that was symbolized but could not be cached
+    struct NativeText {
+        char func[1024];
+        char file[1024];
     };
 
-    const int limit = clamp_limit(max_depth);
-    int       idx   = 0;
+    /// the storage behind `resolve`, allocated on a thread's first call and reused after that
+    struct Resolved {
+        libcxx::unique_ptr<FrameSummary[]> nodes;
+        libcxx::unique_ptr<Location[]>     native_locs;
+        libcxx::unique_ptr<NativeText[]>   native_text;
+        int                                node_cap   = 0;
+        int                                native_cap = 0;
+
+        void reserve(int node_count, int native_count) {
+            if (node_count > node_cap) {
+                nodes.reset(new FrameSummary[node_count]);
+                node_cap = node_count;
+            }
+            if (native_count > native_cap) {
+                native_locs.reset(new Location[native_count]);
+                native_text.reset(new NativeText[native_count]);
+                native_cap = native_count;
+            }
+        }
+    };
 
-    // Walk the thread-local Helix frame chain and snapshot into s_nodes.
-    // Preserve kind/loc and rebuild prev pointers to point into the snapshot.
-    for (const FrameSummary *cur = g_tls_helix_head; cur != nullptr && idx < limit;
-         cur                     = cur->prev) {
-        s_nodes[idx].loc  = cur->loc;
-        s_nodes[idx].kind = cur->kind;
-        s_nodes[idx].prev = (idx > 0) ? &s_nodes[idx - 1] : nullptr;
-        ++idx;
+    inline Resolved &resolved() {
+        static thread_local Resolved instance;
+        return instance;
     }
 
-    // If nothing captured, return nullptr (caller expects nullptr when empty).
-    if (idx == 0) {
-        return nullptr;
+    /// copies `src` into `dst`, truncating to `cap - 1` bytes
+    inline void copy_bounded(const char *src, char *dst, usize cap) noexcept {
+        usize len = 0;
+        while (src[len] != '\0' && len < cap - 1) {
+            ++len;
+        }
+        libcxx::memcpy(dst, src, len);
+        dst[len] = '\0';
     }
 
-    // Return pointer to the most-recently-captured frame (tail of our snapshot).
-    return &s_nodes[idx - 1];
-}
-
-#else
-
-inline FrameSummary *capture(int max_depth) {
-    static thread_local FrameSummary s_nodes[MAX_STACK_FRAME_DEPTH];
-    static thread_local Location     s_native_locs[MAX_STACK_FRAME_DEPTH];
-    static thread_local wchar_t      s_fn_bufs[MAX_STACK_FRAME_DEPTH][1024];
-    static thread_local wchar_t      s_file_bufs[MAX_STACK_FRAME_DEPTH][1024];
-
-    auto clamp_limit = [](int v) {
-        if (v <= 0) {
-            return MAX_STACK_FRAME_DEPTH;
+    inline int clamp_depth(int v) noexcept {
+        if (v <= 0 || v > Snapshot::capacity) {
+            return Snapshot::capacity;
         }
+        return v;
+    }
 
-        if (v > MAX_STACK_FRAME_DEPTH) {
-            return MAX_STACK_FRAME_DEPTH;
+    /// copies the shadow frame chain into `out` and returns the new count
+    inline int capture_helix(Snapshot &out, int limit) noexcept {
+        int idx = 0;
+        for (const FrameSummary *cur = g_tls_helix_head; cur != nullptr && idx < limit;
+             cur                     = cur->prev) {
+            out.frames[idx++] = {cur->loc, cur->kind};
         }
+        return idx;
+    }
 
-        return v;
-    };
+#ifndef _WIN32
+    /// fills `loc` with the demangled name of the native frame at `pc` and its source file and
+    /// line when the module has DWARF line info, or its module otherwise; false when the symbol
+    /// has no usable name
+    inline bool symbolize(void *pc, Location &loc, NativeText &text) {
+        const char *fn        = "???";
+        const char *file      = "???";
+        char       *demangled = nullptr;
+        char        module[1024];
 
-    auto copy_wstr = [](wchar_t *dst, size_t cap, const char *src) {
-        if (!dst || cap == 0) {
-            return;
+        Dl_info info{};
+        if (dladdr(pc, &info)) {
+            if (info.dli_sname && info.dli_sname[0] != '\0') {
+                int status = 0;
+                demangled  = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+                fn         = (status == 0 && demangled) ? demangled : info.dli_sname;
+            }
+            if (info.dli_fname && info.dli_fname[0] != '\0') {
+                file = info.dli_fname;
+            }
         }
 
-        if (!src) {
-            dst[0] = L'\0';
-            return;
+        if (file[0] == '?') {
+            // no module from dladdr: take the path backtrace_symbols prints before the '('
+            char **symbols = backtrace_symbols(&pc, 1);
+            if (symbols != nullptr && symbols[0] != nullptr) {
+                size_t len = 0;
+                while (symbols[0][len] && symbols[0][len] != ' ' && symbols[0][len] != '(' &&
+                       len < sizeof(module) - 1) {
+                    module[len] = symbols[0][len];
+                    ++len;
+                }
+                module[len] = '\0';
+                if (len != 0) {
+                    file = module;
+                }
+            }
+            ::free(symbols);
         }
 
-        mbstowcs(dst, src, cap - 1);
-        dst[cap - 1] = L'\0';
-    };
+        SourceLine source{};
+        if (!LineTables::instance().lookup(pc, source)) {
+            source = {file, 0};
+        }
 
-    const int limit = clamp_limit(max_depth);
-    int       idx   = 0;
+        copy_bounded(fn, text.func, sizeof(text.func));
+        copy_bounded(source.file, text.file, sizeof(text.file));
+        ::free(demangled);
 
-    for (const FrameSummary *cur = g_tls_helix_head; (cur != nullptr) && idx < limit;
-         cur                     = cur->prev) {
-        s_nodes[idx].loc  = cur->loc;
-        s_nodes[idx].kind = cur->kind;
-        s_nodes[idx].prev = (idx > 0) ? &s_nodes[idx - 1] : nullptr;
-        ++idx;
+        loc = {text.file, text.func, source.line};
+        return text.func[0] != '\0';
     }
 
-    const int space_left = limit - idx;
-    if (space_left <= 0) {
-        return (idx > 0) ? &s_nodes[idx - 1] : nullptr;
-    }
+    /// the display form of the native frame at `pc`: from the symbol cache when it has been seen
+    /// before, otherwise symbolized and cached, falling back to `text` when the pool is full.
+    /// false when the frame has no function name
+    inline bool describe_native(const void *pc, Symbol &out, NativeText &text) {
+        SymbolCache &cache = SymbolCache::instance();
+        if (cache.find(pc, out)) {
+            return true;
+        }
+
+        Location loc;
+        if (!symbolize(const_cast<void *>(pc), loc, text)) {
+            return false;
+        }
 
-    void *stack[MAX_STACK_FRAME_DEPTH];
-    int   to_capture = (space_left > MAX_STACK_FRAME_DEPTH) ? MAX_STACK_FRAME_DEPTH : space_left;
-    if (to_capture <= 0) {
-        return (idx > 0) ? &s_nodes[idx - 1] : nullptr;
+        const cstring display =
+            string_to_cstring(ABI::strip_helix_prefix(ABI::demangle_partial(loc.function_name())));
+        if (!cache.insert(pc, display.c_str(), loc.file, loc.line, out)) {
+            copy_bounded(display.c_str(), text.func, sizeof(text.func));
+            out = {text.func, text.file, loc.line};
+        }
+        return true;
     }
 
-    int captured = backtrace(stack, to_capture);
-    if (captured <= 0) {
-        return (idx > 0) ? &s_nodes[idx - 1] : nullptr;
+    /// drops cached symbols and line tables if a module was unloaded since the last call
+    inline void sync_modules() {
+        if (SymbolCache::instance().sync_modules()) {
+            LineTables::instance().clear();
+        }
     }
+#endif
+}  // namespace __internal
 
-    char **symbols = backtrace_symbols(stack, captured);
+#ifdef _WIN32
 
-    const int skip     = (captured > 2) ? 2 : 0;
-    int       native_i = 0;
+// only the Helix frame chain is recorded on Windows.
+inline const Snapshot &capture(int max_depth) {
+    static thread_local Snapshot s_snapshot;
 
-    for (int i = skip; i < captured && idx < limit && native_i < MAX_STACK_FRAME_DEPTH;
-         ++i, ++native_i) {
-        const char *fn   = "???";
-        const char *file = "???";
-        uint32_t    line = 0;
+    s_snapshot.count = __internal::capture_helix(s_snapshot, __internal::clamp_depth(max_depth));
+    return s_snapshot;
+}
 
-        Dl_info info{};
-        if (dladdr(stack[i], &info)) {
-            if (info.dli_sname && info.dli_sname[0] != '\0') {
-                int   status    = 0;
-                char *demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+#else
 
-                if (status == 0 && demangled) {
-                    fn = demangled;
-                } else {
-                    fn = info.dli_sname;
-                }
+inline const Snapshot &capture(int max_depth) {
+    static thread_local Snapshot s_snapshot;
 
-                if (fn == nullptr || fn[0] == '\0') {
-                    continue;
-                }
+    const int limit = __internal::clamp_depth(max_depth);
+    int       idx   = __internal::capture_helix(s_snapshot, limit);
 
-                ::free(demangled);
-            }
-            if (info.dli_fname && info.dli_fname[0] != '\0') {
-                file = info.dli_fname;
-            }
-        }
+    if (idx < limit) {
+        // the first two return addresses are this function and its caller
+        void     *stack[Snapshot::capacity + 2];
+        const int captured = ::backtrace(stack, limit - idx + 2);
 
-        if ((file == nullptr || file[0] == '\0' || libcxx::string(file) == "???") &&
-            (symbols != nullptr) && symbols[i]) {
-            const char *sym = symbols[i];
-            const char *p   = sym;
-            const char *end = sym;
+        for (int i = 2; i < captured && idx < limit; ++i) {
+            s_snapshot.frames[idx++] = {stack[i], FrameKind::Native};
+        }
+    }
 
-            while (*end && *end != ' ' && *end != '(') {
-                ++end;
-            }
+    s_snapshot.count = idx;
+    return s_snapshot;
+}
 
-            if (end > p) {
-                thread_local wchar_t tmp_path[1024];
-                size_t               len = static_cast<size_t>(end - p);
-                if (len >= (sizeof(tmp_path) / sizeof(wchar_t))) {
-                    len = (sizeof(tmp_path) / sizeof(wchar_t)) - 1;
-                }
+#endif  // POSIX/Linux
 
-                char narrow_buf[1024];
+inline FrameSummary *resolve(const Snapshot &snapshot) {
+    int native_count = 0;
+    for (int i = 0; i < snapshot.count; ++i) {
+        native_count += snapshot.frames[i].kind == FrameKind::Native ? 1 : 0;
+    }
 
-                if (len >= sizeof(narrow_buf)) {
-                    len = sizeof(narrow_buf) - 1;
-                }
+    __internal::Resolved &out = __internal::resolved();
+    out.reserve(snapshot.count, native_count);
 
-                for (size_t k = 0; k < len; ++k) {
-                    narrow_buf[k] = p[k];
-                }
+#ifndef _WIN32
+    if (native_count != 0) {
+        __internal::sync_modules();
+    }
+#endif
 
-                narrow_buf[len] = '\0';
+    int idx      = 0;
+    int native_i = 0;
+    for (int i = 0; i < snapshot.count; ++i) {
+        const RawFrame &raw = snapshot.frames[i];
+        const Location *loc = nullptr;
 
-                mbstowcs(tmp_path, narrow_buf, sizeof(tmp_path) / sizeof(wchar_t));
-                tmp_path[(sizeof(tmp_path) / sizeof(wchar_t)) - 1] = L'\0';
-                file                                               = narrow_buf;
+        if (raw.kind != FrameKind::Native) {
+            loc = static_cast<const Location *>(raw.addr);
+        } else {
+#ifndef _WIN32
+            Location               &native = out.native_locs[native_i];
+            __internal::NativeText &text   = out.native_text[native_i];
 
-                copy_wstr(
-                    s_file_bufs[native_i], sizeof(s_file_bufs[0]) / sizeof(wchar_t), narrow_buf);
+            __internal::Symbol sym{};
+            if (!__internal::describe_native(raw.addr, sym, text)) {
+                continue;  // skip frames without a function name
             }
-        }
-
-        copy_wstr(s_fn_bufs[native_i], sizeof(s_fn_bufs[0]) / sizeof(wchar_t), fn);
-        copy_wstr(s_file_bufs[native_i], sizeof(s_file_bufs[0]) / sizeof(wchar_t), file);
 
-        if (s_fn_bufs[native_i] == nullptr || s_fn_bufs[native_i][0] == L'\0') {
-            // skip empty function names
-            --native_i;
-            continue;
+            native = {sym.file, sym.func, sym.line};
+            loc    = &native;
+            ++native_i;
+#endif
         }
 
-        s_native_locs[native_i].func = s_fn_bufs[native_i];
-        s_native_locs[native_i].file = s_file_bufs[native_i];
-        s_native_locs[native_i].line = line;
-
-        s_nodes[idx].loc  = &s_native_locs[native_i];
-        s_nodes[idx].kind = FrameKind::Native;
-        s_nodes[idx].prev = (idx > 0) ? &s_nodes[idx - 1] : nullptr;
+        out.nodes[idx].loc  = loc;
+        out.nodes[idx].kind = raw.kind;
+        out.nodes[idx].prev = (idx > 0) ? &out.nodes[idx - 1] : nullptr;
         ++idx;
     }
 
-    if (symbols != nullptr) {
-        ::free(symbols);
-    }
-
-    return (idx > 0) ? &s_nodes[idx - 1] : nullptr;
+    return (idx > 0) ? &out.nodes[idx - 1] : nullptr;
 }
 
-#endif  // POSIX/Linux
-
-inline void backtrace(const FrameSummary *cur = capture()) {
+inline void backtrace(const FrameSummary *cur = resolve(capture())) {
     int idx = 0;
 
+    // native names come out of `resolve` ready to print
+    auto display_name = [](const FrameSummary *frame) -> string {
+        if (frame->kind == FrameKind::Native) {
+            return frame->loc->function_name();
+        }
+        return std::ABI::strip_helix_prefix(
+            std::ABI::demangle_partial(frame->loc->function_name()));
+    };
+
     while (cur != nullptr && idx < MAX_STACK_FRAME_DEPTH) {
         if (cur->loc != nullptr) {
-            if (cur->loc->file && cur->loc->func && cur->loc->line != 0) {
-                std::print(std::stringf(
-                    L"\x1b[31m{}\x1b[0m (\x1b[33m{}:{})",
-                    std::ABI::strip_helix_prefix(std::ABI::demangle_partial(cur->loc->func)),
-                    cur->loc->file,
-                    cur->loc->line));
-            } else if (cur->loc->file && cur->loc->func) {
-                std::print(std::stringf(
-                    L"\x1b[31m{}\x1b[0m (\x1b[33m{}\x1b[0m)",
-                    std::ABI::strip_helix_prefix(std::ABI::demangle_partial(cur->loc->func)),
-                    cur->loc->file));
-            } else if (cur->loc->func) {
-                std::print(std::stringf(L"\x1b[31m{}\x1b[0m", cur->loc->func));
+            if (cur->loc->file[0] && cur->loc->func[0] && cur->loc->line != 0) {
+                std::print(std::stringf(L"\x1b[31m{}\x1b[0m (\x1b[33m{}:{})",
+                                        display_name(cur),
+                                        cur->loc->file_name(),
+                                        cur->loc->line));
+            } else if (cur->loc->file[0] && cur->loc->func[0]) {
+                std::print(std::stringf(L"\x1b[31m{}\x1b[0m (\x1b[33m{}\x1b[0m)",
+                                        display_name(cur),
+                                        cur->loc->file_name()));
+            } else if (cur->loc->func[0]) {
+                std::print(std::stringf(L"\x1b[31m{}\x1b[0m", cur->loc->function_name()));
             } else {
                 std::print(L"<unknown>");
             }
@@ -0,0 +1,243 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///-------------------------------------------------------------------------------- Lib-Helix ---///
+
+#ifndef _$_HX_CORE_M12SYMBOL_CACHE
+#define _$_HX_CORE_M12SYMBOL_CACHE
+
+#include <include/config/config.hh>
+
+#include <include/c++/libc++.hh>
+#include <include/types/builtins/primitives.hh>
+
+#ifndef _WIN32
+#ifdef __APPLE__
+#include <mach-o/dyld.h>
+#else
+#include <link.h>
+#endif
+#endif
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+namespace Stacktrace::__internal {
+/// a native frame in the form the trace prints it; the strings are interned by the cache and
+/// live for the rest of the process
+struct Symbol {
+    const char *func;
+    const char *file;
+    uint32_t    line;
+};
+
+/// the process-wide address -> `Symbol` cache behind `resolve`.
+///
+/// a fixed open-addressed table: lookups never lock, they read a slot under its sequence counter
+/// and retry the probe if a writer was in the middle of it. inserts and interning take one mutex,
+/// which is fine since they only happen the first time an address is seen. a `dlclose` bumps the
+/// generation, which turns every older slot into a miss, so an address reused by a newly loaded
+/// module is never given the old name. names are stored once in their display form and never
+/// freed (a trace may still point at them); when the pool reaches its cap nothing new is cached
+/// and `resolve` symbolizes into its own buffers instead.
+class SymbolCache {
+  public:
+    static constexpr usize slot_count     = 4096;
+    static constexpr usize probe_limit    = 8;
+    static constexpr usize max_pool_chars = usize(1) << 20;
+
+    static SymbolCache &instance() noexcept {
+        static SymbolCache cache;
+        return cache;
+    }
+
+    /// lock-free: true and `out` filled when `pc` has a live entry
+    bool find(const void *pc, Symbol &out) const noexcept {
+        const u64 generation = current.load(libcxx::memory_order_acquire);
+        const usize home     = hash(pc);
+
+        for (usize probe = 0; probe < probe_limit; ++probe) {
+            const Slot &slot = slots[(home + probe) & (slot_count - 1)];
+
+            const u32 before = slot.seq.load(libcxx::memory_order_acquire);
+            if ((before & 1) != 0) {
+                continue;  // a writer owns it; treat as a miss for this slot
+            }
+            const void *key  = slot.pc.load(libcxx::memory_order_relaxed);
+            const u64   gen  = slot.generation.load(libcxx::memory_order_relaxed);
+            const Symbol sym = {slot.func.load(libcxx::memory_order_relaxed),
+                                slot.file.load(libcxx::memory_order_relaxed),
+                                slot.line.load(libcxx::memory_order_relaxed)};
+            libcxx::atomic_thread_fence(libcxx::memory_order_acquire);
+            if (slot.seq.load(libcxx::memory_order_relaxed) != before) {
+                continue;
+            }
+
+            if (key == nullptr) {
+                return false;  // an empty slot ends the probe sequence
+            }
+            if (key == pc && gen == generation) {
+                out = sym;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// interns `func` and `file`, publishes them for `pc` and returns the cached form in `out`;
+    /// false when the pool is full or interning runs out of memory, since this runs while a
+    /// panic is being rendered and the caller then keeps its uncached copy
+    bool insert(const void *pc,
+                const char *func,
+                const char *file,
+                uint32_t    line,
+                Symbol     &out) noexcept {
+        libcxx::lock_guard<libcxx::mutex> guard(lock);
+
+        const char *ifunc = nullptr;
+        const char *ifile = nullptr;
+        try {
+            ifunc = intern(func);
+            ifile = intern(file);
+        } catch (...) {
+            return false;
+        }
+        if (ifunc == nullptr || ifile == nullptr) {
+            return false;
+        }
+
+        const u64   generation = current.load(libcxx::memory_order_relaxed);
+        const usize home       = hash(pc);
+        Slot       *target     = &slots[home & (slot_count - 1)];  // evicted if all are live
+        for (usize probe = 0; probe < probe_limit; ++probe) {
+            Slot       &slot = slots[(home + probe) & (slot_count - 1)];
+            const void *key  = slot.pc.load(libcxx::memory_order_relaxed);
+            if (key == nullptr || key == pc ||
+                slot.generation.load(libcxx::memory_order_relaxed) != generation) {
+                target = &slot;
+                break;
+            }
+        }
+
+        const u32 seq = target->seq.load(libcxx::memory_order_relaxed);
+        target->seq.store(seq + 1, libcxx::memory_order_relaxed);
+        libcxx::atomic_thread_fence(libcxx::memory_order_release);
+        target->pc.store(pc, libcxx::memory_order_relaxed);
+        target->generation.store(generation, libcxx::memory_order_relaxed);
+        target->func.store(ifunc, libcxx::memory_order_relaxed);
+        target->file.store(ifile, libcxx::memory_order_relaxed);
+        target->line.store(line, libcxx::memory_order_relaxed);
+        target->seq.store(seq + 2, libcxx::memory_order_release);
+
+        out = {ifunc, ifile, line};
+        return true;
+    }
+
+    /// drops every entry if a module was unloaded since the last call and says whether it did;
+    /// cheap when none was
+    bool sync_modules() noexcept {
+#if defined(_WIN32)
+        return false;
+#elif defined(__APPLE__)
+        static const bool registered = [] {
+            _dyld_register_func_for_remove_image(
+                [](const struct mach_header *, intptr_t) { instance().invalidate(); });
+            return true;
+        }();
+        (void)registered;
+        return false;  // the callback has already invalidated
+#else
+        u64 subs = 0;
+        dl_iterate_phdr(
+            [](struct dl_phdr_info *info, size_t size, void *data) -> int {
+                if (size >= offsetof(struct dl_phdr_info, dlpi_subs) + sizeof(info->dlpi_subs)) {
+                    *static_cast<u64 *>(data) = info->dlpi_subs;
+                }
+                return 1;  // the counters are global, the first module is enough
+            },
+            &subs);
+
+        if (unloads.exchange(subs, libcxx::memory_order_relaxed) != subs) {
+            invalidate();
+            return true;
+        }
+        return false;
+#endif
+    }
+
+    void invalidate() noexcept { current.fetch_add(1, libcxx::memory_order_release); }
+
+  private:
+    struct Slot {
+        libcxx::atomic<u32>             seq{0};
+        libcxx::atomic<uint32_t>        line{0};
+        libcxx::atomic<const void *>    pc{nullptr};
+        libcxx::atomic<u64>             generation{0};
+        libcxx::atomic<const char *>    func{nullptr};
+        libcxx::atomic<const char *>    file{nullptr};
+    };
+
+    SymbolCache() = default;
+
+    static usize hash(const void *pc) noexcept {
+        const u64 x = reinterpret_cast<uintptr_t>(pc) * 0x9E3779B97F4A7C15ULL;
+        return static_cast<usize>(x >> 32);
+    }
+
+    /// the pooled copy of `str`, or nullptr when the pool is full; called with `lock` held
+    const char *intern(const char *str) {
+        const libcxx::string_view view(str);
+        if (auto it = names.find(view); it != names.end()) {
+            return it->data();
+        }
+        if (pooled + view.size() + 1 > max_pool_chars) {
+            return nullptr;
+        }
+
+        constexpr usize chunk_chars = 16384;
+        if (chunks.empty() || chunk_used + view.size() + 1 > chunk_size) {
+            // nothing changes until both allocations succeed, so a throw leaves the pool usable
+            const usize size = view.size() + 1 > chunk_chars ? view.size() + 1 : chunk_chars;
+            libcxx::unique_ptr<char[]> chunk(new char[size]);
+            chunks.push_back(libcxx::move(chunk));
+            chunk_size = size;
+            chunk_used = 0;
+        }
+
+        char *copy = chunks.back().get() + chunk_used;
+        libcxx::memcpy(copy, view.data(), view.size());
+        copy[view.size()] = '\0';
+        chunk_used += view.size() + 1;
+        pooled += view.size() + 1;
+
+        names.emplace(copy, view.size());
+        return copy;
+    }
+
+    Slot                slots[slot_count];
+    libcxx::atomic<u64> current{1};
+    libcxx::atomic<u64> unloads{0};
+
+    libcxx::mutex                                    lock;
+    libcxx::unordered_set<libcxx::string_view>       names;
+    libcxx::vector<libcxx::unique_ptr<char[]>>       chunks;
+    usize                                            chunk_size = 0;
+    usize                                            chunk_used = 0;
+    usize                                            pooled     = 0;
+};
+}  // namespace Stacktrace::__internal
+
+H_STD_NAMESPACE_END
+H_NAMESPACE_END
+
+#endif  // _$_HX_CORE_M12SYMBOL_CACHE
@@ -0,0 +1,648 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///-------------------------------------------------------------------------------- Lib-Helix ---///
+
+#ifndef _$_HX_CORE_M8PROFILER
+#define _$_HX_CORE_M8PROFILER
+
+#include <include/config/config.hh>
+
+#include <include/c++/libc++.hh>
+#include <include/runtime/__panic/stacktrace.hh>
+#include <include/types/types.hh>
+
+#ifndef _WIN32
+#include <signal.h>
+#include <sys/time.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+#endif
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+/// a sampling profiler over the `RegisterFrame` shadow stack.
+///
+/// each attached thread gets a CPU-time timer (`timer_create` on Linux, one process-wide
+/// `ITIMER_PROF` elsewhere) whose `SIGPROF` handler copies the thread's Helix frame chain, and
+/// optionally a few leaf native return addresses, into that thread's ring. with the default
+/// `native_depth` of 0 the handler only reads the chain and writes the ring, so it is
+/// async-signal-safe. native frames come from `backtrace`, which is not: the unwinder can take
+/// the loader's lock, and a sample landing while the thread holds it (in `dlopen`, or while
+/// unwinding an exception) deadlocks. only ask for them when that risk is acceptable, as in a
+/// profiling build of a program that loads no libraries once it runs. a background thread
+/// drains the rings and folds the samples into per-call-path counts, which export as collapsed
+/// stacks for flamegraphs or as an uncompressed `profile.proto` that `pprof` reads directly.
+/// names are only resolved at export. not available on Windows, where `start` returns false.
+namespace Profiler {
+struct Options {
+    u32 frequency    = 99;  // samples per second of thread CPU time
+    u32 native_depth = 0;   // leaf native frames under the innermost Helix frame; not signal-safe
+};
+
+struct Stats {
+    u64 samples;
+    u64 dropped;  // samples lost to a full ring
+};
+
+namespace __internal {
+    inline constexpr usize max_helix     = 48;
+    inline constexpr usize max_native    = 16;
+    inline constexpr usize ring_capacity = 256;
+
+    /// one sample: `helix` `Location` pointers innermost first, then `native` return addresses
+    /// innermost first
+    struct Sample {
+        u16         helix;
+        u16         native;
+        const void *frames[max_helix + max_native];
+    };
+
+    /// filled by its thread's signal handler, emptied by the aggregator
+    struct Ring {
+        Sample               slots[ring_capacity];
+        libcxx::atomic<u64>  head{0};
+        libcxx::atomic<u64>  tail{0};
+        libcxx::atomic<u64>  dropped{0};
+        libcxx::atomic<u32>  native_depth{0};
+        libcxx::atomic<bool> retired{false};  // its thread detached; freed once drained
+#ifdef __linux__
+        timer_t timer{};
+        bool    armed = false;
+#endif
+    };
+
+    HELIX_TLS_INITIAL_EXEC inline thread_local constinit Ring *t_ring = nullptr;
+
+    /// a folded call path: frames outermost first, the first `helix` of them `Location`s
+    struct Path {
+        libcxx::vector<const void *> frames;
+        u16                          helix = 0;
+
+        bool operator==(const Path &other) const noexcept {
+            return helix == other.helix && frames == other.frames;
+        }
+    };
+
+    struct PathHash {
+        usize operator()(const Path &path) const noexcept {
+            u64 h = 0xCBF29CE484222325ULL ^ path.helix;
+            for (const void *frame : path.frames) {
+                h = (h ^ reinterpret_cast<uintptr_t>(frame)) * 0x100000001B3ULL;
+            }
+            return static_cast<usize>(h);
+        }
+    };
+
+    struct State {
+        libcxx::mutex                                     lock;
+        libcxx::condition_variable                        wake;
+        libcxx::thread                                    aggregator;
+        libcxx::vector<libcxx::unique_ptr<Ring>>          rings;
+        libcxx::unordered_map<Path, u64, PathHash>        counts;
+        Options                                           options;
+        bool                                              running = false;
+        u64                                               samples = 0;
+        u64                                               dropped = 0;
+        libcxx::chrono::system_clock::time_point          started;
+        libcxx::chrono::steady_clock::duration            elapsed{};
+        libcxx::chrono::steady_clock::time_point          resumed;
+    };
+
+    inline State &state() {
+        static State instance;
+        return instance;
+    }
+
+#ifndef _WIN32
+    inline void on_sample(int, siginfo_t *, void *) {
+        const int saved = errno;
+        Ring     *ring  = t_ring;
+
+        if (ring != nullptr) {
+            const u64 head = ring->head.load(libcxx::memory_order_relaxed);
+            if (head - ring->tail.load(libcxx::memory_order_acquire) >= ring_capacity) {
+                ring->dropped.fetch_add(1, libcxx::memory_order_relaxed);
+            } else {
+                Sample &sample = ring->slots[head & (ring_capacity - 1)];
+
+                u16 helix = 0;
+                for (const Stacktrace::FrameSummary *frame = Stacktrace::g_tls_helix_head;
+                     frame != nullptr && helix < max_helix;
+                     frame = frame->prev) {
+                    if (frame->loc != nullptr) {
+                        sample.frames[helix++] = frame->loc;
+                    }
+                }
+
+                u16       native = 0;
+                const u32 depth  = ring->native_depth.load(libcxx::memory_order_relaxed);
+                if (depth != 0) {
+                    // the first two are this handler and the signal trampoline; `attach` has
+                    // already run the unwinder once, so nothing is loaded from in here
+                    void     *pcs[max_native + 2];
+                    const int got = ::backtrace(pcs, static_cast<int>(depth) + 2);
+                    for (int i = 2; i < got; ++i) {
+                        sample.frames[helix + native++] = pcs[i];
+                    }
+                }
+
+                sample.helix  = helix;
+                sample.native = native;
+                ring->head.store(head + 1, libcxx::memory_order_release);
+            }
+        }
+
+        errno = saved;
+    }
+#endif
+
+    /// folds every pending sample into `counts`; called with the lock held
+    inline void drain(State &s) {
+        for (usize i = 0; i < s.rings.size();) {
+            Ring     &ring = *s.rings[i];
+            const u64 head = ring.head.load(libcxx::memory_order_acquire);
+            u64       tail = ring.tail.load(libcxx::memory_order_relaxed);
+
+            for (; tail != head; ++tail) {
+                const Sample &sample = ring.slots[tail & (ring_capacity - 1)];
+                const usize   total  = sample.helix + sample.native;
+
+                Path path;
+                path.helix = sample.helix;
+                path.frames.reserve(total);
+                for (usize f = sample.helix; f-- > 0;) {
+                    path.frames.push_back(sample.frames[f]);
+                }
+                for (usize f = total; f-- > sample.helix;) {
+                    path.frames.push_back(sample.frames[f]);
+                }
+
+                ++s.counts[libcxx::move(path)];
+                ++s.samples;
+            }
+            ring.tail.store(tail, libcxx::memory_order_release);
+            s.dropped += ring.dropped.exchange(0, libcxx::memory_order_relaxed);
+
+            if (ring.retired.load(libcxx::memory_order_acquire)) {
+                s.rings.erase(s.rings.begin() + static_cast<libcxx::ptrdiff_t>(i));
+            } else {
+                ++i;
+            }
+        }
+    }
+
+    inline void aggregate() {
+        State                        &s = state();
+        libcxx::unique_lock<libcxx::mutex> guard(s.lock);
+        while (s.running) {
+            s.wake.wait_for(guard, libcxx::chrono::milliseconds(100));
+            drain(s);
+        }
+    }
+
+    inline long period_nanos(const Options &options) {
+        return 1000000000L / static_cast<long>(options.frequency != 0 ? options.frequency : 1);
+    }
+
+    /// starts or stops `ring`'s own CPU-time timer; called with the lock held
+    inline bool arm(Ring &ring, const Options &options) {
+#ifdef __linux__
+        if (!ring.armed) {
+            sigevent event{};
+            event.sigev_notify = SIGEV_THREAD_ID;
+            event.sigev_signo  = SIGPROF;
+#ifdef sigev_notify_thread_id
+            event.sigev_notify_thread_id = static_cast<pid_t>(::syscall(SYS_gettid));
+#else
+            event._sigev_un._tid = static_cast<pid_t>(::syscall(SYS_gettid));
+#endif
+            if (::timer_create(CLOCK_THREAD_CPUTIME_ID, &event, &ring.timer) != 0) {
+                return false;
+            }
+            ring.armed = true;
+        }
+
+        const long   period = period_nanos(options);
+        itimerspec   spec{};
+        spec.it_interval.tv_sec  = period / 1000000000L;
+        spec.it_interval.tv_nsec = period % 1000000000L;
+        spec.it_value            = spec.it_interval;
+        return ::timer_settime(ring.timer, 0, &spec, nullptr) == 0;
+#else
+        (void)ring;
+        (void)options;
+        return true;  // the process-wide timer set by `start` covers every thread
+#endif
+    }
+
+    inline void disarm(Ring &ring) {
+#ifdef __linux__
+        if (ring.armed) {
+            ::timer_delete(ring.timer);
+            ring.armed = false;
+        }
+#else
+        (void)ring;
+#endif
+    }
+
+    void detach_locked();
+
+    /// detaches a thread that exits while still attached
+    struct ExitGuard {
+        ~ExitGuard() {
+            if (t_ring != nullptr) {
+                State                            &s = state();
+                libcxx::lock_guard<libcxx::mutex> guard(s.lock);
+                detach_locked();
+            }
+        }
+    };
+
+    /// unlinks and retires the calling thread's ring; called with the lock held
+    inline void detach_locked() {
+        Ring *ring = t_ring;
+        if (ring == nullptr) {
+            return;
+        }
+        t_ring = nullptr;
+        libcxx::atomic_signal_fence(libcxx::memory_order_seq_cst);
+        disarm(*ring);
+        ring->retired.store(true, libcxx::memory_order_release);
+    }
+
+    /// the display name, file and line of a frame on a folded path
+    struct Frame {
+        cstring  name;
+        cstring  file;
+        uint32_t line    = 0;
+        u64      address = 0;
+    };
+
+    inline Frame describe(const void *frame, bool helix) {
+        if (helix) {
+            const auto *loc = static_cast<const Stacktrace::Location *>(frame);
+            return {string_to_cstring(
+                        ABI::strip_helix_prefix(ABI::demangle_partial(loc->function_name()))),
+                    loc->file,
+                    loc->line,
+                    0};
+        }
+#ifndef _WIN32
+        Stacktrace::__internal::Symbol     symbol{};
+        Stacktrace::__internal::NativeText text;
+        if (Stacktrace::__internal::describe_native(frame, symbol, text)) {
+            return {symbol.func, symbol.file, symbol.line, reinterpret_cast<uintptr_t>(frame)};
+        }
+#endif
+        char unknown[2 + sizeof(void *) * 2 + 1];
+        libcxx::snprintf(unknown, sizeof(unknown), "%p", frame);
+        return {unknown, "", 0, reinterpret_cast<uintptr_t>(frame)};
+    }
+
+    /// every distinct frame of `counts` described once
+    inline libcxx::unordered_map<const void *, Frame> describe_all(const State &s) {
+#ifndef _WIN32
+        Stacktrace::__internal::sync_modules();
+#endif
+        libcxx::unordered_map<const void *, Frame> frames;
+        for (const auto &[path, count] : s.counts) {
+            for (usize i = 0; i < path.frames.size(); ++i) {
+                if (frames.find(path.frames[i]) == frames.end()) {
+                    frames.emplace(path.frames[i], describe(path.frames[i], i < path.helix));
+                }
+            }
+        }
+        return frames;
+    }
+
+    /// just enough of the protobuf wire format to write a `perftools.profiles.Profile`
+    struct Proto {
+        cstring out;
+
+        void varint(u64 v) {
+            while (v >= 0x80) {
+                out.push_back(static_cast<char>(v | 0x80));
+                v >>= 7;
+            }
+            out.push_back(static_cast<char>(v));
+        }
+        void number(u32 field, u64 v) {
+            varint(static_cast<u64>(field) << 3);
+            varint(v);
+        }
+        void bytes(u32 field, libcxx::string_view v) {
+            varint((static_cast<u64>(field) << 3) | 2);
+            varint(v.size());
+            out.append(v);
+        }
+        void packed(u32 field, const libcxx::vector<u64> &values) {
+            Proto body;
+            for (u64 v : values) {
+                body.varint(v);
+            }
+            bytes(field, body.out);
+        }
+    };
+}  // namespace __internal
+
+bool attach();
+
+/// installs the `SIGPROF` handler, starts the aggregator and attaches the calling thread; other
+/// threads call `attach` themselves. false when profiling is unavailable or already running
+inline bool start(Options options = {}) {
+#ifdef _WIN32
+    (void)options;
+    return false;
+#else
+    using namespace __internal;
+    State &s = state();
+    {
+        libcxx::lock_guard<libcxx::mutex> guard(s.lock);
+        if (s.running) {
+            return false;
+        }
+
+        struct sigaction action{};
+        action.sa_sigaction = on_sample;
+        action.sa_flags     = SA_SIGINFO | SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        if (::sigaction(SIGPROF, &action, nullptr) != 0) {
+            return false;
+        }
+
+#ifndef __linux__
+        const long period = period_nanos(options);
+        itimerval timer{};
+        timer.it_interval.tv_sec  = period / 1000000000L;
+        timer.it_interval.tv_usec = (period % 1000000000L) / 1000;
+        timer.it_value            = timer.it_interval;
+        if (::setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+            return false;
+        }
+#endif
+
+        s.options = options;
+        if (s.options.native_depth > max_native) {
+            s.options.native_depth = max_native;
+        }
+        if (s.counts.empty()) {
+            s.started = libcxx::chrono::system_clock::now();
+        }
+        s.resumed    = libcxx::chrono::steady_clock::now();
+        s.running    = true;
+        s.aggregator = libcxx::thread(aggregate);
+    }
+    return attach();
+#endif
+}
+
+/// starts sampling the calling thread; it stays attached until `detach`, `stop` or its exit
+inline bool attach() {
+#ifdef _WIN32
+    return false;
+#else
+    using namespace __internal;
+    State &s = state();
+
+    libcxx::lock_guard<libcxx::mutex> guard(s.lock);
+    if (!s.running) {
+        return false;
+    }
+
+    if (s.options.native_depth != 0) {
+        void *warm[1];
+        ::backtrace(warm, 1);  // loads the unwinder here rather than in the signal handler
+    }
+
+    Ring *ring = t_ring;
+    if (ring == nullptr) {
+        s.rings.push_back(libcxx::make_unique<Ring>());
+        ring = s.rings.back().get();
+        static thread_local ExitGuard exit_guard;
+        (void)exit_guard;
+    }
+    ring->native_depth.store(s.options.native_depth, libcxx::memory_order_relaxed);
+    libcxx::atomic_signal_fence(libcxx::memory_order_seq_cst);
+    t_ring = ring;
+
+    if (!arm(*ring, s.options)) {
+        detach_locked();
+        return false;
+    }
+    return true;
+#endif
+}
+
+/// stops sampling the calling thread
+inline void detach() {
+    __internal::State                &s = __internal::state();
+    libcxx::lock_guard<libcxx::mutex> guard(s.lock);
+    __internal::detach_locked();
+}
+
+/// stops every thread's timer and the aggregator and folds what is left; the counts are kept
+/// until `reset`, and a later `start` adds to them
+inline void stop() {
+#ifndef _WIN32
+    using namespace __internal;
+    State &s = state();
+    {
+        libcxx::lock_guard<libcxx::mutex> guard(s.lock);
+        if (!s.running) {
+            return;
+        }
+        detach_locked();
+
+#ifndef __linux__
+        itimerval off{};
+        ::setitimer(ITIMER_PROF, &off, nullptr);
+#endif
+        // other threads keep their rings, so a later `attach` reuses them
+        for (auto &ring : s.rings) {
+            disarm(*ring);
+        }
+        s.running = false;
+        s.elapsed += libcxx::chrono::steady_clock::now() - s.resumed;
+    }
+    s.wake.notify_all();
+    s.aggregator.join();
+
+    libcxx::lock_guard<libcxx::mutex> guard(s.lock);
+    drain(s);
+#endif
+}
+
+/// forgets every folded sample
+inline void reset() {
+    __internal::State                &s = __internal::state();
+    libcxx::lock_guard<libcxx::mutex> guard(s.lock);
+    __internal::drain(s);
+    s.counts.clear();
+    s.samples = 0;
+    s.dropped = 0;
+    s.elapsed = {};
+    s.started = libcxx::chrono::system_clock::now();
+    s.resumed = libcxx::chrono::steady_clock::now();
+}
+
+inline Stats stats() {
+    __internal::State                &s = __internal::state();
+    libcxx::lock_guard<libcxx::mutex> guard(s.lock);
+    __internal::drain(s);
+    return {s.samples, s.dropped};
+}
+
+/// the profile in collapsed-stack form, one `outer;...;leaf count` line per call path, as
+/// `flamegraph.pl` and speedscope read it
+inline cstring collapsed() {
+    __internal::State                &s = __internal::state();
+    libcxx::lock_guard<libcxx::mutex> guard(s.lock);
+    __internal::drain(s);
+
+    // distinct frames can share a name (two unnamed native frames), so lines fold by text
+    const auto                frames = __internal::describe_all(s);
+    libcxx::map<cstring, u64> lines;
+    for (const auto &[path, count] : s.counts) {
+        cstring line = path.frames.empty() ? cstring("[untraced]") : cstring();
+        for (usize i = 0; i < path.frames.size(); ++i) {
+            if (i != 0) {
+                line += ';';
+            }
+            for (char c : frames.at(path.frames[i]).name) {
+                line += (c == ';' || c == '\n') ? ' ' : c;
+            }
+        }
+        lines[libcxx::move(line)] += count;
+    }
+
+    cstring out;
+    for (const auto &[line, count] : lines) {
+        out += line;
+        out += ' ';
+        out += libcxx::to_string(count);
+        out += '\n';
+    }
+    return out;
+}
+
+/// the profile as a serialized, uncompressed `perftools.profiles.Profile`; `pprof` accepts it
+/// as is, or after gzip
+inline cstring pprof() {
+    using namespace __internal;
+    State                            &s = state();
+    libcxx::lock_guard<libcxx::mutex> guard(s.lock);
+    drain(s);
+
+    const auto frames = describe_all(s);
+
+    libcxx::vector<cstring>                  strings{""};
+    libcxx::unordered_map<cstring, u64>      string_ids{{"", 0}};
+    auto                                     intern = [&](const cstring &str) -> u64 {
+        auto [it, added] = string_ids.try_emplace(str, strings.size());
+        if (added) {
+            strings.push_back(str);
+        }
+        return it->second;
+    };
+
+    Proto profile;
+    auto  value_type = [&](u32 field, const char *type, const char *unit) {
+        Proto vt;
+        vt.number(1, intern(type));
+        vt.number(2, intern(unit));
+        profile.bytes(field, vt.out);
+    };
+    value_type(1, "samples", "count");
+    value_type(1, "cpu", "nanoseconds");
+
+    const u64 period = static_cast<u64>(period_nanos(s.options));
+
+    libcxx::unordered_map<const void *, u64> location_ids;
+    libcxx::unordered_map<cstring, u64>      function_ids;
+    Proto                                    tables;
+
+    for (const auto &[path, count] : s.counts) {
+        libcxx::vector<u64> locations;
+        locations.reserve(path.frames.size());
+        for (usize i = path.frames.size(); i-- > 0;) {  // leaf first
+            auto [loc, added] = location_ids.try_emplace(path.frames[i], location_ids.size() + 1);
+            if (added) {
+                const Frame &frame = frames.at(path.frames[i]);
+
+                auto [fn, fn_added] = function_ids.try_emplace(frame.name + '\0' + frame.file,
+                                                               function_ids.size() + 1);
+                if (fn_added) {
+                    Proto function;
+                    function.number(1, fn->second);
+                    function.number(2, intern(frame.name));
+                    function.number(3, intern(frame.name));
+                    function.number(4, intern(frame.file));
+                    tables.bytes(5, function.out);
+                }
+
+                Proto line;
+                line.number(1, fn->second);
+                line.number(2, frame.line);
+
+                Proto location;
+                location.number(1, loc->second);
+                if (frame.address != 0) {
+                    location.number(3, frame.address);
+                }
+                location.bytes(4, line.out);
+                tables.bytes(4, location.out);
+            }
+            locations.push_back(loc->second);
+        }
+
+        Proto sample;
+        sample.packed(1, locations);
+        sample.packed(2, {count, count * period});
+        profile.bytes(2, sample.out);
+    }
+
+    profile.out += tables.out;
+
+    const auto running = s.running ? libcxx::chrono::steady_clock::now() - s.resumed
+                                   : libcxx::chrono::steady_clock::duration{};
+    profile.number(9,
+                   static_cast<u64>(libcxx::chrono::duration_cast<libcxx::chrono::nanoseconds>(
+                                        s.started.time_since_epoch())
+                                        .count()));
+    profile.number(10,
+                   static_cast<u64>(libcxx::chrono::duration_cast<libcxx::chrono::nanoseconds>(
+                                        s.elapsed + running)
+                                        .count()));
+    Proto period_type;
+    period_type.number(1, intern("cpu"));
+    period_type.number(2, intern("nanoseconds"));
+    profile.bytes(11, period_type.out);
+    profile.number(12, period);
+
+    for (const cstring &str : strings) {
+        profile.bytes(6, str);
+    }
+    return profile.out;
+}
+}  // namespace Profiler
+
+H_STD_NAMESPACE_END
+H_NAMESPACE_END
+
+#endif  // _$_HX_CORE_M8PROFILER
@@ -19,7 +19,10 @@
 #include <include/runtime/__casting/as_cast.hh>
 #include <include/runtime/__panic/panic.hh>
 #include <include/runtime/__panic/stacktrace.hh>
+#include <include/runtime/__panic/crash.hh>
+#include <include/runtime/__profile/profiler.hh>
 #include <include/runtime/__memory/memory.hh>
+#include <include/runtime/__hash/hash.hh>
 #include <include/runtime/__io/io.hh>
 #include <include/runtime/__generator/generator.hh>
 #include <include/runtime/__finally/finally.hh>
@@ -29,22 +29,37 @@ H_STD_NAMESPACE_BEGIN
 namespace Panic {
 
 template <typename T>
-inline Frame::Frame(T obj, const char *filename, usize lineno)
-    : _file(filename)
-    , _line(lineno) {
+inline Frame::Frame(T obj, const char *filename, usize lineno) {
     initialize<T>(&obj);
+    if (FrameContext::Origin *origin = context.origin(); origin != nullptr) {
+        origin->file = (filename != nullptr) ? filename : "";
+        origin->line = lineno;
+    }
 }
 
 template <typename T>
-inline Frame::Frame(T obj, string filename, usize lineno)
-    : _file(std::Memory::move(filename))
-    , _line(lineno) {
+inline Frame::Frame(T obj, string filename, usize lineno) {
     initialize<T>(&obj);
+    if (FrameContext::Origin *origin = context.origin(); origin != nullptr) {
+        origin->owned_file = std::Memory::move(filename);
+        origin->line       = lineno;
+    }
 }
 
 [[noreturn]] inline Frame::Frame(Frame &obj, const string &, usize) { obj.operator$panic(); }
 [[noreturn]] inline Frame::Frame(Frame &&obj, const string &, usize) { obj.operator$panic(); }
 
+inline bool Frame::show_trace() const noexcept {
+    const FrameContext::Origin *origin = context.origin();
+    return origin == nullptr || origin->show_trace.load(libcxx::memory_order_relaxed);
+}
+
+inline void Frame::show_trace(bool show) noexcept {
+    if (FrameContext::Origin *origin = context.origin(); origin != nullptr) {
+        origin->show_trace.store(show, libcxx::memory_order_relaxed);
+    }
+}
+
 inline void Frame::operator$panic() const {
     HX_FN_Vi_Q5_13_helixpanic_handler_Q3_5_5_stdPanicFrame_C_PK_Rv(this);
     throw;
@@ -27,55 +27,121 @@ H_NAMESPACE_BEGIN
 H_STD_NAMESPACE_BEGIN
 
 namespace Panic {
-FrameContext::~FrameContext() {
-    if (error != nullptr) {
-        error->destroy();
-        delete error;
-        error = nullptr;
+namespace __internal {
+    /// freed context blocks kept for the thread's next frame. a thread that keeps returning
+    /// errors reuses the same few blocks instead of going back to the allocator
+    class ContextPool {
+      public:
+        static constexpr usize capacity = 8;
+
+        ~ContextPool() {
+            closed = true;
+            while (count != 0) {
+                ::operator delete(blocks[--count]);
+            }
+        }
+
+        void *take() noexcept { return (!closed && count != 0) ? blocks[--count] : nullptr; }
+
+        bool give(void *block) noexcept {
+            if (closed || count == capacity) {
+                return false;
+            }
+            blocks[count++] = block;
+            return true;
+        }
+
+        static ContextPool &local() noexcept {
+            static thread_local ContextPool pool;
+            return pool;
+        }
+
+        /// set once the thread's pool is gone; frames destroyed after that bypass it
+        inline static constinit thread_local bool closed = false;
+
+      private:
+        void *blocks[capacity]{};
+        usize count = 0;
+    };
+}  // namespace __internal
+
+FrameContext::State *FrameContext::acquire() {
+    void *memory = __internal::ContextPool::closed ? nullptr
+                                                   : __internal::ContextPool::local().take();
+    if (memory == nullptr) {
+        memory = ::operator new(sizeof(State));
+    }
+    return new (memory) State();
+}
+
+void FrameContext::release(State *block) noexcept {
+    if (block->object != nullptr) {
+        block->ops->destroy(block->object);
+    }
+    block->~State();
+
+    if (__internal::ContextPool::closed || !__internal::ContextPool::local().give(block)) {
+        ::operator delete(block);
+    }
+}
+
+template <typename T>
+void FrameContext::destroy_object(void *object) noexcept {
+    if constexpr (stored_inline<T>) {
+        static_cast<T *>(object)->~T();
+    } else {
+        delete static_cast<T *>(object);
+    }
+}
+
+template <typename T>
+string FrameContext::reason_of(const void *object) {
+    if constexpr (Panic::Interface::PanickingStatic<T>) {
+        return T::operator$panic();
+    } else {
+        return static_cast<const T *>(object)->operator$panic();
+    }
+}
+
+void FrameContext::unref(State *block) noexcept {
+    if (block != nullptr && block->refs.fetch_sub(1, libcxx::memory_order_acq_rel) == 1) {
+        release(block);
     }
 }
 
-FrameContext::FrameContext()
-    : error(nullptr) {}
+FrameContext::~FrameContext() { unref(state); }
 
-FrameContext::FrameContext(const FrameContext &other)
-    : error((other.error != nullptr) ? other.error->clone() : nullptr)
-    , handler(other.handler) {}
+FrameContext::FrameContext(const FrameContext &other) noexcept
+    : state(other.state) {
+    if (state != nullptr) {
+        state->refs.fetch_add(1, libcxx::memory_order_relaxed);
+    }
+}
 
-FrameContext &FrameContext::operator=(const FrameContext &other) {
+FrameContext &FrameContext::operator=(const FrameContext &other) noexcept {
     if (this != &other) {
-        if (error != nullptr) {
-            error->destroy();
-            delete error;
-        }
-        error   = (other.error != nullptr) ? other.error->clone() : nullptr;
-        handler = other.handler;
+        FrameContext copy(other);
+        *this = std::Memory::move(copy);
     }
     return *this;
 }
 
 FrameContext::FrameContext(FrameContext &&other) noexcept
-    : error(other.error)
-    , handler(std::Memory::move(other.handler)) {
-    other.error = nullptr;
+    : state(other.state) {
+    other.state = nullptr;
 }
 
 FrameContext &FrameContext::operator=(FrameContext &&other) noexcept {
     if (this != &other) {
-        if (error != nullptr) {
-            error->destroy();
-            delete error;
-        }
-        error       = other.error;
-        handler     = std::Memory::move(other.handler);
-        other.error = nullptr;
+        unref(state);
+        state       = other.state;
+        other.state = nullptr;
     }
     return *this;
 }
 
 template <typename T>
-FrameContext::FrameContext(T *obj)
-    : error(std::erase_type(obj)) {
+FrameContext::FrameContext(T *obj) {
     if constexpr (!Panic::Interface::Panicking<T>) {
         static_assert(Panic::Interface::Panicking<T>,
                       "Frame invoked with an object that does not have a panic method, add "
@@ -84,18 +150,44 @@ FrameContext::FrameContext(T *obj)
                       "static variant.");
     }
 
-    handler = &FrameContext::throw_object<T>;
+    State *block = acquire();
+    try {
+        if constexpr (stored_inline<T>) {
+            block->object = new (block->buffer) T(std::Memory::move(*obj));
+        } else {
+            block->object = new T(std::Memory::move(*obj));
+        }
+    } catch (...) {
+        block->object = nullptr;
+        release(block);
+        throw;
+    }
+
+    block->ops = &ops_for<T>;
+    state      = block;
+}
+
+string FrameContext::reason() const {
+    return (state != nullptr) ? state->ops->reason(state->object) : string();
+}
+
+FrameContext::Origin *FrameContext::origin() const noexcept {
+    return (state != nullptr) ? &state->origin : nullptr;
 }
 
 bool FrameContext::operator!=(const libcxx::type_info *rhs) const { return !(*this == rhs); }
 
 bool FrameContext::operator==(const libcxx::type_info *rhs) const {
-    if (this->error != nullptr) {
-        return this->error->type_info() == rhs;
+    if (this->state != nullptr) {
+        return this->state->ops->type == rhs;
     }
 
     return false;
 }
+
+bool FrameContext::operator==(TypeId rhs) const noexcept {
+    return this->state != nullptr && this->state->ops->id == rhs;
+}
 }  // namespace Panic
 
 H_STD_NAMESPACE_END
@@ -27,76 +27,64 @@ H_NAMESPACE_BEGIN
 
 template <class T>
 [[nodiscard]] bool $question<T>::is_null() const noexcept {
-    return state == $State::Null;
+    return data.kind() == $State::Null;
 }
 template <class T>
 [[nodiscard]] bool $question<T>::is_err() const noexcept {
-    return state == $State::Error;
+    return data.kind() == $State::Error;
 }
 template <class T>
 [[nodiscard]] bool $question<T>::is_err(const libcxx::type_info *type) const noexcept {
-    return state == $State::Error && (*data.error.get_context()) == type;
+    return data.kind() == $State::Error && (*data.error().get_context()) == type;
+}
+template <class T>
+[[nodiscard]] bool $question<T>::is_err(std::TypeId type) const noexcept {
+    return data.kind() == $State::Error && (*data.error().get_context()) == type;
 }
 
 template <class T>
 void $question<T>::set_value(const T &value) {
-    new (&data.value) T(value);
+    data.emplace_value(value);
 }
 template <class T>
 void $question<T>::set_value(T &&value) {
-    new (&data.value) T(std::Memory::move(value));
+    data.emplace_value(std::Memory::move(value));
 }
 template <class T>
 void $question<T>::set_err(std::Panic::Frame &&error) {
-    new (&data.error) std::Panic::Frame(std::Memory::move(error));
+    data.emplace_error(std::Memory::move(error));
 }
 
 template <class T>
-void $question<T>::set_err(std::Panic::Frame &error) {
-    new (&data.error) std::Panic::Frame(error);
-}
-
-template <class T>
-void $question<T>::delete_error() noexcept {
-    data.error.~Frame();
-}
-template <class T>
-void $question<T>::delete_value() noexcept {
-    data.value.~T();
+void $question<T>::set_err(const std::Panic::Frame &error) {
+    data.emplace_error(std::Panic::Frame(error));
 }
 
 /// ------------------------------- Constructors (Null) -------------------------------
 template <class T>
-$question<T>::$question() noexcept
-    : state($State::Null) {}
+$question<T>::$question() noexcept = default;
 template <class T>
-$question<T>::$question(const std::null_t &) noexcept
-    : state($State::Null) {}
+$question<T>::$question(const std::null_t &) noexcept {}
 template <class T>
-$question<T>::$question(std::null_t &&) noexcept
-    : state($State::Null) {}
+$question<T>::$question(std::null_t &&) noexcept {}
 
 /// ------------------------------- Constructors (Value) -------------------------------
 template <class T>
-$question<T>::$question(const T &value)
-    : state($State::Value) {
+$question<T>::$question(const T &value) {
     set_value(value);
 }
 template <class T>
-$question<T>::$question(T &&value)
-    : state($State::Value) {
+$question<T>::$question(T &&value) {
     set_value(std::Memory::move(value));
 }
 
 /// ------------------------------- Constructors (Error) -------------------------------
 template <class T>
-$question<T>::$question(const std::Panic::Frame &error)
-    : state($State::Error) {
+$question<T>::$question(const std::Panic::Frame &error) {
     set_err(error);
 }
 template <class T>
-$question<T>::$question(std::Panic::Frame &&error)
-    : state($State::Error) {
+$question<T>::$question(std::Panic::Frame &&error) {
     set_err(std::Memory::move(error));
 }
 
@@ -104,74 +92,28 @@ $question<T>::$question(std::Panic::Frame &&error)
 /// -------------------------------
 template <class T>
 $question<T>::$question($question &&other) noexcept
-    : state(other.state) {
-    if (state == $State::Error) {
-        set_err(std::Memory::move(other.data.error));
-    } else if (state == $State::Value) {
-        set_value(std::Memory::move(other.data.value));
-    }
-}
+    : data(std::Memory::move(other.data)) {}
 
 template <class T>
 $question<T> &$question<T>::operator=($question &&other) noexcept {
-    if (this != &other) {
-        if (state == $State::Error) {
-            delete_error();
-        } else if (state == $State::Value) {
-            delete_value();
-        }
-
-        state = other.state;
-        if (state == $State::Error) {
-            set_err(std::Memory::move(other.data.error));
-        } else if (state == $State::Value) {
-            set_value(std::Memory::move(other.data.value));
-        }
-    }
+    data = std::Memory::move(other.data);
     return *this;
 }
 
 /// --------------------- Copy Constructor & Assignment ----------------------
 template <class T>
 $question<T>::$question(const $question &other)
-    : state(other.state) {
-    if (state == $State::Error) {
-        set_err(other.data.error);
-    } else if (state == $State::Value) {
-        set_value(other.data.value);
-    }
-}
+    : data(other.data) {}
 
 template <class T>
 $question<T> &$question<T>::operator=(const $question &other) {
-    if (this != &other) {
-        if (state == $State::Error) {
-            delete_error();
-        } else if (state == $State::Value) {
-            delete_value();
-        }
-
-        state = other.state;
-        if (state == $State::Error) {
-            set_err(other.data.error);
-        } else if (state == $State::Value) {
-            set_value(other.data.value);
-        }
-    }
+    data = other.data;
     return *this;
 }
 
 /// ------------------------------- Destructor -------------------------------
 template <class T>
-$question<T>::~$question() {
-    if (state == $State::Error) {
-        delete_error();
-    } else if (state == $State::Value) {
-        if constexpr (std::Meta::is_destructible<T>) {
-            delete_value();
-        }
-    }
-}
+$question<T>::~$question() = default;
 
 /// ------------------------------- Operators -------------------------------
 template <class T>
@@ -187,7 +129,7 @@ template <class T>
 template <typename E>
 bool $question<T>::operator==(const E &) const noexcept {
     if constexpr (std::Panic::Interface::Panicking<E>) {
-        return is_err(&typeid(E));
+        return is_err(std::TypeId::of<E>());
     }
 
 #ifdef _MSC_VER
@@ -215,7 +157,7 @@ bool $question<T>::operator$contains(const E &other) const noexcept {
 
 template <class T>
 [[nodiscard]] bool $question<T>::operator$question() const noexcept {
-    return state == $State::Value;
+    return data.kind() == $State::Value;
 }
 
 /// ------------------------------- Casting -------------------------------
@@ -223,21 +165,21 @@ template <class T>
 template <typename E>
     requires std::Panic::Interface::Panicking<E>
 E $question<T>::operator$cast(E * /*unused*/) const {
-    if (state == $State::Error) {
-        if (is_err(&typeid(E))) {
-            auto *obj = (*data.error.get_context()).object();
+    if (data.kind() == $State::Error) {
+        if (is_err(std::TypeId::of<E>())) {
+            auto *obj = (*data.error().get_context()).object();
             if (obj) {
                 return *reinterpret_cast<E *>(obj);
             }
             _HX_MC_Q7_INTERNAL_CRASH_PANIC_M(std::Error::NullValueError(
                 string(L"Invalid Decay: error context object is null.")));
         }
-        data.error.operator$panic();
+        data.error().operator$panic();
     }
 
-    if (state == $State::Value) {
+    if (data.kind() == $State::Value) {
         if constexpr (std::Meta::same_as<T, E>) {
-            return data.value;
+            return data.value();
         }
 
         _HX_MC_Q7_INTERNAL_CRASH_PANIC_M(std::Error::TypeMismatchError(
@@ -249,12 +191,12 @@ E $question<T>::operator$cast(E * /*unused*/) const {
 
 template <class T>
 T $question<T>::operator$cast(T * /*unused*/) const {
-    if (state == $State::Value) {
-        return data.value;
+    if (data.kind() == $State::Value) {
+        return data.value();
     }
 
-    if (state == $State::Error) {
-        data.error.operator$panic();
+    if (data.kind() == $State::Error) {
+        data.error().operator$panic();
     }
 
     _HX_MC_Q7_INTERNAL_CRASH_PANIC_M(std::Error::NullValueError(L"Invalid Decay: value is null."));
@@ -281,12 +223,12 @@ T $question<T>::operator$cast(T * /*unused*/) const {
 ///
 template <class T>
 [[nodiscard]] T &$question<T>::operator*() {
-    if (state == $State::Value) {
-        return data.value;
+    if (data.kind() == $State::Value) {
+        return data.value();
     }
 
-    if (state == $State::Error) {
-        data.error.operator$panic();
+    if (data.kind() == $State::Error) {
+        data.error().operator$panic();
     }
 
     _HX_MC_Q7_INTERNAL_CRASH_PANIC_M(std::Error::NullValueError(L"Invalid Decay: value is null."));
@@ -315,12 +257,12 @@ template <class T>
 ///
 template <class T>
 [[nodiscard]] $question<T>::operator T() {
-    if (state == $State::Value) {
-        return data.value;
+    if (data.kind() == $State::Value) {
+        return data.value();
     }
 
-    if (state == $State::Error) {
-        data.error.operator$panic();
+    if (data.kind() == $State::Error) {
+        data.error().operator$panic();
     }
 
     _HX_MC_Q7_INTERNAL_CRASH_PANIC_M(std::Error::NullValueError(L"Invalid Decay: value is null."));
@@ -180,7 +180,8 @@ bool slice<CharT, Traits>::ends_with(slice &needle) const {
 template <typename CharT, typename Traits>
     requires CharTraits<Traits, CharT>
 bool slice<CharT, Traits>::contains(slice &needle) const {
-    return data.find(needle) != view_t::npos;
+    return __internal::search::find(data.data(), data.size(), needle.raw(), needle.size()) !=
+           __internal::search::npos;
 }
 
 template <typename CharT, typename Traits>
@@ -199,25 +200,8 @@ template <typename CharT, typename Traits>
     requires CharTraits<Traits, CharT>
 slice<CharT, Traits>::slice_vec slice<CharT, Traits>::split_lines() const {
     slice_vec result;
-    bool      encoding_CR = false;
-    usize     start       = 0;
-    usize     end         = 0;
-    while (end < len) {
-        if (this->operator[](end) == '\r') {
-            encoding_CR = true;
-        } else if (this->operator[](end) == '\n') {
-            if (encoding_CR) {
-                result.push_back(subslice(start, end - start - 1));
-                encoding_CR = false;
-            } else {
-                result.push_back(subslice(start, end - start));
-            }
-            start = end + 1;
-        }
-        ++end;
-    }
-    if (start < end) {
-        result.push_back(subslice(start, end - start));
+    for (const slice_t &line : lines_iter()) {
+        result.push_back(line);
     }
     return result;
 }
@@ -226,68 +210,146 @@ template <typename CharT, typename Traits>
     requires CharTraits<Traits, CharT>
 slice<CharT, Traits>::slice_vec slice<CharT, Traits>::split(slice &delim, Operation op) const {
     slice_vec result;
-    usize     start = 0;
-    usize     end   = 0;
-    while (end < len) {
-        if (subslice(end, delim.size()) == delim) {
-            if (op == Operation::Keep) {
-                result.push_back(subslice(start, end - start));
-                result.push_back(delim);
-            } else {
-                result.push_back(subslice(start, end - start));
-            }
-            end += delim.size();
-            start = end;
-        } else {
-            ++end;
-        }
-    }
-    if (start < end) {
-        result.push_back(subslice(start, end - start));
+    for (const slice_t &part : split_iter(delim, op)) {
+        result.push_back(part);
     }
     return result;
 }
 
+/////////////////////////////////// LAZY SPLITTING ///////////////////////////////////
+
+template <typename CharT, typename Traits>
+    requires CharTraits<Traits, CharT>
+slice<CharT, Traits>::split_range slice<CharT, Traits>::split_iter(const slice &delim,
+                                                                   Operation    op) const noexcept {
+    return split_range(slice_t(data.data(), data.size()), slice_t(delim.raw(), delim.size()), op);
+}
+
+template <typename CharT, typename Traits>
+    requires CharTraits<Traits, CharT>
+slice<CharT, Traits>::lines_range slice<CharT, Traits>::lines_iter() const noexcept {
+    return lines_range(slice_t(data.data(), data.size()));
+}
+
+template <typename CharT, typename Traits>
+    requires CharTraits<Traits, CharT>
+void slice<CharT, Traits>::split_range::iterator::advance() noexcept {
+    if (pending) {  // `Operation::Keep` hands out the delimiter that ended the last part
+        current = slice_t(source.raw() + match, delim.size());
+        pending = false;
+        return;
+    }
+
+    const usize len = source.size();
+    if (pos >= len) {
+        done = true;
+        return;
+    }
+
+    // an empty delimiter never matches, so the whole remainder becomes a single part
+    const usize next =
+        delim.size() == 0
+            ? __internal::search::npos
+            : __internal::search::find(source.raw(), len, delim.raw(), delim.size(), pos);
+
+    if (next == __internal::search::npos) {
+        current = slice_t(source.raw() + pos, len - pos);
+        pos     = len;
+        return;
+    }
+
+    current = slice_t(source.raw() + pos, next - pos);
+    match   = next;
+    pos     = next + delim.size();
+    pending = op == Operation::Keep;
+}
+
+template <typename CharT, typename Traits>
+    requires CharTraits<Traits, CharT>
+void slice<CharT, Traits>::lines_range::iterator::advance() noexcept {
+    static constexpr CharT breaks[] = {static_cast<CharT>('\r'), static_cast<CharT>('\n')};
+
+    const usize len = source.size();
+    if (pos >= len) {
+        done = true;
+        return;
+    }
+
+    const usize next = __internal::search::find_first_of(source.raw(), len, breaks, 2, pos);
+    if (next == __internal::search::npos) {
+        current = slice_t(source.raw() + pos, len - pos);
+        pos     = len;
+        return;
+    }
+
+    current = slice_t(source.raw() + pos, next - pos);
+    pos     = (source[next] == breaks[0] && next + 1 < len && source[next + 1] == breaks[1])
+                  ? next + 2
+                  : next + 1;
+}
+
+template <typename CharT, typename Traits>
+    requires CharTraits<Traits, CharT>
+$generator<typename slice<CharT, Traits>::slice_t>
+slice<CharT, Traits>::split_range::generate(split_range range) {
+    for (const slice_t &part : range) {
+        co_yield part;
+    }
+}
+
+template <typename CharT, typename Traits>
+    requires CharTraits<Traits, CharT>
+$generator<typename slice<CharT, Traits>::slice_t>
+slice<CharT, Traits>::lines_range::generate(lines_range range) {
+    for (const slice_t &line : range) {
+        co_yield line;
+    }
+}
+
 template <typename CharT, typename Traits>
     requires CharTraits<Traits, CharT>
 std::Questionable<usize> slice<CharT, Traits>::lfind(slice &needle) const {
-    usize pos = data.find(needle);
-    return pos == view_t::npos ? null : std::Questionable<usize>(pos);
+    usize pos = __internal::search::find(data.data(), data.size(), needle.raw(), needle.size());
+    return pos == __internal::search::npos ? null : std::Questionable<usize>(pos);
 }
 
 template <typename CharT, typename Traits>
     requires CharTraits<Traits, CharT>
 std::Questionable<usize> slice<CharT, Traits>::rfind(slice &needle) const {
-    usize pos = data.rfind(needle);
-    return pos == view_t::npos ? null : std::Questionable<usize>(pos);
+    usize pos = __internal::search::rfind(data.data(), data.size(), needle.raw(), needle.size());
+    return pos == __internal::search::npos ? null : std::Questionable<usize>(pos);
 }
 
 template <typename CharT, typename Traits>
     requires CharTraits<Traits, CharT>
 std::Questionable<usize> slice<CharT, Traits>::find_first_of(slice &needle) const {
-    usize pos = data.find_first_of(needle);
-    return pos == view_t::npos ? null : std::Questionable<usize>(pos);
+    usize pos =
+        __internal::search::find_first_of(data.data(), data.size(), needle.raw(), needle.size());
+    return pos == __internal::search::npos ? null : std::Questionable<usize>(pos);
 }
 
 template <typename CharT, typename Traits>
     requires CharTraits<Traits, CharT>
 std::Questionable<usize> slice<CharT, Traits>::find_last_of(slice &needle) const {
-    usize pos = data.find_last_of(needle);
-    return pos == view_t::npos ? null : std::Questionable<usize>(pos);
+    usize pos =
+        __internal::search::find_last_of(data.data(), data.size(), needle.raw(), needle.size());
+    return pos == __internal::search::npos ? null : std::Questionable<usize>(pos);
 }
 
 template <typename CharT, typename Traits>
     requires CharTraits<Traits, CharT>
 std::Questionable<usize> slice<CharT, Traits>::find_first_not_of(slice &needle) const {
-    usize pos = data.find_first_not_of(needle);
-    return pos == view_t::npos ? null : std::Questionable<usize>(pos);
+    usize pos = __internal::search::find_first_of(
+        data.data(), data.size(), needle.raw(), needle.size(), 0, true);
+    return pos == __internal::search::npos ? null : std::Questionable<usize>(pos);
 }
 
 template <typename CharT, typename Traits>
     requires CharTraits<Traits, CharT>
 std::Questionable<usize> slice<CharT, Traits>::find_last_not_of(slice &needle) const {
-    usize pos = data.find_last_not_of(needle);
-    return (pos == view_t::npos) ? null : std::Questionable<usize>(pos);
+    usize pos = __internal::search::find_last_of(
+        data.data(), data.size(), needle.raw(), needle.size(), __internal::search::npos, true);
+    return (pos == __internal::search::npos) ? null : std::Questionable<usize>(pos);
 }
 
 template <typename CharT, typename Traits>
@@ -142,7 +142,15 @@ inline basic<CharT, Traits>::basic(
         return;
     }
     usize size = LIBCXX_NAMESPACE::char_traits<char>::length(str);
-    data       = nstring_to_string(nstring(str, size)).data;
+    if (size == 0) {
+        data = L"";
+        return;
+    }
+
+    const auto *src = reinterpret_cast<const char8_t *>(str);
+    const auto  len = __internal::transcode::utf8_to_wide_length<CharT>(src, size);
+    data.resize(len.units);
+    __internal::transcode::utf8_to_wide(src, size, data.data(), len.valid);
 }
 
 template <typename CharT, typename Traits>
@@ -156,7 +164,11 @@ inline basic<CharT, Traits>::basic(
         data = L"";
         return;
     }
-    data = nstring_to_string(nstring(str, size)).data;
+
+    const auto *src = reinterpret_cast<const char8_t *>(str);
+    const auto  len = __internal::transcode::utf8_to_wide_length<CharT>(src, size);
+    data.resize(len.units);
+    __internal::transcode::utf8_to_wide(src, size, data.data(), len.valid);
 }
 
 //////////////////////////////////// SUBSTRING //////////////////////////////////////
@@ -210,25 +222,8 @@ template <typename CharT, typename Traits>
 inline vec<basic<CharT, Traits>> basic<CharT, Traits>::split(const basic       &delim,
                                                              slice_t::Operation op) const {
     vec<basic> result;
-    size_t     start      = 0;
-    size_t     end        = 0;
-    size_t     delim_size = delim.size();
-    while (end <= size()) {
-        if (end + delim_size <= size() && subslice(end, delim_size) == delim) {
-            if (op == slice_t::Operation::Keep) {
-                result.push_back(subslice(start, end - start));
-                result.push_back(delim);
-            } else {
-                result.push_back(subslice(start, end - start));
-            }
-            start = end + delim_size;
-            end   = start;
-        } else {
-            ++end;
-        }
-    }
-    if (start < size()) {
-        result.push_back(subslice(start, size() - start));
+    for (const auto &part : split_iter(delim, op)) {
+        result.emplace_back(part.raw(), part.size());
     }
     return result;
 }
@@ -237,30 +232,25 @@ template <typename CharT, typename Traits>
     requires CharTraits<Traits, CharT>
 inline vec<basic<CharT, Traits>> basic<CharT, Traits>::split_lines() const {
     vec<basic> result;
-    size_t     start = 0;
-    size_t     end   = 0;
-    while (end < size()) {
-        if (operator[](end) == '\n') {
-            result.push_back(subslice(start, end - start));
-            start = end + 1;
-        } else if (operator[](end) == '\r') {
-            if (end + 1 < size() && operator[](end + 1) == '\n') {
-                result.push_back(subslice(start, end - start));
-                start = end + 2;
-                end += 1;
-            } else {
-                result.push_back(subslice(start, end - start));
-                start = end + 1;
-            }
-        }
-        ++end;
-    }
-    if (start < size()) {
-        result.push_back(subslice(start, size() - start));
+    for (const auto &line : lines_iter()) {
+        result.emplace_back(line.raw(), line.size());
     }
     return result;
 }
 
+template <typename CharT, typename Traits>
+    requires CharTraits<Traits, CharT>
+inline typename basic<CharT, Traits>::split_range
+basic<CharT, Traits>::split_iter(slice_t delim, slice_t::Operation op) const noexcept {
+    return slice_t(data.data(), data.size()).split_iter(delim, op);
+}
+
+template <typename CharT, typename Traits>
+    requires CharTraits<Traits, CharT>
+inline typename basic<CharT, Traits>::lines_range basic<CharT, Traits>::lines_iter() const noexcept {
+    return slice_t(data.data(), data.size()).lines_iter();
+}
+
 /////////////////////////////////////// FIND //////////////////////////////////////
 
 template <typename CharT, typename Traits>
@@ -314,7 +304,7 @@ inline std::Questionable<usize> basic<CharT, Traits>::lfind(const basic& needle,
         return null;
     }
     
-    auto fnd = data.find(needle.raw(), pos, needle.size());
+    auto fnd = __internal::search::find(data.data(), data.size(), needle.raw(), needle.size(), pos);
     return fnd != npos ? std::Questionable<usize>(fnd) : null;
 }
 
@@ -331,31 +321,9 @@ inline std::Questionable<usize> basic<CharT, Traits>::rfind(slice needle, usize
         return null;
     }
     
-    // Adjust pos if it's beyond string length
-    if (pos >= size() - needle.size() + 1) {
-        pos = size() - needle.size();
-    }
-    
-    // Manual implementation for exact match of a slice
-    const CharT* haystack_ptr = data.data();
-    const CharT* needle_ptr = needle.raw();
-    const usize needle_length = needle.size();
-    
-    // Search backward from pos
-    for (usize i = pos + 1; i > 0; --i) {
-        bool found = true;
-        for (usize j = 0; j < needle_length; ++j) {
-            if (haystack_ptr[i - 1 + j] != needle_ptr[j]) {
-                found = false;
-                break;
-            }
-        }
-        if (found) {
-            return std::Questionable<usize>(i - 1);
-        }
-    }
-    
-    return null;
+    // Search backward from pos (clamped to the last viable start)
+    auto fnd = __internal::search::rfind(data.data(), data.size(), needle.raw(), needle.size(), pos);
+    return fnd != npos ? std::Questionable<usize>(fnd) : null;
 }
 
 template <typename CharT, typename Traits>
@@ -366,21 +334,9 @@ inline std::Questionable<usize> basic<CharT, Traits>::find_first_of(slice needle
         return null;
     }
     
-    // Manual implementation for matching any character in needle
-    const CharT* haystack_ptr = data.data() + pos;
-    const CharT* needle_ptr = needle.raw();
-    const usize haystack_length = size() - pos;
-    const usize needle_length = needle.size();
-    
-    for (usize i = 0; i < haystack_length; ++i) {
-        for (usize j = 0; j < needle_length; ++j) {
-            if (haystack_ptr[i] == needle_ptr[j]) {
-                return std::Questionable<usize>(pos + i);
-            }
-        }
-    }
-    
-    return null;
+    auto fnd = __internal::search::find_first_of(
+        data.data(), data.size(), needle.raw(), needle.size(), pos);
+    return fnd != npos ? std::Questionable<usize>(fnd) : null;
 }
 
 template <typename CharT, typename Traits>
@@ -391,26 +347,10 @@ inline std::Questionable<usize> basic<CharT, Traits>::find_last_of(slice needle,
         return null;
     }
     
-    // Adjust pos if it's beyond string length
-    if (pos >= size()) {
-        pos = size() - 1;
-    }
-    
-    // Manual implementation for matching any character in needle
-    const CharT* haystack_ptr = data.data();
-    const CharT* needle_ptr = needle.raw();
-    const usize needle_length = needle.size();
-    
-    // Search backward from pos
-    for (usize i = pos + 1; i > 0; --i) {
-        for (usize j = 0; j < needle_length; ++j) {
-            if (haystack_ptr[i - 1] == needle_ptr[j]) {
-                return std::Questionable<usize>(i - 1);
-            }
-        }
-    }
-    
-    return null;
+    // Search backward from pos (clamped to the last character)
+    auto fnd = __internal::search::find_last_of(
+        data.data(), data.size(), needle.raw(), needle.size(), pos);
+    return fnd != npos ? std::Questionable<usize>(fnd) : null;
 }
 
 template <typename CharT, typename Traits>
@@ -426,26 +366,9 @@ inline std::Questionable<usize> basic<CharT, Traits>::find_first_not_of(slice ne
         return std::Questionable<usize>(pos);
     }
     
-    // Manual implementation for finding first character not in needle
-    const CharT* haystack_ptr = data.data() + pos;
-    const CharT* needle_ptr = needle.raw();
-    const usize haystack_length = size() - pos;
-    const usize needle_length = needle.size();
-    
-    for (usize i = 0; i < haystack_length; ++i) {
-        bool found = false;
-        for (usize j = 0; j < needle_length; ++j) {
-            if (haystack_ptr[i] == needle_ptr[j]) {
-                found = true;
-                break;
-            }
-        }
-        if (!found) {
-            return std::Questionable<usize>(pos + i);
-        }
-    }
-    
-    return null;
+    auto fnd = __internal::search::find_first_of(
+        data.data(), data.size(), needle.raw(), needle.size(), pos, true);
+    return fnd != npos ? std::Questionable<usize>(fnd) : null;
 }
 
 template <typename CharT, typename Traits>
@@ -461,31 +384,10 @@ inline std::Questionable<usize> basic<CharT, Traits>::find_last_not_of(slice nee
         return std::Questionable<usize>(pos < size() ? pos : size() - 1);
     }
     
-    // Adjust pos if it's beyond string length
-    if (pos >= size()) {
-        pos = size() - 1;
-    }
-    
-    // Manual implementation for finding last character not in needle
-    const CharT* haystack_ptr = data.data();
-    const CharT* needle_ptr = needle.raw();
-    const usize needle_length = needle.size();
-    
-    // Search backward from pos
-    for (usize i = pos + 1; i > 0; --i) {
-        bool found = false;
-        for (usize j = 0; j < needle_length; ++j) {
-            if (haystack_ptr[i - 1] == needle_ptr[j]) {
-                found = true;
-                break;
-            }
-        }
-        if (!found) {
-            return std::Questionable<usize>(i - 1);
-        }
-    }
-    
-    return null;
+    // Search backward from pos (clamped to the last character)
+    auto fnd = __internal::search::find_last_of(
+        data.data(), data.size(), needle.raw(), needle.size(), pos, true);
+    return fnd != npos ? std::Questionable<usize>(fnd) : null;
 }
 
 template class basic<char>;
@@ -0,0 +1,248 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///-------------------------------------------------------------------------------- Lib-Helix ---///
+
+#ifndef _$_HX_CORE_M8U8STRING_TPP
+#define _$_HX_CORE_M8U8STRING_TPP
+
+#include <include/config/config.hh>
+
+#include <include/c++/libc++.hh>
+#include <include/meta/meta.hh>
+#include <include/runtime/runtime.hh>
+#include <include/types/types.hh>
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+namespace String {
+////////////////////////////////////// CONSTRUCTORS //////////////////////////////////////
+
+inline utf8::utf8(const utf8 &other) {
+    reset();
+    assign(other.raw(), other.size());
+}
+
+inline utf8::utf8(utf8 &&other) noexcept
+    : rep(other.rep) {
+    other.reset();
+}
+
+inline utf8::utf8(const char8_t *str) {
+    reset();
+    if (str != nullptr) {
+        assign(str, libcxx::char_traits<char8_t>::length(str));
+    }
+}
+
+inline utf8::utf8(const char8_t *str, usize len) {
+    reset();
+    assign(str, len);
+}
+
+inline utf8::utf8(view_t view) {
+    reset();
+    assign(view.data(), view.size());
+}
+
+inline utf8::utf8(const char *str) {
+    reset();
+    if (str != nullptr) {
+        assign(reinterpret_cast<const char8_t *>(str), libcxx::char_traits<char>::length(str));
+    }
+}
+
+inline utf8::utf8(const char *str, usize len) {
+    reset();
+    assign(reinterpret_cast<const char8_t *>(str), len);
+}
+
+inline utf8::utf8(const nstring &str) {
+    reset();
+    assign(reinterpret_cast<const char8_t *>(str.raw()), str.size());
+}
+
+inline utf8::utf8(const string &str) {
+    reset();
+
+    const usize bytes = __internal::transcode::wide_to_utf8_length(str.raw(), str.size());
+    grow(bytes);
+    set_size(__internal::transcode::wide_to_utf8(str.raw(), str.size(), mut_raw()));
+}
+
+inline utf8::~utf8() { release(); }
+
+////////////////////////////////////// ASSIGNMENT //////////////////////////////////////
+
+inline utf8 &utf8::operator=(const utf8 &other) {
+    if (this != &other) {
+        set_size(0);
+        assign(other.raw(), other.size());
+    }
+    return *this;
+}
+
+inline utf8 &utf8::operator=(utf8 &&other) noexcept {
+    if (this != &other) {
+        release();
+        rep = other.rep;
+        other.reset();
+    }
+    return *this;
+}
+
+inline utf8 &utf8::operator=(view_t view) {
+    set_size(0);
+    assign(view.data(), view.size());
+    return *this;
+}
+
+//////////////////////////////////////// STORAGE ////////////////////////////////////////
+
+inline void utf8::release() noexcept {
+    if (is_heap()) {
+        delete[] rep.heap.ptr;
+        reset();
+    }
+}
+
+inline void utf8::set_size(usize len) noexcept {
+    if (is_heap()) {
+        rep.heap.size = len;
+    } else {
+        rep.bytes[tag_at] = static_cast<unsigned char>(len);
+    }
+    mut_raw()[len] = 0;
+}
+
+inline void utf8::grow(usize min_cap) {
+    const usize cap = capacity();
+    if (min_cap <= cap) {
+        return;
+    }
+
+    const usize new_cap = min_cap < cap * 2 ? cap * 2 : min_cap;
+    const usize len     = size();
+    auto       *buffer  = new char8_t[new_cap + 1];
+
+    libcxx::memcpy(buffer, raw(), len);
+    buffer[len] = 0;
+    release();
+
+    rep.heap.ptr  = buffer;
+    rep.heap.size = len;
+    rep.heap.cap  = new_cap | heap_flag;
+}
+
+inline void utf8::assign(const char8_t *str, usize len) {
+    grow(len);
+    if (len != 0) {
+        libcxx::memmove(mut_raw(), str, len);
+    }
+    set_size(len);
+}
+
+inline void utf8::reserve(usize new_cap) { grow(new_cap); }
+
+inline void utf8::append(const char8_t *str, usize len) {
+    const usize old = size();
+    if (old + len > capacity()) {
+        // `str` may point into this string, so copy it before the buffer moves
+        if (str >= raw() && str < raw() + old) {
+            const usize offset = static_cast<usize>(str - raw());
+            grow(old + len);
+            str = raw() + offset;
+        } else {
+            grow(old + len);
+        }
+    }
+    libcxx::memmove(mut_raw() + old, str, len);
+    set_size(old + len);
+}
+
+inline void utf8::push_back(char8_t c) { append(&c, 1); }
+
+inline void utf8::push(char32_t code_point) {
+    char8_t buffer[4];
+    append(buffer, __internal::transcode::encode_utf8(code_point, buffer));
+}
+
+///////////////////////////////////// CONCATENATION /////////////////////////////////////
+
+inline utf8 &utf8::operator+=(const utf8 &other) {
+    append(other.raw(), other.size());
+    return *this;
+}
+
+inline utf8 &utf8::operator+=(view_t view) {
+    append(view.data(), view.size());
+    return *this;
+}
+
+inline utf8 &utf8::operator+=(char32_t code_point) {
+    push(code_point);
+    return *this;
+}
+
+inline utf8 utf8::operator+(const utf8 &other) const {
+    utf8 result;
+    result.reserve(size() + other.size());
+    result.append(raw(), size());
+    result.append(other.raw(), other.size());
+    return result;
+}
+
+inline utf8 utf8::operator+(view_t view) const {
+    utf8 result;
+    result.reserve(size() + view.size());
+    result.append(raw(), size());
+    result.append(view.data(), view.size());
+    return result;
+}
+
+////////////////////////////////////// CODE POINTS //////////////////////////////////////
+
+inline utf8::code_point_range utf8::code_points() const noexcept {
+    return code_point_range(view());
+}
+
+inline usize utf8::code_point_count() const noexcept {
+    usize count = 0;
+    for (auto it = code_points().begin(); it != libcxx::default_sentinel; ++it) {
+        ++count;
+    }
+    return count;
+}
+
+inline void utf8::code_point_range::iterator::decode() noexcept {
+    if (pos != stop) {
+        current = __internal::transcode::decode_utf8(pos, stop, width);
+    }
+}
+
+inline string utf8::to_string() const {
+    const auto len = __internal::transcode::utf8_to_wide_length<wchar_t>(raw(), size());
+    string     result;
+
+    result.resize(len.units);
+    __internal::transcode::utf8_to_wide(
+        raw(), size(), const_cast<wchar_t *>(result.raw()), len.valid);
+    return result;
+}
+}  // namespace String
+
+H_STD_NAMESPACE_END
+H_NAMESPACE_END
+
+#endif  // _$_HX_CORE_M8U8STRING_TPP
@@ -22,67 +22,65 @@
 #include <include/meta/meta.hh>
 #include <include/runtime/runtime.hh>
 #include <include/types/types.hh>
+#include <include/types/builtins/int128.hh>
 
-i128::i128()
+constexpr i128::i128()
     : high(0)
     , low(0) {}
-i128::i128(u64 val)
+constexpr i128::i128(u64 val)
     : high(0)
     , low(val) {}
-i128::i128(u32 val)
+constexpr i128::i128(u32 val)
     : high(0)
     , low(static_cast<u64>(val)) {}
-i128::i128(u16 val)
+constexpr i128::i128(u16 val)
     : high(0)
     , low(static_cast<u64>(val)) {}
-i128::i128(u8 val)
+constexpr i128::i128(u8 val)
     : high(0)
     , low(static_cast<u64>(val)) {}
-i128::i128(i64 val)
+constexpr i128::i128(i64 val)
     : high(val < 0 ? 0xFFFFFFFFFFFFFFFF : 0)
     , low(static_cast<u64>(val)) {}
-i128::i128(i32 val)
+constexpr i128::i128(i32 val)
     : high(val < 0 ? 0xFFFFFFFFFFFFFFFF : 0)
     , low(static_cast<u64>(static_cast<i64>(val))) {}
-i128::i128(i16 val)
+constexpr i128::i128(i16 val)
     : high(val < 0 ? 0xFFFFFFFFFFFFFFFF : 0)
     , low(static_cast<u64>(static_cast<i64>(val))) {}
-i128::i128(i8 val)
+constexpr i128::i128(i8 val)
     : high(val < 0 ? 0xFFFFFFFFFFFFFFFF : 0)
     , low(static_cast<u64>(static_cast<i64>(val))) {}
-i128::i128(const u128 &x)
+constexpr i128::i128(const u128 &x)
     : high(x.high)
     , low(x.low) {}
-i128::i128(u64 high, u64 low)
+constexpr i128::i128(u64 high, u64 low)
     : high(high)
     , low(low) {}
 
-bool i128::is_negative() const { return (high & 0x8000000000000000) != 0; }
+constexpr bool i128::is_negative() const { return (high & 0x8000000000000000) != 0; }
 
-i128 i128::operator+(const i128 &other) const {
+constexpr i128 i128::operator+(const i128 &other) const {
     u64 sum_low  = low + other.low;
     u64 carry    = (sum_low < low) ? 1 : 0;
     u64 sum_high = high + other.high + carry;
     return {sum_high, sum_low};
 }
 
-i128 i128::operator-(const i128 &other) const {
+constexpr i128 i128::operator-(const i128 &other) const {
     u64 diff_low  = low - other.low;
     u64 borrow    = (diff_low > low) ? 1 : 0;
     u64 diff_high = high - other.high - borrow;
     return {diff_high, diff_low};
 }
 
-i128 i128::operator*(const i128 &other) const {
-    bool sign      = is_negative() != other.is_negative();
-    i128 abs_this  = is_negative() ? -(*this) : *this;
-    i128 abs_other = other.is_negative() ? -other : other;
-    u128 u_result  = u128(abs_this) * u128(abs_other);
-    i128 result    = i128(u_result);
-    return sign ? -result : result;
+constexpr i128 i128::operator*(const i128 &other) const {
+    // the low 128 bits of a two's complement product do not depend on the signs
+    const auto p = helix::std::Int128::__internal::mul({high, low}, {other.high, other.low});
+    return {p.high, p.low};
 }
 
-i128 i128::operator/(const i128 &other) const {
+constexpr i128 i128::operator/(const i128 &other) const {
     bool sign       = is_negative() != other.is_negative();
     i128 abs_this   = is_negative() ? -(*this) : *this;
     i128 abs_other  = other.is_negative() ? -other : other;
@@ -91,7 +89,7 @@ i128 i128::operator/(const i128 &other) const {
     return sign ? -quotient : quotient;
 }
 
-i128 i128::operator%(const i128 &other) const {
+constexpr i128 i128::operator%(const i128 &other) const {
     bool sign        = is_negative();
     i128 abs_this    = is_negative() ? -(*this) : *this;
     i128 abs_other   = other.is_negative() ? -other : other;
@@ -100,12 +98,14 @@ i128 i128::operator%(const i128 &other) const {
     return sign ? -remainder : remainder;
 }
 
-i128 i128::operator&(const i128 &other) const { return {high & other.high, low & other.low}; }
-i128 i128::operator|(const i128 &other) const { return {high | other.high, low | other.low}; }
-i128 i128::operator^(const i128 &other) const { return {high ^ other.high, low ^ other.low}; }
-i128 i128::operator~() const { return {~high, ~low}; }
+constexpr i128 i128::operator&(const i128 &other) const { return {high & other.high, low & other.low}; }
+constexpr i128 i128::operator|(const i128 &other) const { return {high | other.high, low | other.low}; }
+constexpr i128 i128::operator^(const i128 &other) const { return {high ^ other.high, low ^ other.low}; }
+constexpr i128 i128::operator~() const { return {~high, ~low}; }
 
-i128 i128::operator<<(int shift) const {
+constexpr i128 i128::operator<<(int shift) const {
+    if (shift <= 0)
+        return *this;
     if (shift >= 128)
         return i128(0);
     if (shift >= 64)
@@ -116,11 +116,13 @@ i128 i128::operator<<(int shift) const {
     return {new_high, new_low};
 }
 
-i128 i128::operator>>(int shift) const {
+constexpr i128 i128::operator>>(int shift) const {
+    if (shift <= 0)
+        return *this;
     if (shift >= 128)
         return is_negative() ? i128(-1) : i128(0);
     if (shift >= 64) {
-        u64 new_low  = high >> (shift - 64);
+        u64 new_low  = static_cast<u64>(static_cast<i64>(high) >> (shift - 64));
         u64 new_high = is_negative() ? 0xFFFFFFFFFFFFFFFF : 0;
         return {new_high, new_low};
     }
@@ -132,49 +134,49 @@ i128 i128::operator>>(int shift) const {
     return {new_high, new_low};
 }
 
-bool i128::operator==(const i128 &other) const { return high == other.high && low == other.low; }
-bool i128::operator!=(const i128 &other) const { return !(*this == other); }
-bool i128::operator<(const i128 &other) const {
+constexpr bool i128::operator==(const i128 &other) const { return high == other.high && low == other.low; }
+constexpr bool i128::operator!=(const i128 &other) const { return !(*this == other); }
+constexpr bool i128::operator<(const i128 &other) const {
     bool this_neg  = is_negative();
     bool other_neg = other.is_negative();
     if (this_neg != other_neg)
         return this_neg;
     return high < other.high || (high == other.high && low < other.low);
 }
-bool i128::operator>(const i128 &other) const { return other < *this; }
-bool i128::operator<=(const i128 &other) const { return !(*this > other); }
-bool i128::operator>=(const i128 &other) const { return !(*this < other); }
+constexpr bool i128::operator>(const i128 &other) const { return other < *this; }
+constexpr bool i128::operator<=(const i128 &other) const { return !(*this > other); }
+constexpr bool i128::operator>=(const i128 &other) const { return !(*this < other); }
 
-i128 &i128::operator=(const i128 &other) {
+constexpr i128 &i128::operator=(const i128 &other) {
     high = other.high;
     low  = other.low;
     return *this;
 }
-i128 &i128::operator+=(const i128 &other) { return *this = *this + other; }
-i128 &i128::operator-=(const i128 &other) { return *this = *this - other; }
-i128 &i128::operator*=(const i128 &other) { return *this = *this * other; }
-i128 &i128::operator/=(const i128 &other) { return *this = *this / other; }
-i128 &i128::operator%=(const i128 &other) { return *this = *this % other; }
-i128 &i128::operator&=(const i128 &other) { return *this = *this & other; }
-i128 &i128::operator|=(const i128 &other) { return *this = *this | other; }
-i128 &i128::operator^=(const i128 &other) { return *this = *this ^ other; }
-i128 &i128::operator<<=(int shift) { return *this = *this << shift; }
-i128 &i128::operator>>=(int shift) { return *this = *this >> shift; }
-
-i128 &i128::operator++() { return *this += i128(1); }
-i128  i128::operator++(int) {
+constexpr i128 &i128::operator+=(const i128 &other) { return *this = *this + other; }
+constexpr i128 &i128::operator-=(const i128 &other) { return *this = *this - other; }
+constexpr i128 &i128::operator*=(const i128 &other) { return *this = *this * other; }
+constexpr i128 &i128::operator/=(const i128 &other) { return *this = *this / other; }
+constexpr i128 &i128::operator%=(const i128 &other) { return *this = *this % other; }
+constexpr i128 &i128::operator&=(const i128 &other) { return *this = *this & other; }
+constexpr i128 &i128::operator|=(const i128 &other) { return *this = *this | other; }
+constexpr i128 &i128::operator^=(const i128 &other) { return *this = *this ^ other; }
+constexpr i128 &i128::operator<<=(int shift) { return *this = *this << shift; }
+constexpr i128 &i128::operator>>=(int shift) { return *this = *this >> shift; }
+
+constexpr i128 &i128::operator++() { return *this += i128(1); }
+constexpr i128  i128::operator++(int) {
     i128 temp = *this;
     ++*this;
     return temp;
 }
-i128 &i128::operator--() { return *this -= i128(1); }
-i128  i128::operator--(int) {
+constexpr i128 &i128::operator--() { return *this -= i128(1); }
+constexpr i128  i128::operator--(int) {
     i128 temp = *this;
     --*this;
     return temp;
 }
 
-i128 i128::operator+() const { return *this; }
-i128 i128::operator-() const { return i128(0) - *this; }
+constexpr i128 i128::operator+() const { return *this; }
+constexpr i128 i128::operator-() const { return i128(0) - *this; }
 
 #endif  // _$_HX_CORE_M4I128
\ No newline at end of file
@@ -22,101 +22,83 @@
 #include <include/meta/meta.hh>
 #include <include/runtime/runtime.hh>
 #include <include/types/types.hh>
+#include <include/types/builtins/int128.hh>
 
-u128::u128()
+constexpr u128::u128()
     : high(0)
     , low(0) {}
-u128::u128(u64 val)
+constexpr u128::u128(u64 val)
     : high(0)
     , low(val) {}
-u128::u128(u32 val)
+constexpr u128::u128(u32 val)
     : high(0)
     , low(static_cast<u64>(val)) {}
-u128::u128(u16 val)
+constexpr u128::u128(u16 val)
     : high(0)
     , low(static_cast<u64>(val)) {}
-u128::u128(u8 val)
+constexpr u128::u128(u8 val)
     : high(0)
     , low(static_cast<u64>(val)) {}
-u128::u128(i64 val)
+constexpr u128::u128(i64 val)
     : high(0)
     , low(static_cast<u64>(val)) {}
-u128::u128(i32 val)
+constexpr u128::u128(i32 val)
     : high(0)
     , low(static_cast<u64>(static_cast<u32>(val))) {}
-u128::u128(i16 val)
+constexpr u128::u128(i16 val)
     : high(0)
     , low(static_cast<u64>(static_cast<u16>(val))) {}
-u128::u128(i8 val)
+constexpr u128::u128(i8 val)
     : high(0)
     , low(static_cast<u64>(static_cast<u8>(val))) {}
-u128::u128(u64 high, u64 low)
+constexpr u128::u128(u64 high, u64 low)
     : high(high)
     , low(low) {}
-u128::u128(const i128 &x)
+constexpr u128::u128(const i128 &x)
     : high(x.high)
     , low(x.low) {}
 
-u128 u128::operator+(const u128 &other) const {
+constexpr u128 u128::operator+(const u128 &other) const {
     u64 sum_low  = low + other.low;
     u64 carry    = (sum_low < low) ? 1 : 0;
     u64 sum_high = high + other.high + carry;
     return {sum_high, sum_low};
 }
 
-u128 u128::operator-(const u128 &other) const {
+constexpr u128 u128::operator-(const u128 &other) const {
     u64 diff_low  = low - other.low;
     u64 borrow    = (diff_low > low) ? 1 : 0;
     u64 diff_high = high - other.high - borrow;
     return {diff_high, diff_low};
 }
 
-u128 u128::operator*(const u128 &other) const {
-    u128 p1       = mul_u64_to_u128(low, other.low);
-    u128 p2       = mul_u64_to_u128(low, other.high);
-    u128 p3       = mul_u64_to_u128(high, other.low);
-    u64  high_sum = p1.high + p2.low + p3.low;
-    return {high_sum, p1.low};
+constexpr u128 u128::operator*(const u128 &other) const {
+    const auto p = helix::std::Int128::__internal::mul({high, low}, {other.high, other.low});
+    return {p.high, p.low};
 }
 
-u128 u128::operator/(const u128 &divisor) const {
+constexpr u128 u128::operator/(const u128 &divisor) const {
     if (divisor.high == 0 && divisor.low == 0)
         return u128(0);
-    u128 quotient  = 0;
-    u128 remainder = 0;
-    for (int i = 127; i >= 0; --i) {
-        u64 carry      = (remainder.low >> 63) & 1;
-        remainder.low  = (remainder.low << 1) | ((high >> (i / 64)) & (1ULL << (i % 64)) ? 1 : 0);
-        remainder.high = (remainder.high << 1) | carry;
-        if (remainder >= divisor) {
-            remainder = remainder - divisor;
-            quotient  = quotient | (u128(1) << i);
-        }
-    }
-    return quotient;
+    const auto q = helix::std::Int128::__internal::divmod({high, low}, {divisor.high, divisor.low});
+    return {q.quot.high, q.quot.low};
 }
 
-u128 u128::operator%(const u128 &divisor) const {
+constexpr u128 u128::operator%(const u128 &divisor) const {
     if (divisor.high == 0 && divisor.low == 0)
         return u128(0);
-    u128 remainder = 0;
-    for (int i = 127; i >= 0; --i) {
-        u64 carry      = (remainder.low >> 63) & 1;
-        remainder.low  = (remainder.low << 1) | ((high >> (i / 64)) & (1ULL << (i % 64)) ? 1 : 0);
-        remainder.high = (remainder.high << 1) | carry;
-        if (remainder >= divisor) {
-            remainder = remainder - divisor;
-        }
-    }
-    return remainder;
+    const auto q = helix::std::Int128::__internal::divmod({high, low}, {divisor.high, divisor.low});
+    return {q.rem.high, q.rem.low};
 }
 
-u128 u128::operator&(const u128 &other) const { return {high & other.high, low & other.low}; }
-u128 u128::operator|(const u128 &other) const { return {high | other.high, low | other.low}; }
-u128 u128::operator^(const u128 &other) const { return {high ^ other.high, low ^ other.low}; }
-u128 u128::operator~() const { return {~high, ~low}; }
+constexpr u128 u128::operator&(const u128 &other) const { return {high & other.high, low & other.low}; }
+constexpr u128 u128::operator|(const u128 &other) const { return {high | other.high, low | other.low}; }
+constexpr u128 u128::operator^(const u128 &other) const { return {high ^ other.high, low ^ other.low}; }
+constexpr u128 u128::operator~() const { return {~high, ~low}; }
 
-u128 u128::operator<<(int shift) const {
+constexpr u128 u128::operator<<(int shift) const {
+    if (shift <= 0)
+        return *this;
     if (shift >= 128)
         return u128(0);
     if (shift >= 64)
@@ -127,7 +109,9 @@ u128 u128::operator<<(int shift) const {
     return {new_high, new_low};
 }
 
-u128 u128::operator>>(int shift) const {
+constexpr u128 u128::operator>>(int shift) const {
+    if (shift <= 0)
+        return *this;
     if (shift >= 128)
         return u128(0);
     if (shift >= 64)
@@ -138,70 +122,50 @@ u128 u128::operator>>(int shift) const {
     return {new_high, new_low};
 }
 
-bool u128::operator==(const u128 &other) const { return high == other.high && low == other.low; }
-bool u128::operator!=(const u128 &other) const { return !(*this == other); }
-bool u128::operator<(const u128 &other) const {
+constexpr bool u128::operator==(const u128 &other) const { return high == other.high && low == other.low; }
+constexpr bool u128::operator!=(const u128 &other) const { return !(*this == other); }
+constexpr bool u128::operator<(const u128 &other) const {
     return high < other.high || (high == other.high && low < other.low);
 }
-bool u128::operator>(const u128 &other) const { return other < *this; }
-bool u128::operator<=(const u128 &other) const { return !(*this > other); }
-bool u128::operator>=(const u128 &other) const { return !(*this < other); }
+constexpr bool u128::operator>(const u128 &other) const { return other < *this; }
+constexpr bool u128::operator<=(const u128 &other) const { return !(*this > other); }
+constexpr bool u128::operator>=(const u128 &other) const { return !(*this < other); }
 
-u128 &u128::operator=(const u128 &other) {
+constexpr u128 &u128::operator=(const u128 &other) {
     high = other.high;
     low  = other.low;
     return *this;
 }
-u128 &u128::operator+=(const u128 &other) { return *this = *this + other; }
-u128 &u128::operator-=(const u128 &other) { return *this = *this - other; }
-u128 &u128::operator*=(const u128 &other) { return *this = *this * other; }
-u128 &u128::operator/=(const u128 &other) { return *this = *this / other; }
-u128 &u128::operator%=(const u128 &other) { return *this = *this % other; }
-u128 &u128::operator&=(const u128 &other) { return *this = *this & other; }
-u128 &u128::operator|=(const u128 &other) { return *this = *this | other; }
-u128 &u128::operator^=(const u128 &other) { return *this = *this ^ other; }
-u128 &u128::operator<<=(int shift) { return *this = *this << shift; }
-u128 &u128::operator>>=(int shift) { return *this = *this >> shift; }
-
-u128 &u128::operator++() { return *this += u128(1); }
-u128  u128::operator++(int) {
+constexpr u128 &u128::operator+=(const u128 &other) { return *this = *this + other; }
+constexpr u128 &u128::operator-=(const u128 &other) { return *this = *this - other; }
+constexpr u128 &u128::operator*=(const u128 &other) { return *this = *this * other; }
+constexpr u128 &u128::operator/=(const u128 &other) { return *this = *this / other; }
+constexpr u128 &u128::operator%=(const u128 &other) { return *this = *this % other; }
+constexpr u128 &u128::operator&=(const u128 &other) { return *this = *this & other; }
+constexpr u128 &u128::operator|=(const u128 &other) { return *this = *this | other; }
+constexpr u128 &u128::operator^=(const u128 &other) { return *this = *this ^ other; }
+constexpr u128 &u128::operator<<=(int shift) { return *this = *this << shift; }
+constexpr u128 &u128::operator>>=(int shift) { return *this = *this >> shift; }
+
+constexpr u128 &u128::operator++() { return *this += u128(1); }
+constexpr u128  u128::operator++(int) {
     u128 temp = *this;
     ++*this;
     return temp;
 }
-u128 &u128::operator--() { return *this -= u128(1); }
-u128  u128::operator--(int) {
+constexpr u128 &u128::operator--() { return *this -= u128(1); }
+constexpr u128  u128::operator--(int) {
     u128 temp = *this;
     --*this;
     return temp;
 }
 
-u128 u128::operator+() const { return *this; }
-u128 u128::operator-() const { return u128(0) - *this; }
-
-u128 u128::mul_u64_to_u128(u64 a, u64 b) {
-    u32 a0    = a & 0xFFFFFFFF;
-    u32 a1    = a >> 32;
-    u32 b0    = b & 0xFFFFFFFF;
-    u32 b1    = b >> 32;
-    u64 p00   = static_cast<u64>(a0) * b0;
-    u64 p01   = static_cast<u64>(a0) * b1;
-    u64 p10   = static_cast<u64>(a1) * b0;
-    u64 p11   = static_cast<u64>(a1) * b1;
-    u64 low   = p00;
-    u64 carry = 0;
-    u64 sum1  = low + ((p01 & 0xFFFFFFFF) << 32);
-    if (sum1 < low)
-        carry += 1;
-    low = sum1;
-    carry += p01 >> 32;
-    u64 sum2 = low + ((p10 & 0xFFFFFFFF) << 32);
-    if (sum2 < low)
-        carry += 1;
-    low = sum2;
-    carry += p10 >> 32;
-    u64 high = p11 + carry;
-    return {high, low};
+constexpr u128 u128::operator+() const { return *this; }
+constexpr u128 u128::operator-() const { return u128(0) - *this; }
+
+constexpr u128 u128::mul_u64_to_u128(u64 a, u64 b) {
+    const auto p = helix::std::Int128::__internal::mul_64x64(a, b);
+    return {p.high, p.low};
 }
 
 #endif  // _$_HX_CORE_M4U128
\ No newline at end of file
@@ -20,45 +20,30 @@
 
 #include "bitset.hh"
 
-H_NAMESPACE_BEGIN
-
-// constexpr u256 operator"" _u256(const char* str, unsigned long len) noexcept {
-//     return u256::from_cstr(str, len);
-// }
+/// 256-bit integers: four 64-bit words, most significant first, backed by the limb arithmetic
+/// of the composite `__BitSet`
+using u256 = helix::__BitSet<helix::__BitSet<unsigned long long>,
+                             helix::__BitSet<unsigned long long>,
+                             helix::__BitSet<unsigned long long>,
+                             helix::__BitSet<unsigned long long>>;
+using i256 = helix::__BitSet<helix::__BitSet<signed long long>,
+                             helix::__BitSet<signed long long>,
+                             helix::__BitSet<signed long long>,
+                             helix::__BitSet<signed long long>>;
+
+static_assert(u256::bits() == 256 && i256::bits() == 256, "u256 and i256 must be 256 bits wide");
 
-// constexpr i256 operator"" _i256(const char* str, unsigned long len) noexcept {
-//     bool negative = false;
-//     unsigned long start = 0;
-//     if(len > 0 && str[0] == '-') {
-//         negative = true;
-//         start = 1;
-//     }
-//     u256 abs_val = u256::from_cstr(str + start, len - start);
-//     i256 signed_val = u256_to_i256(abs_val);
-//     // We avoid ambiguity in unary minus by subtracting from zero.
-//     return negative ? (i256() - signed_val) : signed_val;
-// }
+H_NAMESPACE_BEGIN
 
-// // Overload for u256 when the literal fits in an unsigned long long.
-// constexpr u256 operator"" _u256(unsigned long long v) noexcept {
-//     return u256(
-//         static_cast<u64>(0),
-//         static_cast<u64>(0),
-//         static_cast<u64>(0),
-//         static_cast<u64>(v)
-//     );
-// }
+constexpr u256 operator""_u256(const char *str) noexcept {
+    return u256::from_cstr(str, std::Reflection::cstr_length(str));
+}
 
-// // Overload for i256 when the literal fits in an unsigned long long.
-// constexpr i256 operator"" _i256(unsigned long long v) noexcept {
-//     return i256(
-//         static_cast<i64>(0),
-//         static_cast<i64>(0),
-//         static_cast<i64>(0),
-//         static_cast<i64>(v)
-//     );
-// }
+// a leading minus is applied to the literal's value, so `str` only holds the magnitude
+constexpr i256 operator""_i256(const char *str) noexcept {
+    return i256::from_cstr(str, std::Reflection::cstr_length(str));
+}
 
-H_STD_NAMESPACE_END
+H_NAMESPACE_END
 
 #endif  // _$_HX_CORE_M7256_BIT
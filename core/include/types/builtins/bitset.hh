@@ -22,6 +22,7 @@
 #include <include/runtime/__panic/panic_fwd.hh>
 #include <include/meta/traits.hh>
 #include <include/meta/enable_if.hh>
+#include <include/types/builtins/limbs.hh>
 #include <include/types/builtins/size_t.hh>
 #include <include/types/builtins/primitives.hh>
 #include <include/types/builtins/num_data.hh>
@@ -93,6 +94,9 @@ struct __BitSet<T> {
 #endif
     }
 
+    // Storage width in bits, which the composite forms lay out their parts by.
+    static constexpr unsigned width = sizeof(T) * 8;
+
     // Total digits/bits (as defined in __NumData)
     HELIX_FORCE_INLINE static constexpr unsigned bits() noexcept { return __NumData<T>::digits; }
 
@@ -426,264 +430,219 @@ struct __BitSet<T> {
 // -----------------------------------------------------------------------------
 // Composite __BitSet for Multiple Numeric Types
 // -----------------------------------------------------------------------------
+// The value is head:tail with the head most significant. Arithmetic flattens both operands
+// into 64-bit limbs (limbs.hh) and writes the result back, so a 256-bit multiply is sixteen
+// 64x64 products instead of 256 shifted adds. When Head is signed the top bit is the sign.
 template <typename Head, typename... Tail>
 struct __BitSet<__BitSet<Head>, __BitSet<Tail>...> {
-    __BitSet<Head>    head;
-    __BitSet<Tail...> tail;
+    using tail_type = __BitSet<__BitSet<Tail>...>;
+
+    static constexpr unsigned width      = sizeof(Head) * 8 + tail_type::width;
+    static constexpr usize    limb_count = (width + 63) / 64;
+    using limb_type                      = std::Limbs::__internal::limbs<limb_count>;
+
+    __BitSet<Head> head;
+    tail_type      tail;
 
     HELIX_FORCE_INLINE constexpr __BitSet()
         : head(0)
         , tail() {}
 
+    // A single value is widened to the full width (sign-extended when Head is signed).
     HELIX_FORCE_INLINE constexpr __BitSet(Head h)
-        : head(h)
-        , tail() {}
+        : __BitSet(from_limbs(widen(h))) {}
 
     HELIX_FORCE_INLINE constexpr __BitSet(Head h, Tail... t)
         : head(h)
         , tail(t...) {}
 
-#define NARROWING_WARNING_PUSH                                                               \
-    _Pragma("GCC diagnostic push") _Pragma("GCC diagnostic warning \"-Wnarrowing\"")         \
-        _Pragma("clang diagnostic push") _Pragma("clang diagnostic warning \"-Wnarrowing\"") \
-            _Pragma("warning(push)") _Pragma("warning(1 : 4244)")  // MSVC: possible loss of data
-
-#define NARROWING_WARNING_POP \
-    _Pragma("GCC diagnostic pop") _Pragma("clang diagnostic pop") _Pragma("warning(pop)")
-
-    // Signed conversions
-    HELIX_FORCE_INLINE constexpr explicit operator signed char() const noexcept {
-        NARROWING_WARNING_PUSH
-        signed char result = static_cast<signed char>(tail) +
-                             (static_cast<signed char>(head) << __BitSet<Tail...>::bits());
-        NARROWING_WARNING_POP
-        return result;
-    }
-
-    HELIX_FORCE_INLINE constexpr explicit operator signed short() const noexcept {
-        NARROWING_WARNING_PUSH
-        signed short result = static_cast<signed short>(tail) +
-                              (static_cast<signed short>(head) << __BitSet<Tail...>::bits());
-        NARROWING_WARNING_POP
-        return result;
-    }
-
-    HELIX_FORCE_INLINE constexpr explicit operator signed int() const noexcept {
-        NARROWING_WARNING_PUSH
-        signed int result = static_cast<signed int>(tail) +
-                            (static_cast<signed int>(head) << __BitSet<Tail...>::bits());
-        NARROWING_WARNING_POP
-        return result;
-    }
-
-    HELIX_FORCE_INLINE constexpr explicit operator signed long() const noexcept {
-        NARROWING_WARNING_PUSH
-        signed long result = static_cast<signed long>(tail) +
-                             (static_cast<signed long>(head) << __BitSet<Tail...>::bits());
-        NARROWING_WARNING_POP
-        return result;
-    }
-
-    HELIX_FORCE_INLINE constexpr explicit operator signed long long() const noexcept {
-        NARROWING_WARNING_PUSH
-        signed long long result =
-            static_cast<signed long long>(tail) +
-            (static_cast<signed long long>(head) << __BitSet<Tail...>::bits());
-        NARROWING_WARNING_POP
-        return result;
-    }
-
-    // Unsigned conversions
-    HELIX_FORCE_INLINE constexpr explicit operator unsigned char() const noexcept {
-        NARROWING_WARNING_PUSH
-        unsigned char result = static_cast<unsigned char>(tail) +
-                               (static_cast<unsigned char>(head) << __BitSet<Tail...>::bits());
-        NARROWING_WARNING_POP
-        return result;
+    // ── Limb View ──
+    // Writes the bits of every part into `w`, starting at bit `offset`.
+    HELIX_FORCE_INLINE constexpr void pack(u64 *w, usize offset) const noexcept {
+        if constexpr (sizeof...(Tail) == 1) {
+            std::Limbs::__internal::put(w, offset, tail.value);
+        } else {
+            tail.pack(w, offset);
+        }
+        std::Limbs::__internal::put(w, offset + tail_type::width, head.value);
     }
-
-    HELIX_FORCE_INLINE constexpr explicit operator unsigned short() const noexcept {
-        NARROWING_WARNING_PUSH
-        unsigned short result = static_cast<unsigned short>(tail) +
-                                (static_cast<unsigned short>(head) << __BitSet<Tail...>::bits());
-        NARROWING_WARNING_POP
-        return result;
+    HELIX_FORCE_INLINE constexpr void unpack(const u64 *w, usize offset) noexcept {
+        if constexpr (sizeof...(Tail) == 1) {
+            tail.value = std::Limbs::__internal::get<decltype(tail.value)>(w, offset);
+        } else {
+            tail.unpack(w, offset);
+        }
+        head.value = std::Limbs::__internal::get<Head>(w, offset + tail_type::width);
     }
 
-    HELIX_FORCE_INLINE constexpr explicit operator unsigned int() const noexcept {
-        NARROWING_WARNING_PUSH
-        unsigned int result = static_cast<unsigned int>(tail) +
-                              (static_cast<unsigned int>(head) << __BitSet<Tail...>::bits());
-        NARROWING_WARNING_POP
+    // The value as limbs; bits above `width` repeat the sign (or are zero when unsigned).
+    [[nodiscard]] HELIX_FORCE_INLINE constexpr limb_type limbs() const noexcept {
+        limb_type result;
+        pack(result.w, 0);
+        if constexpr (is_signed && width % 64 != 0) {
+            constexpr unsigned used = width % 64;
+            if ((result.w[limb_count - 1] >> (used - 1)) & 1) {
+                result.w[limb_count - 1] |= ~u64(0) << used;
+            }
+        }
         return result;
     }
-
-    HELIX_FORCE_INLINE constexpr explicit operator unsigned long() const noexcept {
-        NARROWING_WARNING_PUSH
-        unsigned long result = static_cast<unsigned long>(tail) +
-                               (static_cast<unsigned long>(head) << __BitSet<Tail...>::bits());
-        NARROWING_WARNING_POP
+    [[nodiscard]] HELIX_FORCE_INLINE static constexpr __BitSet
+    from_limbs(const limb_type &limbs) noexcept {
+        __BitSet result;
+        result.unpack(limbs.w, 0);
         return result;
     }
 
-    HELIX_FORCE_INLINE constexpr explicit operator unsigned long long() const noexcept {
-        NARROWING_WARNING_PUSH
-        unsigned long long result =
-            static_cast<unsigned long long>(tail) +
-            (static_cast<unsigned long long>(head) << __BitSet<Tail...>::bits());
-        NARROWING_WARNING_POP
-        return result;
+    // Narrowing conversions keep the low bits, like the built-in integers.
+    template <typename U,
+              typename = std::Meta::enable_if<libcxx::is_integral_v<U> &&
+                                              !libcxx::is_same_v<U, bool>>>
+    HELIX_FORCE_INLINE constexpr explicit operator U() const noexcept {
+        return static_cast<U>(limbs().w[0]);
     }
 
-#undef NARROWING_WARNING_PUSH
-#undef NARROWING_WARNING_POP
-
     // Total bits = bits in head + bits in tail.
-    HELIX_FORCE_INLINE static constexpr unsigned bits() noexcept {
-        return __BitSet<Head>::digits + __BitSet<Tail...>::bits();
-    }
+    HELIX_FORCE_INLINE static constexpr unsigned bits() noexcept { return width; }
 
     // Get and set a bit (bit 0 is the least-significant, living in the tail).
     [[nodiscard]] HELIX_FORCE_INLINE constexpr bool get_bit(unsigned idx) const noexcept {
-        constexpr unsigned tail_bits = __BitSet<Tail...>::bits();
-        if (idx < tail_bits) {
-            return tail.get_bit(idx);
-        }
-        return ((head >> (idx - tail_bits)) & __BitSet(1));
+        return (limbs().w[idx / 64] >> (idx % 64)) & 1;
     }
     HELIX_FORCE_INLINE constexpr void set_bit(unsigned idx, bool b) noexcept {
-        constexpr unsigned tail_bits = __BitSet<Tail...>::bits();
-        if (idx < tail_bits) {
-            tail.set_bit(idx, b);
+        limb_type w = limbs();
+        if (b) {
+            w.w[idx / 64] |= u64(1) << (idx % 64);
         } else {
-            unsigned bitpos = idx - tail_bits;
-            if (b) {
-                head |= (Head(1) << bitpos);
-            } else {
-                head &= ~(Head(1) << bitpos);
-            }
+            w.w[idx / 64] &= ~(u64(1) << (idx % 64));
         }
+        unpack(w.w, 0);
     }
 
     // ── Arithmetic Operators ──
     HELIX_FORCE_INLINE constexpr __BitSet operator+(const __BitSet &other) const noexcept {
-        __BitSet result;
-        result.tail = tail + other.tail;
-        bool carry  = (result.tail < tail);
-        result.head = head + other.head + __BitSet(carry ? 1 : 0);
-        return result;
+        return from_limbs(std::Limbs::__internal::add(limbs(), other.limbs()));
     }
     HELIX_FORCE_INLINE constexpr __BitSet &operator+=(const __BitSet &other) noexcept {
         *this = *this + other;
         return *this;
     }
     HELIX_FORCE_INLINE constexpr __BitSet operator-(const __BitSet &other) const noexcept {
-        __BitSet result;
-        bool     borrow = (tail < other.tail);
-        result.tail     = tail - other.tail;
-        result.head     = head - other.head - __BitSet<decltype(head.value)>(borrow ? 1 : 0);
-        return result;
+        return from_limbs(std::Limbs::__internal::sub(limbs(), other.limbs()));
     }
     HELIX_FORCE_INLINE constexpr __BitSet &operator-=(const __BitSet &other) noexcept {
         *this = *this - other;
         return *this;
     }
+    HELIX_FORCE_INLINE constexpr __BitSet operator-() const noexcept {
+        return from_limbs(std::Limbs::__internal::negate(limbs()));
+    }
     HELIX_FORCE_INLINE constexpr __BitSet operator*(const __BitSet &other) const noexcept {
-        __BitSet result(0);
-        unsigned total_bits = bits();
-        for (unsigned i = 0; i < total_bits; i++) {
-            if (other.get_bit(i)) {
-                result += (*this << i);
-            }
-        }
-        return result;
+        return from_limbs(std::Limbs::__internal::mul(limbs(), other.limbs()));
     }
     HELIX_FORCE_INLINE constexpr __BitSet &operator*=(const __BitSet &other) noexcept {
         *this = *this * other;
         return *this;
     }
-    HELIX_FORCE_INLINE constexpr __BitSet operator/(const __BitSet &other) const noexcept {
-        __BitSet quotient(0);
-        __BitSet remainder(0);
-        unsigned total_bits = bits();
-        for (long i = total_bits - 1; i >= 0; i--) {
-            remainder = remainder << 1;
-            remainder.set_bit(0, get_bit(i));
-            if (remainder >= other) {
-                remainder -= other;
-                quotient.set_bit(i, true);
-            }
+
+    // Quotient and remainder truncate toward zero like the built-in integers; dividing by zero
+    // gives zero for both, as u128 does.
+    [[nodiscard]] HELIX_FORCE_INLINE constexpr std::Limbs::__internal::quotient<limb_count>
+    div_rem(const __BitSet &divisor) const noexcept {
+        limb_type n = limbs();
+        limb_type d = divisor.limbs();
+        if (std::Limbs::__internal::is_zero(d)) {
+            return {};
         }
-        return quotient;
+
+        const bool n_negative = is_signed && std::Limbs::__internal::is_negative(n);
+        const bool d_negative = is_signed && std::Limbs::__internal::is_negative(d);
+        if (n_negative) {
+            n = std::Limbs::__internal::negate(n);
+        }
+        if (d_negative) {
+            d = std::Limbs::__internal::negate(d);
+        }
+
+        auto result = std::Limbs::__internal::divmod(n, d);
+        if (n_negative != d_negative) {
+            result.quot = std::Limbs::__internal::negate(result.quot);
+        }
+        if (n_negative) {
+            result.rem = std::Limbs::__internal::negate(result.rem);
+        }
+        return result;
+    }
+    HELIX_FORCE_INLINE constexpr __BitSet operator/(const __BitSet &other) const noexcept {
+        return from_limbs(div_rem(other).quot);
     }
     HELIX_FORCE_INLINE constexpr __BitSet &operator/=(const __BitSet &other) noexcept {
         *this = *this / other;
         return *this;
     }
     HELIX_FORCE_INLINE constexpr __BitSet operator%(const __BitSet &other) const noexcept {
-        __BitSet quotient = *this / other;
-        return *this - (quotient * other);
+        return from_limbs(div_rem(other).rem);
     }
     HELIX_FORCE_INLINE constexpr __BitSet &operator%=(const __BitSet &other) noexcept {
         *this = *this % other;
         return *this;
     }
 
-    // ── Bitwise Operators (elementwise) ──
+    // ── Bitwise Operators ──
     HELIX_FORCE_INLINE constexpr __BitSet operator&(const __BitSet &other) const noexcept {
-        return __BitSet(head & other.head, tail & other.tail);
+        limb_type a = limbs();
+        limb_type b = other.limbs();
+        for (usize i = 0; i < limb_count; ++i) {
+            a.w[i] &= b.w[i];
+        }
+        return from_limbs(a);
     }
     HELIX_FORCE_INLINE constexpr __BitSet operator|(const __BitSet &other) const noexcept {
-        return __BitSet(head | other.head, tail | other.tail);
+        limb_type a = limbs();
+        limb_type b = other.limbs();
+        for (usize i = 0; i < limb_count; ++i) {
+            a.w[i] |= b.w[i];
+        }
+        return from_limbs(a);
     }
     HELIX_FORCE_INLINE constexpr __BitSet operator^(const __BitSet &other) const noexcept {
-        return __BitSet(head ^ other.head, tail ^ other.tail);
+        limb_type a = limbs();
+        limb_type b = other.limbs();
+        for (usize i = 0; i < limb_count; ++i) {
+            a.w[i] ^= b.w[i];
+        }
+        return from_limbs(a);
     }
     HELIX_FORCE_INLINE constexpr __BitSet operator~() const noexcept {
-        return __BitSet(~head, ~tail);
+        limb_type a = limbs();
+        for (usize i = 0; i < limb_count; ++i) {
+            a.w[i] = ~a.w[i];
+        }
+        return from_limbs(a);
     }
     HELIX_FORCE_INLINE constexpr __BitSet &operator&=(const __BitSet &other) noexcept {
-        head &= other.head;
-        tail &= other.tail;
+        *this = *this & other;
         return *this;
     }
     HELIX_FORCE_INLINE constexpr __BitSet &operator|=(const __BitSet &other) noexcept {
-        head |= other.head;
-        tail |= other.tail;
+        *this = *this | other;
         return *this;
     }
     HELIX_FORCE_INLINE constexpr __BitSet &operator^=(const __BitSet &other) noexcept {
-        head ^= other.head;
-        tail ^= other.tail;
+        *this = *this ^ other;
         return *this;
     }
 
-    // ── Shift Operators ──
+    // ── Shift Operators ── (right shifts are arithmetic when Head is signed)
     HELIX_FORCE_INLINE constexpr __BitSet operator<<(unsigned shift) const noexcept {
-        __BitSet result(0);
-        unsigned total_bits = bits();
-        for (unsigned i = 0; i < total_bits; i++) {
-            if (get_bit(i)) {
-                if (i + shift < total_bits) {
-                    result.set_bit(i + shift, true);
-                }
-            }
-        }
-        return result;
+        return from_limbs(std::Limbs::__internal::shl(limbs(), shift));
     }
     HELIX_FORCE_INLINE constexpr __BitSet &operator<<=(unsigned shift) noexcept {
         *this = *this << shift;
         return *this;
     }
     HELIX_FORCE_INLINE constexpr __BitSet operator>>(unsigned shift) const noexcept {
-        __BitSet result(0);
-        unsigned total_bits = bits();
-        for (unsigned i = shift; i < total_bits; i++) {
-            if (get_bit(i)) {
-                result.set_bit(i - shift, true);
-            }
-        }
-        return result;
+        return from_limbs(std::Limbs::__internal::shr(limbs(), shift, is_signed));
     }
     HELIX_FORCE_INLINE constexpr __BitSet &operator>>=(unsigned shift) noexcept {
         *this = *this >> shift;
@@ -710,108 +669,98 @@ struct __BitSet<__BitSet<Head>, __BitSet<Tail>...> {
         return temp;
     }
 
-    // ── Comparison Operators (lexicographical: head first) ──
+    // ── Comparison Operators ──
     HELIX_FORCE_INLINE constexpr bool operator==(const __BitSet &other) const noexcept {
-        return head == other.head && tail == other.tail;
+        return compare(other) == 0;
     }
     HELIX_FORCE_INLINE constexpr bool operator!=(const __BitSet &other) const noexcept {
         return !(*this == other);
     }
     HELIX_FORCE_INLINE constexpr bool operator<(const __BitSet &other) const noexcept {
-        if (head < other.head) {
-            return true;
-        }
-        if (head > other.head) {
-            return false;
-        }
-        return tail < other.tail;
+        return compare(other) < 0;
     }
     HELIX_FORCE_INLINE constexpr bool operator<=(const __BitSet &other) const noexcept {
-        return (*this < other) || (*this == other);
+        return compare(other) <= 0;
     }
     HELIX_FORCE_INLINE constexpr bool operator>(const __BitSet &other) const noexcept {
-        return !(*this <= other);
+        return compare(other) > 0;
     }
     HELIX_FORCE_INLINE constexpr bool operator>=(const __BitSet &other) const noexcept {
-        return !(*this < other);
+        return compare(other) >= 0;
+    }
+    [[nodiscard]] HELIX_FORCE_INLINE constexpr int compare(const __BitSet &other) const noexcept {
+        return std::Limbs::__internal::compare(limbs(), other.limbs(), is_signed);
     }
 
-    static constexpr unsigned digits = __BitSet<Head>::digits + __BitSet<Tail...>::digits;
+    static constexpr unsigned digits = __BitSet<Head>::digits + tail_type::digits;
 
-    HELIX_FORCE_INLINE static constexpr __BitSet max_value() noexcept {
-        return __BitSet(__BitSet<Head>::max_value(), __BitSet<Tail...>::max_value());
-    }
+    static constexpr bool is_signed = libcxx::is_signed_v<Head>;
+    static constexpr bool is_radix  = __BitSet<Head>::is_radix;
+
+    HELIX_FORCE_INLINE static constexpr __BitSet max_value() noexcept { return ~min_value(); }
     HELIX_FORCE_INLINE static constexpr __BitSet min_value() noexcept {
-        return __BitSet(static_cast<Head>(0), __BitSet<Tail...>::min_value());
+        __BitSet result;
+        if constexpr (is_signed) {
+            result.set_bit(width - 1, true);
+        }
+        return result;
     }
 
-    static constexpr bool is_signed = __BitSet<Head>::is_signed;
-    static constexpr bool is_radix  = __BitSet<Head>::is_radix;
-
     HELIX_FORCE_INLINE constexpr __BitSet abs() const noexcept {
-        return __BitSet(head.abs(), tail.abs());
+        return is_signed && std::Limbs::__internal::is_negative(limbs()) ? -*this : *this;
     }
 
     HELIX_FORCE_INLINE constexpr explicit operator bool() const noexcept {
-        return !(*this == __BitSet(0, __BitSet<Tail...>::min));
+        return !std::Limbs::__internal::is_zero(limbs());
     }
 
     // ── Conversion to C-string (narrow) ──
     [[nodiscard]] HELIX_FORCE_INLINE const char *to_cstr() const noexcept {
-        static thread_local char buf[digits + 1];
-        __BitSet                 copy = *this;
-        int                      pos  = 0;
-        __BitSet                 zero(0, __BitSet<Tail...>::min);
-        __BitSet                 ten(10, __BitSet<Tail...>::min);
-        if (copy == zero) {
-            buf[0] = '0';
-            buf[1] = '\0';
-            return buf;
-        }
-        while (copy > zero) {
-            __BitSet rem = copy % ten;
-            copy /= ten;
-            int digit  = static_cast<int>(rem);
-            buf[pos++] = '0' + digit;
-        }
-        for (int i = 0; i < pos / 2; i++) {
-            char tmp         = buf[i];
-            buf[i]           = buf[pos - 1 - i];
-            buf[pos - 1 - i] = tmp;
-        }
-        buf[pos] = '\0';
+        static thread_local char buf[digits + 2];
+        write_decimal(buf);
         return buf;
     }
 
     // ── Conversion to C-string (wide) ──
     [[nodiscard]] HELIX_FORCE_INLINE const wchar_t *to_wcstr() const noexcept {
-        static thread_local wchar_t buf[digits + 1];
-        __BitSet                    copy = *this;
-        int                         pos  = 0;
-        __BitSet                    zero(0, __BitSet<Tail...>::min);
-        __BitSet                    ten(10, __BitSet<Tail...>::min);
-        if (copy == zero) {
-            buf[0] = L'0';
-            buf[1] = L'\0';
-            return buf;
+        static thread_local wchar_t buf[digits + 2];
+        write_decimal(buf);
+        return buf;
+    }
+
+    // Writes the decimal value and a terminator into `buf`, peeling 19 digits per limb division.
+    template <typename C>
+    HELIX_FORCE_INLINE constexpr void write_decimal(C *buf) const noexcept {
+        limb_type  magnitude = limbs();
+        const bool negative  = is_signed && std::Limbs::__internal::is_negative(magnitude);
+        if (negative) {
+            magnitude = std::Limbs::__internal::negate(magnitude);
         }
-        while (copy > zero) {
-            __BitSet rem = copy % ten;
-            copy /= ten;
-            int digit  = static_cast<int>(rem);
-            buf[pos++] = L'0' + digit;
+
+        int pos = 0;
+        do {
+            u64 chunk = std::Limbs::__internal::divmod_1(magnitude, 10000000000000000000ULL);
+            const bool last = std::Limbs::__internal::is_zero(magnitude);
+            for (int i = 0; i < 19 && (!last || chunk != 0 || i == 0); ++i) {
+                buf[pos++] = static_cast<C>('0' + chunk % 10);
+                chunk /= 10;
+            }
+        } while (!std::Limbs::__internal::is_zero(magnitude));
+        if (negative) {
+            buf[pos++] = static_cast<C>('-');
         }
+
         for (int i = 0; i < pos / 2; i++) {
-            wchar_t tmp      = buf[i];
+            C tmp            = buf[i];
             buf[i]           = buf[pos - 1 - i];
             buf[pos - 1 - i] = tmp;
         }
-        buf[pos] = L'\0';
-        return buf;
+        buf[pos] = static_cast<C>('\0');
     }
 
     // ── Parsing from a Narrow C-string ──
-    HELIX_FORCE_INLINE static __BitSet from_cstr(const char *ptr, libcxx::size_t len) noexcept {
+    HELIX_FORCE_INLINE static constexpr __BitSet from_cstr(const char    *ptr,
+                                                           libcxx::size_t len) noexcept {
         int            base  = 10;
         libcxx::size_t start = 0;
         if (len >= 2 && ptr[0] == '0') {
@@ -826,8 +775,8 @@ struct __BitSet<__BitSet<Head>, __BitSet<Tail>...> {
                 start = 1;
             }
         }
-        __BitSet result(0, __BitSet<Tail...>::min);
-        __BitSet base_val(base, __BitSet<Tail...>::min);
+        __BitSet result;
+        __BitSet base_val(static_cast<Head>(base));
         for (libcxx::size_t i = start; i < len; ++i) {
             char c = ptr[i];
             if (c == '_') {
@@ -837,14 +786,14 @@ struct __BitSet<__BitSet<Head>, __BitSet<Tail>...> {
             if (digit < 0) {
                 break;
             }
-            result = result * __BitSet(base, __BitSet<Tail...>::min) +
-                     __BitSet(digit, __BitSet<Tail...>::min);
+            result = base_val * result + __BitSet(static_cast<Head>(digit));
         }
         return result;
     }
 
     // ── Parsing from a Wide C-string ──
-    HELIX_FORCE_INLINE static __BitSet from_cstr(const wchar_t *ptr, libcxx::size_t len) noexcept {
+    HELIX_FORCE_INLINE static constexpr __BitSet from_cstr(const wchar_t *ptr,
+                                                           libcxx::size_t len) noexcept {
         int            base  = 10;
         libcxx::size_t start = 0;
         if (len >= 2 && ptr[0] == L'0') {
@@ -859,8 +808,8 @@ struct __BitSet<__BitSet<Head>, __BitSet<Tail>...> {
                 start = 1;
             }
         }
-        __BitSet result(0, __BitSet<Tail...>::min);
-        __BitSet base_val(base, __BitSet<Tail...>::min);
+        __BitSet result;
+        __BitSet base_val(static_cast<Head>(base));
         for (libcxx::size_t i = start; i < len; ++i) {
             wchar_t c = ptr[i];
             if (c == L'_') {
@@ -870,8 +819,19 @@ struct __BitSet<__BitSet<Head>, __BitSet<Tail>...> {
             if (digit < 0) {
                 break;
             }
-            result = result * __BitSet(base, __BitSet<Tail...>::min) +
-                     __BitSet(digit, __BitSet<Tail...>::min);
+            result = base_val * result + __BitSet(static_cast<Head>(digit));
+        }
+        return result;
+    }
+
+  private:
+    HELIX_FORCE_INLINE static constexpr limb_type widen(Head h) noexcept {
+        limb_type result;
+        result.w[0] = static_cast<u64>(h);
+        if constexpr (libcxx::is_signed_v<Head>) {
+            for (usize i = 1; i < limb_count; ++i) {
+                result.w[i] = h < 0 ? ~u64(0) : 0;
+            }
         }
         return result;
     }
@@ -883,6 +843,10 @@ template class __BitSet<signed int>;
 template class __BitSet<signed long>;
 template class __BitSet<signed long long>;
 template class __BitSet<__BitSet<signed long long>, __BitSet<signed long long>>;
+template class __BitSet<__BitSet<signed long long>,
+                      __BitSet<signed long long>,
+                      __BitSet<signed long long>,
+                      __BitSet<signed long long>>;
 
 template class __BitSet<unsigned char>;
 template class __BitSet<unsigned short>;
@@ -890,6 +854,10 @@ template class __BitSet<unsigned int>;
 template class __BitSet<unsigned long>;
 template class __BitSet<unsigned long long>;
 template class __BitSet<__BitSet<unsigned long long>, __BitSet<unsigned long long>>;
+template class __BitSet<__BitSet<unsigned long long>,
+                      __BitSet<unsigned long long>,
+                      __BitSet<unsigned long long>,
+                      __BitSet<unsigned long long>>;
 
 // -----------------------------------------------------------------------------
 // Non-Member Overloads to Allow Arithmetic with Built-in Types
@@ -16,6 +16,7 @@
 #ifndef _$_HX_CORE_M8BUILTINS
 #define _$_HX_CORE_M8BUILTINS
 
+#include "256_bit.hh"
 #include "literals.hh"
 #include "primitives.hh"
 #include "size_t.hh"
@@ -0,0 +1,206 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///-------------------------------------------------------------------------------- Lib-Helix ---///
+
+#ifndef _$_HX_CORE_M10INT128
+#define _$_HX_CORE_M10INT128
+
+#include <include/config/config.hh>
+
+#include <include/c++/libc++.hh>
+#include <include/types/builtins/primitives.hh>
+
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+/// the arithmetic behind `u128`/`i128`.
+///
+/// with `unsigned __int128` (gcc and clang on 64-bit targets) every operation is the native one,
+/// which compiles to `mul`/`mulx` and the `__udivti3` fast paths. elsewhere the product comes
+/// from `_umul128` or four 32-bit multiplies, and division from `_udiv128` or Knuth's algorithm D
+/// on 32-bit digits; a divisor of 64 bits or more needs one normalized 128-by-64 step. all of it
+/// is `constexpr`: intrinsics are only called outside constant evaluation.
+namespace Int128::__internal {
+struct words {
+    u64 high;
+    u64 low;
+};
+
+struct quotient {
+    words quot;
+    words rem;
+};
+
+namespace portable {
+    constexpr words mul_64x64(u64 a, u64 b) noexcept {
+        const u64 a0 = a & 0xFFFFFFFF, a1 = a >> 32;
+        const u64 b0 = b & 0xFFFFFFFF, b1 = b >> 32;
+        const u64 p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+
+        const u64 mid = (p00 >> 32) + (p01 & 0xFFFFFFFF) + (p10 & 0xFFFFFFFF);
+        return {p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32), (mid << 32) | (p00 & 0xFFFFFFFF)};
+    }
+
+    /// `hi:lo / d` for `hi < d`, so the quotient fits in 64 bits (Hacker's Delight, divlu)
+    constexpr u64 div_128x64(u64 hi, u64 lo, u64 d, u64 &rem) noexcept {
+        constexpr u64 b = u64(1) << 32;
+
+        const int s = libcxx::countl_zero(d);
+        d <<= s;
+        const u64 d1   = d >> 32;
+        const u64 d0   = d & 0xFFFFFFFF;
+        const u64 un32 = s == 0 ? hi : (hi << s) | (lo >> (64 - s));
+        const u64 un10 = lo << s;
+        const u64 un1  = un10 >> 32;
+        const u64 un0  = un10 & 0xFFFFFFFF;
+
+        u64 q1   = un32 / d1;
+        u64 rhat = un32 - q1 * d1;
+        while (q1 >= b || q1 * d0 > ((rhat << 32) | un1)) {
+            --q1;
+            rhat += d1;
+            if (rhat >= b) {
+                break;
+            }
+        }
+
+        const u64 un21 = (un32 << 32) + un1 - q1 * d;
+        u64       q0   = un21 / d1;
+        rhat           = un21 - q0 * d1;
+        while (q0 >= b || q0 * d0 > ((rhat << 32) | un0)) {
+            --q0;
+            rhat += d1;
+            if (rhat >= b) {
+                break;
+            }
+        }
+
+        rem = ((un21 << 32) + un0 - q0 * d) >> s;
+        return (q1 << 32) | q0;
+    }
+
+    constexpr quotient divmod(words n, words d) noexcept {
+        if (d.high == 0) {
+            u64 r = 0;
+            if (n.high < d.low) {
+                return {{0, div_128x64(n.high, n.low, d.low, r)}, {0, r}};
+            }
+            const u64 qh = n.high / d.low;
+            const u64 ql = div_128x64(n.high % d.low, n.low, d.low, r);
+            return {{qh, ql}, {0, r}};
+        }
+
+        // the divisor has 65 bits or more, so the quotient fits in 64: estimate it from the top
+        // 64 bits of the normalized divisor and half the dividend, then correct by at most one
+        const int s  = libcxx::countl_zero(d.high);
+        const u64 v1 = s == 0 ? d.high : (d.high << s) | (d.low >> (64 - s));
+        u64       r  = 0;
+        u64       q  = div_128x64(n.high >> 1, (n.high << 63) | (n.low >> 1), v1, r) >> (63 - s);
+        if (q != 0) {
+            --q;
+        }
+
+        const words p  = mul_64x64(q, d.low);
+        const u64   ph = p.high + q * d.high;
+        words       rm{n.high - ph - static_cast<u64>(n.low < p.low), n.low - p.low};
+        if (rm.high > d.high || (rm.high == d.high && rm.low >= d.low)) {
+            ++q;
+            rm = {rm.high - d.high - static_cast<u64>(rm.low < d.low), rm.low - d.low};
+        }
+        return {{0, q}, rm};
+    }
+}  // namespace portable
+
+constexpr words mul_64x64(u64 a, u64 b) noexcept {
+#if defined(__SIZEOF_INT128__)
+    const auto r = static_cast<unsigned __int128>(a) * b;
+    return {static_cast<u64>(r >> 64), static_cast<u64>(r)};
+#else
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+    if (!libcxx::is_constant_evaluated()) {
+        u64       hi;
+        const u64 lo = _umul128(a, b, &hi);
+        return {hi, lo};
+    }
+#endif
+    return portable::mul_64x64(a, b);
+#endif
+}
+
+/// `hi:lo / d` for `hi < d`, with the remainder in `rem`; one `div` on x86-64
+constexpr u64 div_128x64(u64 hi, u64 lo, u64 d, u64 &rem) noexcept {
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    if (!libcxx::is_constant_evaluated()) {
+        u64 q;
+        __asm__("divq %[d]" : "=a"(q), "=d"(rem) : [d] "r"(d), "a"(lo), "d"(hi));
+        return q;
+    }
+#elif defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64) && _MSC_VER >= 1920
+    if (!libcxx::is_constant_evaluated()) {
+        return _udiv128(hi, lo, d, &rem);
+    }
+#endif
+#if defined(__SIZEOF_INT128__)
+    const auto n = (static_cast<unsigned __int128>(hi) << 64) | lo;
+    const auto q = static_cast<u64>(n / d);
+    rem          = lo - q * d;
+    return q;
+#else
+    return portable::div_128x64(hi, lo, d, rem);
+#endif
+}
+
+/// the low 128 bits of `a * b`; the same bits for signed and unsigned operands
+constexpr words mul(words a, words b) noexcept {
+#if defined(__SIZEOF_INT128__)
+    const auto r = ((static_cast<unsigned __int128>(a.high) << 64) | a.low) *
+                   ((static_cast<unsigned __int128>(b.high) << 64) | b.low);
+    return {static_cast<u64>(r >> 64), static_cast<u64>(r)};
+#else
+    const words p = mul_64x64(a.low, b.low);
+    return {p.high + a.low * b.high + a.high * b.low, p.low};
+#endif
+}
+
+/// unsigned `n / d` and `n % d`; `d` must not be zero
+constexpr quotient divmod(words n, words d) noexcept {
+#if defined(__SIZEOF_INT128__)
+    const auto nn = (static_cast<unsigned __int128>(n.high) << 64) | n.low;
+    const auto dd = (static_cast<unsigned __int128>(d.high) << 64) | d.low;
+    const auto q  = nn / dd;
+    const auto r  = nn - q * dd;
+    return {{static_cast<u64>(q >> 64), static_cast<u64>(q)},
+            {static_cast<u64>(r >> 64), static_cast<u64>(r)}};
+#else
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64) && _MSC_VER >= 1920
+    if (!libcxx::is_constant_evaluated() && d.high == 0) {
+        u64       r  = 0;
+        const u64 qh = n.high / d.low;
+        const u64 ql = _udiv128(n.high % d.low, n.low, d.low, &r);
+        return {{qh, ql}, {0, r}};
+    }
+#endif
+    return portable::divmod(n, d);
+#endif
+}
+}  // namespace Int128::__internal
+
+H_STD_NAMESPACE_END
+H_NAMESPACE_END
+
+#endif  // _$_HX_CORE_M10INT128
@@ -0,0 +1,323 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///-------------------------------------------------------------------------------- Lib-Helix ---///
+
+#ifndef _$_HX_CORE_M5LIMBS
+#define _$_HX_CORE_M5LIMBS
+
+#include <include/config/config.hh>
+
+#include <include/c++/libc++.hh>
+#include <include/types/builtins/int128.hh>
+#include <include/types/builtins/primitives.hh>
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+/// fixed-width arithmetic on little-endian arrays of 64-bit limbs, the backend of the composite
+/// `__BitSet` integers.
+///
+/// every operation wraps modulo 2^(64 * N) like the built-in unsigned types. add and subtract
+/// are carry chains (`__builtin_addcll`/`__builtin_subcll` where the compiler has them),
+/// multiplication is schoolbook on 64x64->128 products, which for the handful of limbs a
+/// `__BitSet` holds beats Karatsuba, and division is Knuth's algorithm D (TAOCP 4.3.1) with one
+/// 128-by-64 `div` per quotient limb. all of it is `constexpr`; builtins and inline assembly are
+/// only used outside constant evaluation.
+namespace Limbs::__internal {
+template <usize N>
+struct limbs {
+    u64 w[N]{};
+};
+
+template <usize N>
+struct quotient {
+    limbs<N> quot;
+    limbs<N> rem;
+};
+
+HELIX_FORCE_INLINE constexpr u64 addc(u64 a, u64 b, u64 carry_in, u64 &carry_out) noexcept {
+#if __has_builtin(__builtin_addcll)
+    if (!libcxx::is_constant_evaluated()) {
+        unsigned long long carry  = 0;
+        const u64          result = __builtin_addcll(a, b, carry_in, &carry);
+        carry_out                 = carry;
+        return result;
+    }
+#endif
+    const u64 sum    = a + b;
+    const u64 result = sum + carry_in;
+    carry_out        = static_cast<u64>(sum < a) | static_cast<u64>(result < sum);
+    return result;
+}
+
+HELIX_FORCE_INLINE constexpr u64 subb(u64 a, u64 b, u64 borrow_in, u64 &borrow_out) noexcept {
+#if __has_builtin(__builtin_subcll)
+    if (!libcxx::is_constant_evaluated()) {
+        unsigned long long borrow = 0;
+        const u64          result = __builtin_subcll(a, b, borrow_in, &borrow);
+        borrow_out                = borrow;
+        return result;
+    }
+#endif
+    const u64 diff   = a - b;
+    const u64 result = diff - borrow_in;
+    borrow_out       = static_cast<u64>(a < b) | static_cast<u64>(diff < borrow_in);
+    return result;
+}
+
+template <usize N>
+constexpr limbs<N> add(const limbs<N> &a, const limbs<N> &b) noexcept {
+    limbs<N> r;
+    u64      carry = 0;
+    for (usize i = 0; i < N; ++i) {
+        r.w[i] = addc(a.w[i], b.w[i], carry, carry);
+    }
+    return r;
+}
+
+template <usize N>
+constexpr limbs<N> sub(const limbs<N> &a, const limbs<N> &b) noexcept {
+    limbs<N> r;
+    u64      borrow = 0;
+    for (usize i = 0; i < N; ++i) {
+        r.w[i] = subb(a.w[i], b.w[i], borrow, borrow);
+    }
+    return r;
+}
+
+template <usize N>
+constexpr limbs<N> negate(const limbs<N> &a) noexcept {
+    return sub(limbs<N>{}, a);
+}
+
+/// the low `N` limbs of `a * b`; the same bits for signed and unsigned operands
+template <usize N>
+constexpr limbs<N> mul(const limbs<N> &a, const limbs<N> &b) noexcept {
+    limbs<N> r;
+    for (usize i = 0; i < N; ++i) {
+        if (a.w[i] == 0) {
+            continue;
+        }
+        u64 carry = 0;
+        for (usize j = 0; i + j < N; ++j) {
+            const auto p  = Int128::__internal::mul_64x64(a.w[i], b.w[j]);
+            u64        c1 = 0, c2 = 0;
+            r.w[i + j]    = addc(r.w[i + j], p.low, 0, c1);
+            r.w[i + j]    = addc(r.w[i + j], carry, 0, c2);
+            carry         = p.high + c1 + c2;
+        }
+    }
+    return r;
+}
+
+template <usize N>
+constexpr bool is_zero(const limbs<N> &a) noexcept {
+    u64 any = 0;
+    for (usize i = 0; i < N; ++i) {
+        any |= a.w[i];
+    }
+    return any == 0;
+}
+
+template <usize N>
+constexpr bool is_negative(const limbs<N> &a) noexcept {
+    return (a.w[N - 1] >> 63) != 0;
+}
+
+/// -1, 0 or 1; with `is_signed` the top bit is the sign
+template <usize N>
+constexpr int compare(const limbs<N> &a, const limbs<N> &b, bool is_signed) noexcept {
+    if (is_signed && is_negative(a) != is_negative(b)) {
+        return is_negative(a) ? -1 : 1;
+    }
+    for (usize i = N; i-- != 0;) {
+        if (a.w[i] != b.w[i]) {
+            return a.w[i] < b.w[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+/// `a << shift`; bits shifted past the top are dropped
+template <usize N>
+constexpr limbs<N> shl(const limbs<N> &a, usize shift) noexcept {
+    limbs<N> r;
+    if (shift >= N * 64) {
+        return r;
+    }
+    const usize limb = shift / 64;
+    const usize bit  = shift % 64;
+    for (usize i = N; i-- > limb;) {
+        r.w[i] = a.w[i - limb] << bit;
+        if (bit != 0 && i > limb) {
+            r.w[i] |= a.w[i - limb - 1] >> (64 - bit);
+        }
+    }
+    return r;
+}
+
+/// `a >> shift`, filling with the sign bit when `arithmetic` is set
+template <usize N>
+constexpr limbs<N> shr(const limbs<N> &a, usize shift, bool arithmetic) noexcept {
+    const u64 fill = arithmetic && is_negative(a) ? ~u64(0) : 0;
+    limbs<N>  r;
+    if (shift >= N * 64) {
+        for (usize i = 0; i < N; ++i) {
+            r.w[i] = fill;
+        }
+        return r;
+    }
+    const usize limb = shift / 64;
+    const usize bit  = shift % 64;
+    for (usize i = 0; i < N; ++i) {
+        const u64 lo = i + limb < N ? a.w[i + limb] : fill;
+        const u64 hi = i + limb + 1 < N ? a.w[i + limb + 1] : fill;
+        r.w[i]       = bit == 0 ? lo : (lo >> bit) | (hi << (64 - bit));
+    }
+    return r;
+}
+
+/// divides `a` by a single limb in place and returns the remainder; `d` must not be zero
+template <usize N>
+constexpr u64 divmod_1(limbs<N> &a, u64 d) noexcept {
+    u64 rem = 0;
+    for (usize i = N; i-- != 0;) {
+        a.w[i] = Int128::__internal::div_128x64(rem, a.w[i], d, rem);
+    }
+    return rem;
+}
+
+/// unsigned `n / d` and `n % d`; `d` must not be zero
+template <usize N>
+constexpr quotient<N> divmod(const limbs<N> &n, const limbs<N> &d) noexcept {
+    usize dn = N;
+    while (dn > 1 && d.w[dn - 1] == 0) {
+        --dn;
+    }
+    usize nn = N;
+    while (nn > 1 && n.w[nn - 1] == 0) {
+        --nn;
+    }
+
+    quotient<N> out;
+    if (dn == 1) {
+        out.quot     = n;
+        out.rem.w[0] = divmod_1(out.quot, d.w[0]);
+        return out;
+    }
+    if (nn < dn || compare(n, d, false) < 0) {
+        out.rem = n;
+        return out;
+    }
+
+    // normalize so the divisor's top limb has its high bit set, which keeps every quotient
+    // estimate at most two above the true digit
+    const int s = libcxx::countl_zero(d.w[dn - 1]);
+    u64       v[N]{};
+    u64       u[N + 1]{};
+    for (usize i = dn; i-- != 0;) {
+        v[i] = (d.w[i] << s) | (s != 0 && i != 0 ? d.w[i - 1] >> (64 - s) : 0);
+    }
+    u[nn] = s != 0 ? n.w[nn - 1] >> (64 - s) : 0;
+    for (usize i = nn; i-- != 0;) {
+        u[i] = (n.w[i] << s) | (s != 0 && i != 0 ? n.w[i - 1] >> (64 - s) : 0);
+    }
+
+    const u64 vt = v[dn - 1];
+    const u64 vs = v[dn - 2];
+    for (usize j = nn - dn + 1; j-- != 0;) {
+        u64  qhat = 0;
+        u64  rhat = 0;
+        bool big  = false;
+        if (u[j + dn] >= vt) {
+            qhat = ~u64(0);
+            rhat = u[j + dn - 1] + vt;
+            big  = rhat < vt;
+        } else {
+            qhat = Int128::__internal::div_128x64(u[j + dn], u[j + dn - 1], vt, rhat);
+        }
+        while (!big) {
+            const auto p = Int128::__internal::mul_64x64(qhat, vs);
+            if (p.high < rhat || (p.high == rhat && p.low <= u[j + dn - 2])) {
+                break;
+            }
+            --qhat;
+            rhat += vt;
+            big = rhat < vt;
+        }
+
+        u64 carry  = 0;
+        u64 borrow = 0;
+        for (usize i = 0; i < dn; ++i) {
+            const auto p  = Int128::__internal::mul_64x64(qhat, v[i]);
+            u64        c  = 0;
+            const u64  lo = addc(p.low, carry, 0, c);
+            carry         = p.high + c;
+            u[i + j]      = subb(u[i + j], lo, borrow, borrow);
+        }
+        u[j + dn] = subb(u[j + dn], carry, borrow, borrow);
+
+        if (borrow != 0) {
+            // the estimate was one too large: add the divisor back
+            --qhat;
+            u64 c = 0;
+            for (usize i = 0; i < dn; ++i) {
+                u[i + j] = addc(u[i + j], v[i], c, c);
+            }
+            u[j + dn] += c;
+        }
+        out.quot.w[j] = qhat;
+    }
+
+    for (usize i = 0; i < dn; ++i) {
+        out.rem.w[i] = s != 0 ? (u[i] >> s) | (u[i + 1] << (64 - s)) : u[i];
+    }
+    return out;
+}
+
+/// writes the low `width` bits of an integer into `w` starting at bit `offset`
+template <typename T>
+constexpr void put(u64 *w, usize offset, T value) noexcept {
+    constexpr usize width = sizeof(T) * 8;
+    using U               = libcxx::make_unsigned_t<T>;
+
+    const u64   bits  = static_cast<u64>(static_cast<U>(value));
+    const usize limb  = offset / 64;
+    const usize shift = offset % 64;
+    w[limb] |= bits << shift;
+    if (shift + width > 64) {
+        w[limb + 1] |= bits >> (64 - shift);
+    }
+}
+
+/// reads an integer of type `T` back from bit `offset` of `w`
+template <typename T>
+constexpr T get(const u64 *w, usize offset) noexcept {
+    constexpr usize width = sizeof(T) * 8;
+    using U               = libcxx::make_unsigned_t<T>;
+
+    const usize limb  = offset / 64;
+    const usize shift = offset % 64;
+    u64         bits  = w[limb] >> shift;
+    if (shift + width > 64) {
+        bits |= w[limb + 1] << (64 - shift);
+    }
+    return static_cast<T>(static_cast<U>(bits));
+}
+}  // namespace Limbs::__internal
+
+H_STD_NAMESPACE_END
+H_NAMESPACE_END
+
+#endif  // _$_HX_CORE_M5LIMBS
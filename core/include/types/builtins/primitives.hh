@@ -126,66 +126,66 @@ struct u128 {
     u64 low;
 
     // Constructors
-    inline u128();
-    inline u128(u64 val);
-    inline u128(u32 val);
-    inline u128(u16 val);
-    inline u128(u8 val);
-    inline u128(i64 val);
-    inline u128(i32 val);
-    inline u128(i16 val);
-    inline u128(i8 val);
-    inline u128(u64 high, u64 low);
-    inline u128(const i128 &x);
+    constexpr u128();
+    constexpr u128(u64 val);
+    constexpr u128(u32 val);
+    constexpr u128(u16 val);
+    constexpr u128(u8 val);
+    constexpr u128(i64 val);
+    constexpr u128(i32 val);
+    constexpr u128(i16 val);
+    constexpr u128(i8 val);
+    constexpr u128(u64 high, u64 low);
+    constexpr u128(const i128 &x);
 
     // Arithmetic Operators
-    inline u128 operator+(const u128 &other) const;
-    inline u128 operator-(const u128 &other) const;
-    inline u128 operator*(const u128 &other) const;
-    inline u128 operator/(const u128 &divisor) const;
-    inline u128 operator%(const u128 &divisor) const;
+    constexpr u128 operator+(const u128 &other) const;
+    constexpr u128 operator-(const u128 &other) const;
+    constexpr u128 operator*(const u128 &other) const;
+    constexpr u128 operator/(const u128 &divisor) const;
+    constexpr u128 operator%(const u128 &divisor) const;
 
     // Bitwise Operators
-    inline u128 operator&(const u128 &other) const;
-    inline u128 operator|(const u128 &other) const;
-    inline u128 operator^(const u128 &other) const;
-    inline u128 operator~() const;
-    inline u128 operator<<(int shift) const;
-    inline u128 operator>>(int shift) const;
+    constexpr u128 operator&(const u128 &other) const;
+    constexpr u128 operator|(const u128 &other) const;
+    constexpr u128 operator^(const u128 &other) const;
+    constexpr u128 operator~() const;
+    constexpr u128 operator<<(int shift) const;
+    constexpr u128 operator>>(int shift) const;
 
     // Comparison Operators
-    inline bool operator==(const u128 &other) const;
-    inline bool operator!=(const u128 &other) const;
-    inline bool operator<(const u128 &other) const;
-    inline bool operator>(const u128 &other) const;
-    inline bool operator<=(const u128 &other) const;
-    inline bool operator>=(const u128 &other) const;
+    constexpr bool operator==(const u128 &other) const;
+    constexpr bool operator!=(const u128 &other) const;
+    constexpr bool operator<(const u128 &other) const;
+    constexpr bool operator>(const u128 &other) const;
+    constexpr bool operator<=(const u128 &other) const;
+    constexpr bool operator>=(const u128 &other) const;
 
     // Assignment Operators
-    inline u128 &operator=(const u128 &other);
-    inline u128 &operator+=(const u128 &other);
-    inline u128 &operator-=(const u128 &other);
-    inline u128 &operator*=(const u128 &other);
-    inline u128 &operator/=(const u128 &other);
-    inline u128 &operator%=(const u128 &other);
-    inline u128 &operator&=(const u128 &other);
-    inline u128 &operator|=(const u128 &other);
-    inline u128 &operator^=(const u128 &other);
-    inline u128 &operator<<=(int shift);
-    inline u128 &operator>>=(int shift);
+    constexpr u128 &operator=(const u128 &other);
+    constexpr u128 &operator+=(const u128 &other);
+    constexpr u128 &operator-=(const u128 &other);
+    constexpr u128 &operator*=(const u128 &other);
+    constexpr u128 &operator/=(const u128 &other);
+    constexpr u128 &operator%=(const u128 &other);
+    constexpr u128 &operator&=(const u128 &other);
+    constexpr u128 &operator|=(const u128 &other);
+    constexpr u128 &operator^=(const u128 &other);
+    constexpr u128 &operator<<=(int shift);
+    constexpr u128 &operator>>=(int shift);
 
     // Increment/Decrement Operators
-    inline u128 &operator++();
-    inline u128  operator++(int);
-    inline u128 &operator--();
-    inline u128  operator--(int);
+    constexpr u128 &operator++();
+    constexpr u128  operator++(int);
+    constexpr u128 &operator--();
+    constexpr u128  operator--(int);
 
     // Unary Operators
-    inline u128 operator+() const;
-    inline u128 operator-() const;
+    constexpr u128 operator+() const;
+    constexpr u128 operator-() const;
 
   private:
-    inline static u128 mul_u64_to_u128(u64 a, u64 b);
+    static constexpr u128 mul_u64_to_u128(u64 a, u64 b);
 };
 
 struct i128 {
@@ -193,66 +193,66 @@ struct i128 {
     u64 low;
 
     // Constructors
-    inline i128();
-    inline i128(u64 val);
-    inline i128(u32 val);
-    inline i128(u16 val);
-    inline i128(u8 val);
-    inline i128(i64 val);
-    inline i128(i32 val);
-    inline i128(i16 val);
-    inline i128(i8 val);
-    inline i128(const u128 &x);
-    inline i128(u64 high, u64 low);
+    constexpr i128();
+    constexpr i128(u64 val);
+    constexpr i128(u32 val);
+    constexpr i128(u16 val);
+    constexpr i128(u8 val);
+    constexpr i128(i64 val);
+    constexpr i128(i32 val);
+    constexpr i128(i16 val);
+    constexpr i128(i8 val);
+    constexpr i128(const u128 &x);
+    constexpr i128(u64 high, u64 low);
 
     // Helper Functions
-    inline bool is_negative() const;
+    constexpr bool is_negative() const;
 
     // Arithmetic Operators
-    inline i128 operator+(const i128 &other) const;
-    inline i128 operator-(const i128 &other) const;
-    inline i128 operator*(const i128 &other) const;
-    inline i128 operator/(const i128 &other) const;
-    inline i128 operator%(const i128 &other) const;
+    constexpr i128 operator+(const i128 &other) const;
+    constexpr i128 operator-(const i128 &other) const;
+    constexpr i128 operator*(const i128 &other) const;
+    constexpr i128 operator/(const i128 &other) const;
+    constexpr i128 operator%(const i128 &other) const;
 
     // Bitwise Operators
-    inline i128 operator&(const i128 &other) const;
-    inline i128 operator|(const i128 &other) const;
-    inline i128 operator^(const i128 &other) const;
-    inline i128 operator~() const;
-    inline i128 operator<<(int shift) const;
-    inline i128 operator>>(int shift) const;
+    constexpr i128 operator&(const i128 &other) const;
+    constexpr i128 operator|(const i128 &other) const;
+    constexpr i128 operator^(const i128 &other) const;
+    constexpr i128 operator~() const;
+    constexpr i128 operator<<(int shift) const;
+    constexpr i128 operator>>(int shift) const;
 
     // Comparison Operators
-    inline bool operator==(const i128 &other) const;
-    inline bool operator!=(const i128 &other) const;
-    inline bool operator<(const i128 &other) const;
-    inline bool operator>(const i128 &other) const;
-    inline bool operator<=(const i128 &other) const;
-    inline bool operator>=(const i128 &other) const;
+    constexpr bool operator==(const i128 &other) const;
+    constexpr bool operator!=(const i128 &other) const;
+    constexpr bool operator<(const i128 &other) const;
+    constexpr bool operator>(const i128 &other) const;
+    constexpr bool operator<=(const i128 &other) const;
+    constexpr bool operator>=(const i128 &other) const;
 
     // Assignment Operators
-    inline i128 &operator=(const i128 &other);
-    inline i128 &operator+=(const i128 &other);
-    inline i128 &operator-=(const i128 &other);
-    inline i128 &operator*=(const i128 &other);
-    inline i128 &operator/=(const i128 &other);
-    inline i128 &operator%=(const i128 &other);
-    inline i128 &operator&=(const i128 &other);
-    inline i128 &operator|=(const i128 &other);
-    inline i128 &operator^=(const i128 &other);
-    inline i128 &operator<<=(int shift);
-    inline i128 &operator>>=(int shift);
+    constexpr i128 &operator=(const i128 &other);
+    constexpr i128 &operator+=(const i128 &other);
+    constexpr i128 &operator-=(const i128 &other);
+    constexpr i128 &operator*=(const i128 &other);
+    constexpr i128 &operator/=(const i128 &other);
+    constexpr i128 &operator%=(const i128 &other);
+    constexpr i128 &operator&=(const i128 &other);
+    constexpr i128 &operator|=(const i128 &other);
+    constexpr i128 &operator^=(const i128 &other);
+    constexpr i128 &operator<<=(int shift);
+    constexpr i128 &operator>>=(int shift);
 
     // Increment/Decrement Operators
-    inline i128 &operator++();
-    inline i128  operator++(int);
-    inline i128 &operator--();
-    inline i128  operator--(int);
+    constexpr i128 &operator++();
+    constexpr i128  operator++(int);
+    constexpr i128 &operator--();
+    constexpr i128  operator--(int);
 
     // Unary Operators
-    inline i128 operator+() const;
-    inline i128 operator-() const;
+    constexpr i128 operator+() const;
+    constexpr i128 operator-() const;
 };
 
 #endif  // _$_HX_CORE_M10PRIMITIVES
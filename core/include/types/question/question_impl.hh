@@ -20,6 +20,7 @@
 
 #include <include/runtime/__panic/frame.hh>  // THIS is the issue
 #include <include/types/builtins/primitives.hh>
+#include <include/types/question/question_storage.hh>
 
 H_NAMESPACE_BEGIN
 
@@ -73,6 +74,9 @@ H_NAMESPACE_BEGIN
 ///   - `bool is_null() const`: Checks if the state is `Null`.
 ///   - `bool is_err() const`: Checks if the state is `Error`.
 ///   - `bool is_err(const type_info *type) const`: Checks if the error matches a specific type.
+///   - `bool is_err(TypeId type) const`: The same, as one pointer compare when the error was
+///     raised in this module (see `TypeId`); this is what `==`, `$contains` and casts to an
+///     error type use.
 /// - **Value Access**:
 ///   - `T operator*()`: Retrieves the value, or throws if null or in an error state.
 ///   - `T operator$cast(T * /*unused*/) const`: Casts the value to `T`, or throws if null or in an
@@ -89,6 +93,8 @@ H_NAMESPACE_BEGIN
 /// 2. Errors are always stored as `std::Panic::Frame` objects.
 /// 3. Errors and values are managed with proper resource allocation and destruction to avoid leaks
 ///    or undefined behavior.
+/// 4. The error costs one pointer: `sizeof(T?)` is `sizeof(T)` plus at most a word (see
+///    `Question::__internal::Storage`).
 ///
 /// ### Related
 /// - `std::Panic::Frame`: Represents the error state.
@@ -128,31 +134,19 @@ H_NAMESPACE_BEGIN
 template <class T>
 class $question {
   private:
-    enum class $State : char { Value, Null, Error };
+    using $State = std::Question::__internal::Kind;
 
-    union $StorageT {
-        mutable std::Panic::Frame error;
-        mutable T                 value;
-
-        constexpr $StorageT() noexcept
-            : value() {}
-        ~$StorageT() noexcept {}
-    };
-
-    mutable $State state = $State::Null;
-    $StorageT      data;
+    mutable std::Question::__internal::Storage<T> data;
 
     [[nodiscard]] bool is_null() const noexcept;
     [[nodiscard]] bool is_err() const noexcept;
     [[nodiscard]] bool is_err(const libcxx::type_info *type) const noexcept;
+    [[nodiscard]] bool is_err(std::TypeId type) const noexcept;
 
     void set_value(const T &value);
     void set_value(T &&value);
     void set_err(std::Panic::Frame &&error);
-    void set_err(std::Panic::Frame &error);
-
-    void delete_error() noexcept;
-    void delete_value() noexcept;
+    void set_err(const std::Panic::Frame &error);
 
   public:
     /// ------------------------------- Constructors (Null) -------------------------------
@@ -205,6 +199,10 @@ class $question {
     [[nodiscard]] operator T();
 };
 
+// the error is one pointer beside the value
+static_assert(sizeof($question<usize>) == sizeof(usize) + sizeof(void *));
+static_assert(sizeof($question<i32>) == sizeof(void *) + sizeof(void *));
+
 H_NAMESPACE_END
 
 #endif  // _$_HX_CORE_M13QUESTION_IMPL
@@ -0,0 +1,125 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///-------------------------------------------------------------------------------- Lib-Helix ---///
+
+#ifndef _$_HX_CORE_M16QUESTION_STORAGE
+#define _$_HX_CORE_M16QUESTION_STORAGE
+
+#include <include/config/config.hh>
+
+#include <include/c++/libc++.hh>
+#include <include/meta/type_properties.hh>
+#include <include/runtime/__memory/memory.hh>
+#include <include/runtime/__panic/frame.hh>
+#include <include/types/builtins/primitives.hh>
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+/// how a `T?` lays out its three states: a union of `T` and the frame plus a one-byte state.
+/// a `Panic::Frame` is a single pointer to its shared block, so the error never costs more than
+/// a word beside the value, and `sizeof(T?) == sizeof(T) + alignof(T)` for anything at least
+/// pointer-sized. there is no niche for pointers: any bit pattern, `MAP_FAILED` and other
+/// sentinels included, is a valid `*T?` value
+namespace Question::__internal {
+enum class Kind : char { Value, Null, Error };
+
+template <class T>
+class Storage {
+  public:
+    Storage() noexcept {}
+
+    Storage(const Storage &other) { copy_from(other); }
+    Storage(Storage &&other) noexcept { move_from(other); }
+
+    Storage &operator=(const Storage &other) {
+        if (this != &other) {
+            reset();
+            copy_from(other);
+        }
+        return *this;
+    }
+
+    Storage &operator=(Storage &&other) noexcept {
+        if (this != &other) {
+            reset();
+            move_from(other);
+        }
+        return *this;
+    }
+
+    ~Storage() { reset(); }
+
+    [[nodiscard]] Kind kind() const noexcept { return state; }
+
+    [[nodiscard]] T       &value() noexcept { return val; }
+    [[nodiscard]] const T &value() const noexcept { return val; }
+
+    [[nodiscard]] const Panic::Frame &error() const noexcept { return frame; }
+
+    template <typename... Args>
+    void emplace_value(Args &&...args) {
+        reset();
+        new (&val) T(std::Memory::forward<Args>(args)...);
+        state = Kind::Value;
+    }
+
+    void emplace_error(Panic::Frame &&error) noexcept {
+        reset();
+        new (&frame) Panic::Frame(std::Memory::move(error));
+        state = Kind::Error;
+    }
+
+    void reset() noexcept {
+        if (state == Kind::Error) {
+            frame.~Frame();
+        } else if (state == Kind::Value) {
+            if constexpr (std::Meta::is_destructible<T>) {
+                val.~T();
+            }
+        }
+        state = Kind::Null;
+    }
+
+  private:
+    void copy_from(const Storage &other) {
+        if (other.state == Kind::Value) {
+            emplace_value(other.val);
+        } else if (other.state == Kind::Error) {
+            emplace_error(Panic::Frame(other.frame));
+        }
+    }
+
+    void move_from(Storage &other) noexcept {
+        if (other.state == Kind::Value) {
+            emplace_value(std::Memory::move(other.val));
+        } else if (other.state == Kind::Error) {
+            emplace_error(std::Memory::move(other.frame));
+            other.reset();
+        }
+    }
+
+    union {
+        Panic::Frame frame;
+        T            val;
+    };
+    Kind state = Kind::Null;
+};
+
+}  // namespace Question::__internal
+
+H_STD_NAMESPACE_END
+H_NAMESPACE_END
+
+#endif  // _$_HX_CORE_M16QUESTION_STORAGE
@@ -41,6 +41,8 @@ class basic {
     using slice_t     = slice;
     using slice_vec   = vec<slice_t>;
     using char_vec    = vec<CharT>;
+    using split_range = typename String::slice<CharT, Traits>::split_range;
+    using lines_range = typename String::slice<CharT, Traits>::lines_range;
 
   private:
     string_t data;
@@ -118,7 +120,6 @@ class basic {
             size_t next = data.find(old_str.data, pos);
 
             if (next == npos) {
-                result.append(data, pos, data.size() - pos);
                 break;
             }
 
@@ -128,7 +129,7 @@ class basic {
             replacements++;
         }
 
-        if (pos < data.size() && (count == npos || replacements < count)) {
+        if (pos < data.size()) {
             result.append(data, pos, data.size() - pos);
         }
 
@@ -200,6 +201,9 @@ class basic {
     string_t       &raw_string() noexcept { return data; }
     const string_t &raw_string() const noexcept { return data; }
 
+    /// feeds the code units to `hasher`, in place; agrees with `std::hash` and `Hash::StringHash`
+    void hash(Hash::Hasher *hasher) const noexcept { hasher->write(*this); }
+
     // Slice Conversion
     operator slice_t() const noexcept { return slice_t(data.data(), data.size()); }
     slice_t operator$cast(const slice_t * /* p */) const noexcept {
@@ -215,6 +219,11 @@ class basic {
     vec<basic> split(const basic &delim, slice_t::Operation op = slice_t::Operation::Remove) const;
     vec<basic> split_lines() const;
 
+    // Lazy Splitting (views into this string, no allocation)
+    split_range split_iter(slice_t            delim,
+                           slice_t::Operation op = slice_t::Operation::Remove) const noexcept;
+    lines_range lines_iter() const noexcept;
+
     // Search
     bool starts_with(const basic &needle) const noexcept { return data.starts_with(needle.data); }
     bool starts_with(CharT c) const noexcept { return data.starts_with(c); }
@@ -276,32 +285,26 @@ using string32 = std::String::basic<char32_t>;
 
 H_NAMESPACE_END
 
+// hashed in place over `raw()`/`size()`, so a string and a slice of the same text hash alike
 namespace std {
-template <>
-struct hash<helix::string> {
-    size_t operator()(const helix::string &s) const noexcept {
-        return std::hash<std::wstring>{}(std::wstring(s.raw(), s.size()));
-    }
-};
-
-template <>
-struct hash<helix::nstring> {
-    size_t operator()(const helix::nstring &s) const noexcept {
-        return std::hash<std::string>{}(std::string(s.raw(), s.size()));
+template <typename CharT, typename Traits>
+struct hash<helix::std::String::basic<CharT, Traits>> {
+    size_t operator()(const helix::std::String::basic<CharT, Traits> &s) const noexcept {
+        return static_cast<size_t>(helix::std::Hash::text(s));
     }
 };
 
 template <>
 struct hash<helix::string::slice> {
     size_t operator()(const helix::string::slice &s) const noexcept {
-        return std::hash<std::wstring>{}(std::wstring(s.raw(), s.size()));
+        return static_cast<size_t>(helix::std::Hash::text(s));
     }
 };
 
 template <>
 struct hash<helix::nstring::slice> {
     size_t operator()(const helix::nstring::slice &s) const noexcept {
-        return std::hash<std::string>{}(std::string(s.raw(), s.size()));
+        return static_cast<size_t>(helix::std::Hash::text(s));
     }
 };
 }  // namespace std
@@ -0,0 +1,624 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///-------------------------------------------------------------------------------- Lib-Helix ---///
+
+#ifndef _$_HX_CORE_M6SEARCH
+#define _$_HX_CORE_M6SEARCH
+
+#include <include/config/config.hh>
+
+#include <include/c++/libc++.hh>
+#include <include/types/builtins/builtins.hh>
+
+#if !defined(HELIX_DISABLE_SIMD) && \
+    (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#   define _HELIX_SEARCH_X86 1
+#   include <immintrin.h>
+#   if defined(_MSC_VER) && !defined(__clang__)
+#       include <intrin.h>
+#   endif
+#else
+#   define _HELIX_SEARCH_X86 0
+#endif
+
+#if _HELIX_SEARCH_X86 && (defined(__GNUC__) || defined(__clang__))
+#   define _HELIX_TARGET_SSE42 __attribute__((target("sse4.2")))
+#   define _HELIX_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#   define _HELIX_TARGET_SSE42
+#   define _HELIX_TARGET_AVX2
+#endif
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+/// search kernels shared by `String::slice` and `String::basic`.
+///
+/// every entry point has the same contract as the matching `basic_string_view` member and
+/// returns `npos` when nothing matches. the `*_of` family uses a broadcast-compare over 16/32
+/// byte blocks when the set is small and a 256-bit membership bitmap otherwise; substring search
+/// filters candidates on the first and last needle unit and only then compares the middle.
+/// the widest instruction set the cpu supports is picked once, on first use.
+namespace String::__internal::search {
+inline constexpr usize npos = static_cast<usize>(-1);
+
+/// sets larger than this are matched with the scalar bitmap instead of per-unit broadcasts
+inline constexpr usize max_simd_set = 32;
+
+enum class Isa : u8 { Scalar, SSE42, AVX2 };
+
+template <typename CharT>
+inline constexpr bool simd_unit = sizeof(CharT) == 1 || sizeof(CharT) == 2 || sizeof(CharT) == 4;
+
+template <typename CharT>
+HELIX_FORCE_INLINE constexpr u32 unit(CharT c) noexcept {
+    return static_cast<u32>(static_cast<libcxx::make_unsigned_t<CharT>>(c));
+}
+
+template <typename CharT>
+HELIX_FORCE_INLINE bool equal(const CharT *a, const CharT *b, usize len) noexcept {
+    return len == 0 || libcxx::memcmp(a, b, len * sizeof(CharT)) == 0;
+}
+
+inline Isa detect_isa() noexcept {
+#if _HELIX_SEARCH_X86 && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return Isa::AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.2")) {
+        return Isa::SSE42;
+    }
+#elif _HELIX_SEARCH_X86 && defined(_MSC_VER)
+    int info[4] = {};
+    __cpuid(info, 0);
+    const int max_leaf = info[0];
+
+    __cpuid(info, 1);
+    const bool sse42   = (info[2] & (1 << 20)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx     = (info[2] & (1 << 28)) != 0;
+
+    if (max_leaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6) {
+        __cpuidex(info, 7, 0);
+        if ((info[1] & (1 << 5)) != 0) {
+            return Isa::AVX2;
+        }
+    }
+    if (sse42) {
+        return Isa::SSE42;
+    }
+#endif
+    return Isa::Scalar;
+}
+
+inline Isa active_isa() noexcept {
+    static const Isa isa = detect_isa();
+    return isa;
+}
+
+namespace scalar {
+    /// membership test for a set of code units: units below 256 hit a bitmap, wider units fall
+    /// back to a scan of the original set (only when the set actually contains any).
+    template <typename CharT>
+    class char_set {
+        u64          bits[4] = {};
+        const CharT *set;
+        usize        len;
+        bool         wide = false;
+
+      public:
+        char_set(const CharT *set, usize len) noexcept
+            : set(set)
+            , len(len) {
+            for (usize i = 0; i < len; ++i) {
+                const u32 u = unit(set[i]);
+                if (u < 256) {
+                    bits[u >> 6] |= u64(1) << (u & 63);
+                } else {
+                    wide = true;
+                }
+            }
+        }
+
+        HELIX_FORCE_INLINE bool contains(CharT c) const noexcept {
+            const u32 u = unit(c);
+            if (u < 256) {
+                return ((bits[u >> 6] >> (u & 63)) & 1) != 0;
+            }
+            if (!wide) {
+                return false;
+            }
+            for (usize i = 0; i < len; ++i) {
+                if (set[i] == c) {
+                    return true;
+                }
+            }
+            return false;
+        }
+    };
+
+    template <typename CharT>
+    usize find_first_of(
+        const CharT *s, usize n, usize pos, const CharT *set, usize m, bool negate) noexcept {
+        const char_set<CharT> cs(set, m);
+        for (usize i = pos; i < n; ++i) {
+            if (cs.contains(s[i]) != negate) {
+                return i;
+            }
+        }
+        return npos;
+    }
+
+    /// `end` is exclusive: positions `[0, end)` are searched, last to first
+    template <typename CharT>
+    usize find_last_of(
+        const CharT *s, usize end, const CharT *set, usize m, bool negate) noexcept {
+        const char_set<CharT> cs(set, m);
+        for (usize i = end; i > 0; --i) {
+            if (cs.contains(s[i - 1]) != negate) {
+                return i - 1;
+            }
+        }
+        return npos;
+    }
+
+    template <typename CharT>
+    usize find(const CharT *s, usize n, const CharT *nd, usize m, usize pos) noexcept {
+        return libcxx::basic_string_view<CharT>(s, n).find(nd, pos, m);
+    }
+
+    /// candidates are `[0, end)`, checked last to first; requires `end + m - 1 <= n`
+    template <typename CharT>
+    usize rfind(const CharT *s, usize end, const CharT *nd, usize m) noexcept {
+        for (usize i = end; i > 0; --i) {
+            if (s[i - 1] == nd[0] && equal(s + i - 1, nd, m)) {
+                return i - 1;
+            }
+        }
+        return npos;
+    }
+}  // namespace scalar
+
+#if _HELIX_SEARCH_X86
+namespace sse42 {
+    constexpr usize block = 16;
+
+    template <usize W>
+    HELIX_FORCE_INLINE _HELIX_TARGET_SSE42 __m128i broadcast(u32 v) noexcept {
+        if constexpr (W == 1) {
+            return _mm_set1_epi8(static_cast<char>(v));
+        } else if constexpr (W == 2) {
+            return _mm_set1_epi16(static_cast<short>(v));
+        } else {
+            return _mm_set1_epi32(static_cast<int>(v));
+        }
+    }
+
+    template <usize W>
+    HELIX_FORCE_INLINE _HELIX_TARGET_SSE42 __m128i eq(__m128i a, __m128i b) noexcept {
+        if constexpr (W == 1) {
+            return _mm_cmpeq_epi8(a, b);
+        } else if constexpr (W == 2) {
+            return _mm_cmpeq_epi16(a, b);
+        } else {
+            return _mm_cmpeq_epi32(a, b);
+        }
+    }
+
+    template <typename CharT>
+    HELIX_FORCE_INLINE _HELIX_TARGET_SSE42 __m128i load(const CharT *p) noexcept {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    }
+
+    HELIX_FORCE_INLINE _HELIX_TARGET_SSE42 u32 movemask(__m128i v) noexcept {
+        return static_cast<u32>(_mm_movemask_epi8(v));
+    }
+
+    template <typename CharT>
+    _HELIX_TARGET_SSE42 usize find_first_of(
+        const CharT *s, usize n, usize pos, const CharT *set, usize m, bool negate) noexcept {
+        constexpr usize W = sizeof(CharT);
+        constexpr usize L = block / W;
+
+        __m128i needles[max_simd_set];
+        for (usize j = 0; j < m; ++j) {
+            needles[j] = broadcast<W>(unit(set[j]));
+        }
+
+        usize i = pos;
+        for (; i + L <= n; i += L) {
+            const __m128i blk = load(s + i);
+            __m128i       acc = _mm_setzero_si128();
+            for (usize j = 0; j < m; ++j) {
+                acc = _mm_or_si128(acc, eq<W>(blk, needles[j]));
+            }
+
+            const u32 mask = negate ? (~movemask(acc) & 0xFFFFU) : movemask(acc);
+            if (mask != 0) {
+                return i + static_cast<usize>(libcxx::countr_zero(mask)) / W;
+            }
+        }
+
+        return scalar::find_first_of(s, n, i, set, m, negate);
+    }
+
+    template <typename CharT>
+    _HELIX_TARGET_SSE42 usize find_last_of(
+        const CharT *s, usize end, const CharT *set, usize m, bool negate) noexcept {
+        constexpr usize W = sizeof(CharT);
+        constexpr usize L = block / W;
+
+        __m128i needles[max_simd_set];
+        for (usize j = 0; j < m; ++j) {
+            needles[j] = broadcast<W>(unit(set[j]));
+        }
+
+        for (; end >= L; end -= L) {
+            const __m128i blk = load(s + end - L);
+            __m128i       acc = _mm_setzero_si128();
+            for (usize j = 0; j < m; ++j) {
+                acc = _mm_or_si128(acc, eq<W>(blk, needles[j]));
+            }
+
+            const u32 mask = negate ? (~movemask(acc) & 0xFFFFU) : movemask(acc);
+            if (mask != 0) {
+                return end - L + (static_cast<usize>(libcxx::bit_width(mask)) - 1) / W;
+            }
+        }
+
+        return scalar::find_last_of(s, end, set, m, negate);
+    }
+
+    template <typename CharT>
+    _HELIX_TARGET_SSE42 usize find(
+        const CharT *s, usize n, const CharT *nd, usize m, usize pos) noexcept {
+        constexpr usize W    = sizeof(CharT);
+        constexpr usize L    = block / W;
+        constexpr u32   lane = (1U << W) - 1;
+
+        const __m128i first = broadcast<W>(unit(nd[0]));
+        const __m128i last  = broadcast<W>(unit(nd[m - 1]));
+
+        usize i = pos;
+        for (; i + m - 1 + L <= n; i += L) {
+            u32 mask = movemask(
+                _mm_and_si128(eq<W>(load(s + i), first), eq<W>(load(s + i + m - 1), last)));
+
+            while (mask != 0) {
+                const usize at = static_cast<usize>(libcxx::countr_zero(mask)) / W;
+                if (equal(s + i + at + 1, nd + 1, m - 2)) {
+                    return i + at;
+                }
+                mask &= ~(lane << (at * W));
+            }
+        }
+
+        for (; i + m <= n; ++i) {
+            if (s[i] == nd[0] && equal(s + i, nd, m)) {
+                return i;
+            }
+        }
+        return npos;
+    }
+
+    template <typename CharT>
+    _HELIX_TARGET_SSE42 usize rfind(const CharT *s, usize end, const CharT *nd, usize m) noexcept {
+        constexpr usize W    = sizeof(CharT);
+        constexpr usize L    = block / W;
+        constexpr u32   lane = (1U << W) - 1;
+
+        const __m128i first = broadcast<W>(unit(nd[0]));
+        const __m128i last  = broadcast<W>(unit(nd[m - 1]));
+
+        for (; end >= L; end -= L) {
+            const usize base = end - L;
+            u32         mask = movemask(_mm_and_si128(eq<W>(load(s + base), first),
+                                                      eq<W>(load(s + base + m - 1), last)));
+
+            while (mask != 0) {
+                const usize at = (static_cast<usize>(libcxx::bit_width(mask)) - 1) / W;
+                if (equal(s + base + at + 1, nd + 1, m - 2)) {
+                    return base + at;
+                }
+                mask &= ~(lane << (at * W));
+            }
+        }
+
+        return scalar::rfind(s, end, nd, m);
+    }
+}  // namespace sse42
+
+namespace avx2 {
+    constexpr usize block = 32;
+
+    template <usize W>
+    HELIX_FORCE_INLINE _HELIX_TARGET_AVX2 __m256i broadcast(u32 v) noexcept {
+        if constexpr (W == 1) {
+            return _mm256_set1_epi8(static_cast<char>(v));
+        } else if constexpr (W == 2) {
+            return _mm256_set1_epi16(static_cast<short>(v));
+        } else {
+            return _mm256_set1_epi32(static_cast<int>(v));
+        }
+    }
+
+    template <usize W>
+    HELIX_FORCE_INLINE _HELIX_TARGET_AVX2 __m256i eq(__m256i a, __m256i b) noexcept {
+        if constexpr (W == 1) {
+            return _mm256_cmpeq_epi8(a, b);
+        } else if constexpr (W == 2) {
+            return _mm256_cmpeq_epi16(a, b);
+        } else {
+            return _mm256_cmpeq_epi32(a, b);
+        }
+    }
+
+    template <typename CharT>
+    HELIX_FORCE_INLINE _HELIX_TARGET_AVX2 __m256i load(const CharT *p) noexcept {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+    }
+
+    HELIX_FORCE_INLINE _HELIX_TARGET_AVX2 u32 movemask(__m256i v) noexcept {
+        return static_cast<u32>(_mm256_movemask_epi8(v));
+    }
+
+    template <typename CharT>
+    _HELIX_TARGET_AVX2 usize find_first_of(
+        const CharT *s, usize n, usize pos, const CharT *set, usize m, bool negate) noexcept {
+        constexpr usize W = sizeof(CharT);
+        constexpr usize L = block / W;
+
+        __m256i needles[max_simd_set];
+        for (usize j = 0; j < m; ++j) {
+            needles[j] = broadcast<W>(unit(set[j]));
+        }
+
+        usize i = pos;
+        for (; i + L <= n; i += L) {
+            const __m256i blk = load(s + i);
+            __m256i       acc = _mm256_setzero_si256();
+            for (usize j = 0; j < m; ++j) {
+                acc = _mm256_or_si256(acc, eq<W>(blk, needles[j]));
+            }
+
+            const u32 mask = negate ? ~movemask(acc) : movemask(acc);
+            if (mask != 0) {
+                return i + static_cast<usize>(libcxx::countr_zero(mask)) / W;
+            }
+        }
+
+        return scalar::find_first_of(s, n, i, set, m, negate);
+    }
+
+    template <typename CharT>
+    _HELIX_TARGET_AVX2 usize find_last_of(
+        const CharT *s, usize end, const CharT *set, usize m, bool negate) noexcept {
+        constexpr usize W = sizeof(CharT);
+        constexpr usize L = block / W;
+
+        __m256i needles[max_simd_set];
+        for (usize j = 0; j < m; ++j) {
+            needles[j] = broadcast<W>(unit(set[j]));
+        }
+
+        for (; end >= L; end -= L) {
+            const __m256i blk = load(s + end - L);
+            __m256i       acc = _mm256_setzero_si256();
+            for (usize j = 0; j < m; ++j) {
+                acc = _mm256_or_si256(acc, eq<W>(blk, needles[j]));
+            }
+
+            const u32 mask = negate ? ~movemask(acc) : movemask(acc);
+            if (mask != 0) {
+                return end - L + (static_cast<usize>(libcxx::bit_width(mask)) - 1) / W;
+            }
+        }
+
+        return scalar::find_last_of(s, end, set, m, negate);
+    }
+
+    template <typename CharT>
+    _HELIX_TARGET_AVX2 usize find(
+        const CharT *s, usize n, const CharT *nd, usize m, usize pos) noexcept {
+        constexpr usize W    = sizeof(CharT);
+        constexpr usize L    = block / W;
+        constexpr u32   lane = (1U << W) - 1;
+
+        const __m256i first = broadcast<W>(unit(nd[0]));
+        const __m256i last  = broadcast<W>(unit(nd[m - 1]));
+
+        usize i = pos;
+        for (; i + m - 1 + L <= n; i += L) {
+            u32 mask = movemask(
+                _mm256_and_si256(eq<W>(load(s + i), first), eq<W>(load(s + i + m - 1), last)));
+
+            while (mask != 0) {
+                const usize at = static_cast<usize>(libcxx::countr_zero(mask)) / W;
+                if (equal(s + i + at + 1, nd + 1, m - 2)) {
+                    return i + at;
+                }
+                mask &= ~(lane << (at * W));
+            }
+        }
+
+        for (; i + m <= n; ++i) {
+            if (s[i] == nd[0] && equal(s + i, nd, m)) {
+                return i;
+            }
+        }
+        return npos;
+    }
+
+    template <typename CharT>
+    _HELIX_TARGET_AVX2 usize rfind(const CharT *s, usize end, const CharT *nd, usize m) noexcept {
+        constexpr usize W    = sizeof(CharT);
+        constexpr usize L    = block / W;
+        constexpr u32   lane = (1U << W) - 1;
+
+        const __m256i first = broadcast<W>(unit(nd[0]));
+        const __m256i last  = broadcast<W>(unit(nd[m - 1]));
+
+        for (; end >= L; end -= L) {
+            const usize base = end - L;
+            u32         mask = movemask(_mm256_and_si256(eq<W>(load(s + base), first),
+                                                         eq<W>(load(s + base + m - 1), last)));
+
+            while (mask != 0) {
+                const usize at = (static_cast<usize>(libcxx::bit_width(mask)) - 1) / W;
+                if (equal(s + base + at + 1, nd + 1, m - 2)) {
+                    return base + at;
+                }
+                mask &= ~(lane << (at * W));
+            }
+        }
+
+        return scalar::rfind(s, end, nd, m);
+    }
+}  // namespace avx2
+#endif
+
+/// first position `>= pos` whose unit is (or with `negate`, is not) in `set`
+template <typename CharT>
+inline usize find_first_of(const CharT *s,
+                           usize        n,
+                           const CharT *set,
+                           usize        m,
+                           usize        pos    = 0,
+                           bool         negate = false) noexcept {
+    if (pos >= n) {
+        return npos;
+    }
+    if (m == 0) {
+        return negate ? pos : npos;
+    }
+
+#if _HELIX_SEARCH_X86
+    if constexpr (simd_unit<CharT>) {
+        if (m <= max_simd_set) {
+            switch (active_isa()) {
+                case Isa::AVX2:
+                    return avx2::find_first_of(s, n, pos, set, m, negate);
+                case Isa::SSE42:
+                    return sse42::find_first_of(s, n, pos, set, m, negate);
+                case Isa::Scalar:
+                    break;
+            }
+        }
+    }
+#endif
+
+    return scalar::find_first_of(s, n, pos, set, m, negate);
+}
+
+/// last position `<= pos` whose unit is (or with `negate`, is not) in `set`
+template <typename CharT>
+inline usize find_last_of(const CharT *s,
+                          usize        n,
+                          const CharT *set,
+                          usize        m,
+                          usize        pos    = npos,
+                          bool         negate = false) noexcept {
+    if (n == 0) {
+        return npos;
+    }
+
+    const usize end = (pos < n ? pos : n - 1) + 1;
+    if (m == 0) {
+        return negate ? end - 1 : npos;
+    }
+
+#if _HELIX_SEARCH_X86
+    if constexpr (simd_unit<CharT>) {
+        if (m <= max_simd_set) {
+            switch (active_isa()) {
+                case Isa::AVX2:
+                    return avx2::find_last_of(s, end, set, m, negate);
+                case Isa::SSE42:
+                    return sse42::find_last_of(s, end, set, m, negate);
+                case Isa::Scalar:
+                    break;
+            }
+        }
+    }
+#endif
+
+    return scalar::find_last_of(s, end, set, m, negate);
+}
+
+/// first occurrence of `nd[0, m)` starting at or after `pos`
+template <typename CharT>
+inline usize find(const CharT *s, usize n, const CharT *nd, usize m, usize pos = 0) noexcept {
+    if (m == 0) {
+        return pos <= n ? pos : npos;
+    }
+    if (pos >= n || n - pos < m) {
+        return npos;
+    }
+    if (m == 1) {
+        return find_first_of(s, n, nd, 1, pos);
+    }
+
+#if _HELIX_SEARCH_X86
+    if constexpr (simd_unit<CharT>) {
+        switch (active_isa()) {
+            case Isa::AVX2:
+                return avx2::find(s, n, nd, m, pos);
+            case Isa::SSE42:
+                return sse42::find(s, n, nd, m, pos);
+            case Isa::Scalar:
+                break;
+        }
+    }
+#endif
+
+    return scalar::find(s, n, nd, m, pos);
+}
+
+/// last occurrence of `nd[0, m)` starting at or before `pos`
+template <typename CharT>
+inline usize rfind(const CharT *s, usize n, const CharT *nd, usize m, usize pos = npos) noexcept {
+    if (m == 0) {
+        return pos < n ? pos : n;
+    }
+    if (n < m) {
+        return npos;
+    }
+    if (m == 1) {
+        return find_last_of(s, n, nd, 1, pos);
+    }
+
+    const usize end = (pos < n - m ? pos : n - m) + 1;
+
+#if _HELIX_SEARCH_X86
+    if constexpr (simd_unit<CharT>) {
+        switch (active_isa()) {
+            case Isa::AVX2:
+                return avx2::rfind(s, end, nd, m);
+            case Isa::SSE42:
+                return sse42::rfind(s, end, nd, m);
+            case Isa::Scalar:
+                break;
+        }
+    }
+#endif
+
+    return scalar::rfind(s, end, nd, m);
+}
+}  // namespace String::__internal::search
+
+H_STD_NAMESPACE_END
+H_NAMESPACE_END
+
+#endif  // _$_HX_CORE_M6SEARCH
@@ -22,6 +22,8 @@
 #include <include/types/builtins/size_t.hh>
 #include <include/types/question/question_fwd.hh>
 #include <include/types/string/char_traits.hh>
+#include <include/runtime/__generator/generator_impl.hh>
+#include <include/runtime/__hash/hash.hh>
 
 H_NAMESPACE_BEGIN
 H_STD_NAMESPACE_BEGIN
@@ -55,6 +57,8 @@ class slice {
     constexpr slice() noexcept                   = default;
     constexpr slice(const slice &other) noexcept = default;
     constexpr slice(slice &&other) noexcept      = default;
+    constexpr slice &operator=(const slice &other) noexcept = default;
+    constexpr slice &operator=(slice &&other) noexcept      = default;
     slice(const CharT *str) noexcept;
     slice(const CharT *str, size_t size) noexcept;
     slice(view_t view) noexcept;
@@ -96,6 +100,9 @@ class slice {
 
     usize length() const noexcept { return len; }
 
+    /// feeds the code units to `hasher`, in place; agrees with `std::hash` and `Hash::StringHash`
+    void hash(Hash::Hasher *hasher) const noexcept { hasher->write(*this); }
+
     bool starts_with(slice &needle) const;
     bool ends_with(slice &needle) const;
 
@@ -122,6 +129,15 @@ class slice {
                 "discarding it neglects the parsed structure")]]
     slice_vec split(slice &delim, Operation op = Operation::Remove) const;
 
+    class split_range;
+    class lines_range;
+
+    [[nodiscard("split_iter() returns a lazy range of views; discarding it does no work")]]
+    split_range split_iter(const slice &delim, Operation op = Operation::Remove) const noexcept;
+
+    [[nodiscard("lines_iter() returns a lazy range of line views; discarding it does no work")]]
+    lines_range lines_iter() const noexcept;
+
     std::Questionable<usize> lfind(slice &needle) const;
     std::Questionable<usize> rfind(slice &needle) const;
     std::Questionable<usize> find_first_of(slice &needle) const;
@@ -131,6 +147,127 @@ class slice {
 
     CharT operator[](usize index) const noexcept;
 };
+
+/// lazy, non-allocating counterpart of `slice::split`.
+///
+/// each step hands out a view into the source (and, with `Operation::Keep`, a view of the matched
+/// delimiter), so the source must outlive the range. iteration follows the same protocol as
+/// `$generator` (`begin()` plus a `default_sentinel_t` end) so it works with range-for and
+/// anything else that walks a generator; `to_generator()` wraps it in an actual `$generator`.
+template <typename CharT, typename Traits>
+    requires CharTraits<Traits, CharT>
+class slice<CharT, Traits>::split_range {
+    slice_t   source;
+    slice_t   delim;
+    Operation op;
+
+  public:
+    class iterator {
+        slice_t   source;
+        slice_t   delim;
+        slice_t   current{};
+        usize     pos;
+        usize     match   = 0;
+        Operation op;
+        bool      pending = false;
+        bool      done    = false;
+
+        void advance() noexcept;
+
+      public:
+        using value_type      = slice_t;
+        using difference_type = isize;
+
+        iterator(slice_t source, slice_t delim, Operation op) noexcept
+            : source(source)
+            , delim(delim)
+            , pos(0)
+            , op(op) {
+            advance();
+        }
+
+        const slice_t &operator*() const noexcept { return current; }
+        const slice_t *operator->() const noexcept { return &current; }
+
+        iterator &operator++() noexcept {
+            advance();
+            return *this;
+        }
+        void operator++(int) noexcept { advance(); }
+
+        constexpr bool operator==(libcxx::default_sentinel_t /*unused*/) const noexcept {
+            return done;
+        }
+    };
+
+    split_range(slice_t source, slice_t delim, Operation op) noexcept
+        : source(source)
+        , delim(delim)
+        , op(op) {}
+
+    iterator begin() const noexcept { return iterator(source, delim, op); }
+    constexpr libcxx::default_sentinel_t end() const noexcept { return {}; }
+
+    $generator<slice_t> to_generator() const { return generate(*this); }
+
+  private:
+    // the range is taken by value so the coroutine frame owns its own copy
+    static $generator<slice_t> generate(split_range range);
+};
+
+/// lazy, non-allocating counterpart of `slice::split_lines`. a line ends at `\n`, `\r\n` or a
+/// lone `\r`; the terminator is not part of the view and a trailing terminator does not produce
+/// an empty final line.
+template <typename CharT, typename Traits>
+    requires CharTraits<Traits, CharT>
+class slice<CharT, Traits>::lines_range {
+    slice_t source;
+
+  public:
+    class iterator {
+        slice_t source;
+        slice_t current{};
+        usize   pos;
+        bool    done = false;
+
+        void advance() noexcept;
+
+      public:
+        using value_type      = slice_t;
+        using difference_type = isize;
+
+        explicit iterator(slice_t source) noexcept
+            : source(source)
+            , pos(0) {
+            advance();
+        }
+
+        const slice_t &operator*() const noexcept { return current; }
+        const slice_t *operator->() const noexcept { return &current; }
+
+        iterator &operator++() noexcept {
+            advance();
+            return *this;
+        }
+        void operator++(int) noexcept { advance(); }
+
+        constexpr bool operator==(libcxx::default_sentinel_t /*unused*/) const noexcept {
+            return done;
+        }
+    };
+
+    explicit lines_range(slice_t source) noexcept
+        : source(source) {}
+
+    iterator begin() const noexcept { return iterator(source); }
+    constexpr libcxx::default_sentinel_t end() const noexcept { return {}; }
+
+    $generator<slice_t> to_generator() const { return generate(*this); }
+
+  private:
+    // the range is taken by value so the coroutine frame owns its own copy
+    static $generator<slice_t> generate(lines_range range);
+};
 }  // namespace String
 
 H_STD_NAMESPACE_END
@@ -138,17 +275,10 @@ H_NAMESPACE_END
 
 // make hash able
 namespace std {
-template <>
-struct hash<helix::std::String::slice<wchar_t>> {
-    size_t operator()(const helix::std::String::slice<wchar_t> &s) const noexcept {
-        return std::hash<std::wstring>{}(std::wstring(s.raw(), s.size()));
-    }
-};
-
-template <>
-struct hash<helix::std::String::slice<char>> {
-    size_t operator()(const helix::std::String::slice<char> &s) const noexcept {
-        return std::hash<std::string>{}(std::string(s.raw(), s.size()));
+template <typename CharT, typename Traits>
+struct hash<helix::std::String::slice<CharT, Traits>> {
+    size_t operator()(const helix::std::String::slice<CharT, Traits> &s) const noexcept {
+        return static_cast<size_t>(helix::std::Hash::text(s));
     }
 };
 }  // namespace std
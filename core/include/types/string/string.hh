@@ -19,11 +19,15 @@
 #include <include/config/config.hh>
 
 #include <include/meta/meta.hh>
+#include <include/runtime/__io/__input/itoa.hh>
 #include <include/types/string/slice.hh>
 #include <include/runtime/__memory/memory.hh>
 #include <include/types/string/basic.hh>
 #include <include/types/string/c-string.hh>
 #include <include/types/string/char_traits.hh>
+#include <include/types/string/search.hh>
+#include <include/types/string/transcode.hh>
+#include <include/types/string/utf8.hh>
 #include <include/meta/type_properties.hh>
 
 H_NAMESPACE_BEGIN
@@ -37,12 +41,22 @@ inline string to_string(const libcxx::string &t) { return {t.data(), t.size()};
 inline string to_string(const libcxx::wstring &t) { return {t.data(), t.size()}; }
 inline string to_string(bool t) { return t ? L"true" : L"false"; }
 
+/// numbers are written straight into a stack buffer by `Format::to_chars`
 template <typename Ty>
-    requires std::Interface::SupportsOStream<std::Meta::all_extents_removed<Ty>>
+    requires Format::Numeric<Ty>
+inline string to_string(Ty &&t) {
+    wchar_t buf[Format::max_chars<Ty>];
+    return {buf, static_cast<usize>(Format::to_chars(buf, t) - buf)};
+}
+
+template <typename Ty>
+    requires std::Interface::SupportsOStream<std::Meta::all_extents_removed<Ty>> &&
+             (!Format::Numeric<Ty>)
 string to_string(Ty &&t) {
     LIBCXX_NAMESPACE::stringstream ss;
     ss << t;
-    return {ss.str().data(), ss.str().size()};
+    const auto str = ss.str();
+    return {str.data(), str.size()};
 }
 
 template <typename Ty>
@@ -81,7 +95,8 @@ template <typename Ty>
             (!std::Interface::Castable<std::Meta::all_extents_removed<Ty>, wchar_t *>) &&
             (!std::Interface::Castable<std::Meta::all_extents_removed<Ty>, char *>) &&
             (!std::Interface::Castable<std::Meta::all_extents_removed<Ty>, nstring>) &&
-            (!std::Interface::Castable<std::Meta::all_extents_removed<Ty>, string>)
+            (!std::Interface::Castable<std::Meta::all_extents_removed<Ty>, string>) &&
+            (!Format::Numeric<Ty>)
 inline string to_string(Ty &&t) {
     LIBCXX_NAMESPACE::wstringstream ss;
 #ifdef _MSC_VER
@@ -92,103 +107,51 @@ inline string to_string(Ty &&t) {
     ss << L"[" << rn << L" at " << LIBCXX_NAMESPACE::hex << &t << L"]";
     free(rn);
 #endif
-    return {ss.str().data(), ss.str().size()};
+    const auto str = ss.str();
+    return {str.data(), str.size()};
 }
 
 // compile-time check for wchar_t size
 static_assert(sizeof(wchar_t) >= sizeof(char), "wchar_t must be at least as large as char");
 
-
-#ifdef _MSC_VER
-#pragma warning(push) // remove msvc deprecation warning
-#pragma warning(disable : 4996)
-#endif
-
 inline char char_to_cchar(wchar_t wc) {
-    char* temp = (char*)alloca(MB_CUR_MAX);  // stack-allocated, typically 4-6 bytes
+    const auto cp = static_cast<char32_t>(wc);
 
-    int len = wctomb(temp, wc);
-
-    if (len <= 0) {
+    if (cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) {
         throw libcxx::range_error("Invalid wchar_t conversion");
     }
-    if (len > 1) {
+    if (cp > 0x7F) {
         throw libcxx::range_error("wchar_t converts to multibyte, not single char");
     }
 
-    return temp[0];
+    return static_cast<char>(cp);
 }
 
-#ifdef _MSC_VER
-#pragma warning(pop)
-#endif
+/// decodes `size` bytes of UTF-8 into a wide string sized exactly once; malformed sequences
+/// become U+FFFD instead of failing the whole conversion.
+inline string utf8_to_string(const char *src, size_t size) {
+    namespace transcode = String::__internal::transcode;
 
-inline string nstring_to_string(const nstring &cstr) {
-    if (cstr.is_empty()) {
+    if (src == nullptr || size == 0) {
         return string();
     }
 
-    #define cast(type) static_cast<type>
-
-    const char *raw_data  = cstr.raw();
-    size_t      cstr_size = cstr.size();
+    const auto *bytes = reinterpret_cast<const char8_t *>(src);
+    const auto  len   = transcode::utf8_to_wide_length<wchar_t>(bytes, size);
     string      result;
-    result.resize(cstr_size);
-    auto  *buffer  = const_cast<wchar_t *>(result.raw());
-    size_t buf_pos = 0;
-
-    for (size_t i = 0; i < cstr_size;) {
-        uint32_t      codepoint = 0;
-        int           bytes     = 0;
-        auto c   = cast(unsigned char)(raw_data[i]);
-
-        if (c <= 0x7F) {
-            codepoint = c;
-            bytes     = 1;
-        } else if ((c & 0xE0) == 0xC0 && i + 1 < cstr_size) {
-            codepoint = ((c & 0x1F) << 6) | (cast(unsigned char)(raw_data[i + 1]) & 0x3F);
-            bytes     = 2;
-        } else if ((c & 0xF0) == 0xE0 && i + 2 < cstr_size) {
-            codepoint = ((c & 0x0F) << 12) |
-                        ((cast(unsigned char)(raw_data[i + 1]) & 0x3F) << 6) |
-                        (cast(unsigned char)(raw_data[i + 2]) & 0x3F);
-            bytes = 3;
-        } else if ((c & 0xF8) == 0xF0 && i + 3 < cstr_size) {
-            codepoint = ((c & 0x07) << 18) |
-                        ((cast(unsigned char)(raw_data[i + 1]) & 0x3F) << 12) |
-                        (cast(unsigned char)(raw_data[i + 2]) & 0x3F << 6) |
-                        (cast(unsigned char)(raw_data[i + 3]) & 0x3F);
-            bytes = 4;
-        } else {
-            codepoint = L'?';
-            bytes     = 1;
-        }
-
-        if (buf_pos + (sizeof(wchar_t) == 2 && codepoint > 0xFFFF ? 2 : 1) >= result.size()) {
-            result.resize(result.size() * 2);
-            buffer = const_cast<wchar_t *>(result.raw());
-        }
-
-        if constexpr (sizeof(wchar_t) == 2) {
-            if (codepoint <= 0xFFFF) {
-                buffer[buf_pos++] = static_cast<wchar_t>(codepoint);
-            } else if (codepoint <= 0x10FFFF) {
-                codepoint -= 0x10000;
-                buffer[buf_pos++] = static_cast<wchar_t>(0xD800 | (codepoint >> 10));
-                buffer[buf_pos++] = static_cast<wchar_t>(0xDC00 | (codepoint & 0x3FF));
-            } else {
-                buffer[buf_pos++] = L'?';
-            }
-        } else {
-            buffer[buf_pos++] = static_cast<wchar_t>(codepoint > 0x10FFFF ? L'?' : codepoint);
-        }
-        i += bytes;
-    }
-    result.resize(buf_pos);
+
+    result.resize(len.units);
+    transcode::utf8_to_wide(bytes, size, const_cast<wchar_t *>(result.raw()), len.valid);
     return result;
 }
 
+inline string nstring_to_string(const nstring &cstr) {
+    return utf8_to_string(cstr.raw(), cstr.size());
+}
+
 inline string nptr_to_string(const char *cstr, size_t size) {
+    namespace transcode = String::__internal::transcode;
+
     if (!cstr && size > 0) {
         throw libcxx::invalid_argument("Null pointer with non-zero size");
     }
@@ -197,238 +160,57 @@ inline string nptr_to_string(const char *cstr, size_t size) {
         return {};
     }
 
-    size_t max_size = size;
-    string result;
-    result.resize(max_size);
-
-    auto  *buffer   = const_cast<wchar_t *>(result.raw());
-    size_t buf_pos  = 0;
-    size_t char_pos = 0;
-
-    while (char_pos < size) {
-        wchar_t wc;
-        int     len = mbtowc(&wc, cstr + char_pos, size - char_pos);
-        if (len <= 0) {
-            throw libcxx::range_error("Invalid multibyte sequence at position " +
-                                      libcxx::to_string(char_pos));
-        }
-        if (buf_pos >= max_size) {
-            throw libcxx::runtime_error("Internal buffer overflow (unexpected)");
-        }
-        buffer[buf_pos++] = wc;
-        char_pos += len;
+    const auto *bytes = reinterpret_cast<const char8_t *>(cstr);
+    const auto  len   = transcode::utf8_to_wide_length<wchar_t>(bytes, size);
+
+    if (!len.valid) {
+        throw libcxx::range_error("Invalid multibyte sequence at position " +
+                                  libcxx::to_string(transcode::first_invalid_utf8(bytes, size)));
     }
 
-    result.resize(buf_pos);
+    string result;
+    result.resize(len.units);
+    transcode::utf8_to_wide(bytes, size, const_cast<wchar_t *>(result.raw()), true);
     return result;
 }
 
+/// lone surrogates and out of range values become U+FFFD, so this never fails
 inline nstring string_to_nstring(const string &wstr) {
+    namespace transcode = String::__internal::transcode;
+
     if (wstr.is_empty()) {
         return nstring();
     }
 
-    const wchar_t *raw_data  = wstr.raw();
-    size_t         wstr_size = wstr.size();
-    nstring        result;
-    result.resize(wstr_size * 4);  // Max UTF-8 size (4 bytes per wchar_t)
-    char  *buffer  = const_cast<char *>(result.raw());
-    size_t buf_pos = 0;
-
-    for (size_t i = 0; i < wstr_size; ++i) {
-        uint32_t codepoint;
-
-        // Decode wchar_t (UTF-16 or UTF-32)
-        if constexpr (sizeof(wchar_t) == 2) {
-            codepoint = static_cast<uint16_t>(raw_data[i]);
-            if (codepoint >= 0xD800 && codepoint <= 0xDBFF && i + 1 < wstr_size) {
-                uint16_t low = static_cast<uint16_t>(raw_data[i + 1]);
-                if (low >= 0xDC00 && low <= 0xDFFF) {
-                    codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
-                    i++;  // Skip low surrogate
-                }
-            }
-        } else {
-            codepoint = static_cast<uint32_t>(raw_data[i]);
-        }
-
-        // Encode to UTF-8
-        size_t bytes_needed;
-        if (codepoint <= 0x7F)
-            bytes_needed = 1;
-        else if (codepoint <= 0x7FF)
-            bytes_needed = 2;
-        else if (codepoint <= 0xFFFF)
-            bytes_needed = 3;
-        else if (codepoint <= 0x10FFFF)
-            bytes_needed = 4;
-        else
-            bytes_needed = 1;  // '?' for invalid
-
-        if (buf_pos + bytes_needed >= result.size()) {
-            result.resize(result.size() * 2);
-            buffer = const_cast<char *>(result.raw());
-        }
-
-        if (codepoint <= 0x7F) {
-            buffer[buf_pos++] = static_cast<char>(codepoint);
-        } else if (codepoint <= 0x7FF) {
-            buffer[buf_pos++] = static_cast<char>(0xC0 | (codepoint >> 6));
-            buffer[buf_pos++] = static_cast<char>(0x80 | (codepoint & 0x3F));
-        } else if (codepoint <= 0xFFFF) {
-            buffer[buf_pos++] = static_cast<char>(0xE0 | (codepoint >> 12));
-            buffer[buf_pos++] = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
-            buffer[buf_pos++] = static_cast<char>(0x80 | (codepoint & 0x3F));
-        } else if (codepoint <= 0x10FFFF) {
-            buffer[buf_pos++] = static_cast<char>(0xF0 | (codepoint >> 18));
-            buffer[buf_pos++] = static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
-            buffer[buf_pos++] = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
-            buffer[buf_pos++] = static_cast<char>(0x80 | (codepoint & 0x3F));
-        } else {
-            buffer[buf_pos++] = '?';
-        }
-    }
-
-    result.resize(buf_pos);
+    nstring result;
+    result.resize(transcode::wide_to_utf8_length(wstr.raw(), wstr.size()));
+    transcode::wide_to_utf8(
+        wstr.raw(), wstr.size(), reinterpret_cast<char8_t *>(const_cast<char *>(result.raw())));
     return result;
 }
 
 using cstring = libcxx::string;
 
 inline string cstring_to_string(const cstring &cstr) {
-    if (cstr.empty()) {
-        return string();
-    }
-
-    const char *raw_data  = cstr.data();
-    size_t      cstr_size = cstr.size();
-    string      result;
-    result.resize(cstr_size);
-    auto  *buffer  = const_cast<wchar_t *>(result.raw());
-    size_t buf_pos = 0;
-
-    for (size_t i = 0; i < cstr_size;) {
-        uint32_t      codepoint = 0;
-        int           bytes     = 0;
-        auto c   = static_cast<unsigned char>(raw_data[i]);
-
-        if (c <= 0x7F) {
-            codepoint = c;
-            bytes     = 1;
-        } else if ((c & 0xE0) == 0xC0 && i + 1 < cstr_size) {
-            codepoint = ((c & 0x1F) << 6) | (static_cast<unsigned char>(raw_data[i + 1]) & 0x3F);
-            bytes     = 2;
-        } else if ((c & 0xF0) == 0xE0 && i + 2 < cstr_size) {
-            codepoint = ((c & 0x0F) << 12) |
-                        ((static_cast<unsigned char>(raw_data[i + 1]) & 0x3F) << 6) |
-                        (static_cast<unsigned char>(raw_data[i + 2]) & 0x3F);
-            bytes = 3;
-        } else if ((c & 0xF8) == 0xF0 && i + 3 < cstr_size) {
-            codepoint = ((c & 0x07) << 18) |
-                        ((static_cast<unsigned char>(raw_data[i + 1]) & 0x3F) << 12) |
-                        (static_cast<unsigned char>(raw_data[i + 2]) & 0x3F << 6) |
-                        (static_cast<unsigned char>(raw_data[i + 3]) & 0x3F);
-            bytes = 4;
-        } else {
-            codepoint = L'?';
-            bytes     = 1;
-        }
-
-        if (buf_pos + (sizeof(wchar_t) == 2 && codepoint > 0xFFFF ? 2 : 1) >= result.size()) {
-            result.resize(result.size() * 2);
-            buffer = const_cast<wchar_t *>(result.raw());
-        }
-
-        if constexpr (sizeof(wchar_t) == 2) {
-            if (codepoint <= 0xFFFF) {
-                buffer[buf_pos++] = static_cast<wchar_t>(codepoint);
-            } else if (codepoint <= 0x10FFFF) {
-                codepoint -= 0x10000;
-                buffer[buf_pos++] = static_cast<wchar_t>(0xD800 | (codepoint >> 10));
-                buffer[buf_pos++] = static_cast<wchar_t>(0xDC00 | (codepoint & 0x3FF));
-            } else {
-                buffer[buf_pos++] = L'?';
-            }
-        } else {
-            buffer[buf_pos++] = static_cast<wchar_t>(codepoint > 0x10FFFF ? L'?' : codepoint);
-        }
-        i += bytes;
-    }
-    result.resize(buf_pos);
-    return result;
+    return utf8_to_string(cstr.data(), cstr.size());
 }
 
 inline cstring string_to_cstring(const string &wstr) {
+    namespace transcode = String::__internal::transcode;
+
     if (wstr.is_empty()) {
         return cstring();
     }
 
-    const wchar_t *raw_data  = wstr.raw();
-    size_t         wstr_size = wstr.size();
-    cstring        result;
-    result.resize(wstr_size * 4);  // Max UTF-8 size (4 bytes per wchar_t)
-    char  *buffer  = const_cast<char *>(result.data());
-    size_t buf_pos = 0;
-
-    for (size_t i = 0; i < wstr_size; ++i) {
-        uint32_t codepoint;
-
-        // Decode wchar_t (UTF-16 or UTF-32)
-        if constexpr (sizeof(wchar_t) == 2) {
-            codepoint = static_cast<uint16_t>(raw_data[i]);
-            if (codepoint >= 0xD800 && codepoint <= 0xDBFF && i + 1 < wstr_size) {
-                uint16_t low = static_cast<uint16_t>(raw_data[i + 1]);
-                if (low >= 0xDC00 && low <= 0xDFFF) {
-                    codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
-                    i++;  // Skip low surrogate
-                }
-            }
-        } else {
-            codepoint = static_cast<uint32_t>(raw_data[i]);
-        }
-
-        // Encode to UTF-8
-        size_t bytes_needed;
-        if (codepoint <= 0x7F)
-            bytes_needed = 1;
-        else if (codepoint <= 0x7FF)
-            bytes_needed = 2;
-        else if (codepoint <= 0xFFFF)
-            bytes_needed = 3;
-        else if (codepoint <= 0x10FFFF)
-            bytes_needed = 4;
-        else
-            bytes_needed = 1;  // '?' for invalid
-
-        if (buf_pos + bytes_needed >= result.size()) {
-            result.resize(result.size() * 2);
-            buffer = const_cast<char *>(result.data());
-        }
-
-        if (codepoint <= 0x7F) {
-            buffer[buf_pos++] = static_cast<char>(codepoint);
-        } else if (codepoint <= 0x7FF) {
-            buffer[buf_pos++] = static_cast<char>(0xC0 | (codepoint >> 6));
-            buffer[buf_pos++] = static_cast<char>(0x80 | (codepoint & 0x3F));
-        } else if (codepoint <= 0xFFFF) {
-            buffer[buf_pos++] = static_cast<char>(0xE0 | (codepoint >> 12));
-            buffer[buf_pos++] = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
-            buffer[buf_pos++] = static_cast<char>(0x80 | (codepoint & 0x3F));
-        } else if (codepoint <= 0x10FFFF) {
-            buffer[buf_pos++] = static_cast<char>(0xF0 | (codepoint >> 18));
-            buffer[buf_pos++] = static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
-            buffer[buf_pos++] = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
-            buffer[buf_pos++] = static_cast<char>(0x80 | (codepoint & 0x3F));
-        } else {
-            buffer[buf_pos++] = '?';
-        }
-    }
-
-    result.resize(buf_pos);
+    cstring result;
+    result.resize(transcode::wide_to_utf8_length(wstr.raw(), wstr.size()));
+    transcode::wide_to_utf8(wstr.raw(), wstr.size(), reinterpret_cast<char8_t *>(result.data()));
     return result;
 }
 
 inline void wptr_to_nptr(const wchar_t *wstr, char *buffer, size_t buffer_size) {
+    namespace transcode = String::__internal::transcode;
+
     if (!wstr || !buffer) {
         throw libcxx::invalid_argument("Null pointer provided");
     }
@@ -436,68 +218,16 @@ inline void wptr_to_nptr(const wchar_t *wstr, char *buffer, size_t buffer_size)
         throw libcxx::invalid_argument("Buffer size must be at least 1 for null terminator");
     }
 
-    size_t buf_pos = 0;
-    size_t i       = 0;
-
-    while (wstr[i] != L'\0') {
-        uint32_t codepoint;
-
-        // Decode wchar_t (UTF-16 or UTF-32)
-        if constexpr (sizeof(wchar_t) == 2) {
-            codepoint = static_cast<uint16_t>(wstr[i]);
-            if (codepoint >= 0xD800 && codepoint <= 0xDBFF && wstr[i + 1] != L'\0') {
-                uint16_t low = static_cast<uint16_t>(wstr[i + 1]);
-                if (low >= 0xDC00 && low <= 0xDFFF) {
-                    codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
-                    i++;  // Skip the low surrogate
-                }
-            }
-        } else {
-            codepoint = static_cast<uint32_t>(wstr[i]);
-        }
-
-        // Encode to UTF-8
-        if (codepoint <= 0x7F) {
-            if (buf_pos + 1 >= buffer_size) {
-                buffer[buf_pos] = '\0';
-                throw libcxx::range_error("Buffer too small at index " + libcxx::to_string(i));
-            }
-            buffer[buf_pos++] = static_cast<char>(codepoint);
-        } else if (codepoint <= 0x7FF) {
-            if (buf_pos + 2 >= buffer_size) {
-                buffer[buf_pos] = '\0';
-                throw libcxx::range_error("Buffer too small at index " + libcxx::to_string(i));
-            }
-            buffer[buf_pos++] = static_cast<char>(0xC0 | (codepoint >> 6));
-            buffer[buf_pos++] = static_cast<char>(0x80 | (codepoint & 0x3F));
-        } else if (codepoint <= 0xFFFF) {
-            if (buf_pos + 3 >= buffer_size) {
-                buffer[buf_pos] = '\0';
-                throw libcxx::range_error("Buffer too small at index " + libcxx::to_string(i));
-            }
-            buffer[buf_pos++] = static_cast<char>(0xE0 | (codepoint >> 12));
-            buffer[buf_pos++] = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
-            buffer[buf_pos++] = static_cast<char>(0x80 | (codepoint & 0x3F));
-        } else if (codepoint <= 0x10FFFF) {
-            if (buf_pos + 4 >= buffer_size) {
-                buffer[buf_pos] = '\0';
-                throw libcxx::range_error("Buffer too small at index " + libcxx::to_string(i));
-            }
-            buffer[buf_pos++] = static_cast<char>(0xF0 | (codepoint >> 18));
-            buffer[buf_pos++] = static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
-            buffer[buf_pos++] = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
-            buffer[buf_pos++] = static_cast<char>(0x80 | (codepoint & 0x3F));
-        } else {
-            // Invalid codepoint: use '?'
-            if (buf_pos + 1 >= buffer_size) {
-                buffer[buf_pos] = '\0';
-                throw libcxx::range_error("Buffer too small at index " + libcxx::to_string(i));
-            }
-            buffer[buf_pos++] = '?';
-        }
-        i++;
+    const size_t len    = libcxx::char_traits<wchar_t>::length(wstr);
+    const size_t needed = transcode::wide_to_utf8_length(wstr, len);
+
+    if (needed >= buffer_size) {
+        buffer[0] = '\0';
+        throw libcxx::range_error("Buffer too small: " + libcxx::to_string(needed + 1) +
+                                  " bytes required");
     }
-    buffer[buf_pos] = '\0';
+
+    buffer[transcode::wide_to_utf8(wstr, len, reinterpret_cast<char8_t *>(buffer))] = '\0';
 }
 
 H_STD_NAMESPACE_END
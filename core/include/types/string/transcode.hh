@@ -0,0 +1,840 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///-------------------------------------------------------------------------------- Lib-Helix ---///
+
+#ifndef _$_HX_CORE_M9TRANSCODE
+#define _$_HX_CORE_M9TRANSCODE
+
+#include <include/config/config.hh>
+
+#include <include/c++/libc++.hh>
+#include <include/types/builtins/builtins.hh>
+#include <include/types/string/search.hh>
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+/// UTF-8 <-> UTF-16/UTF-32 transcoding shared by every narrow/wide conversion in the runtime.
+///
+/// conversions are split in two: a `*_length` call that returns the exact output size and a
+/// conversion that writes into a buffer of that size, so callers allocate once and never trim.
+/// the wide side is any 2 or 4 byte unit (`char16_t`, `char32_t`, `wchar_t`), picked by size.
+///
+/// UTF-8 input is validated with the lookup-table algorithm used by simdutf/simdjson (three
+/// nibble lookups classify every byte pair, a saturating subtract checks 3/4 byte tails); valid
+/// input is then counted and decoded without any per-sequence checks, with pure-ASCII blocks
+/// widened 16/32 bytes per step. malformed input takes the scalar path, where every bad byte
+/// becomes U+FFFD. wide input never fails: lone surrogates and values past U+10FFFF are encoded
+/// as U+FFFD as well.
+namespace String::__internal::transcode {
+using search::Isa;
+
+inline constexpr usize    npos        = static_cast<usize>(-1);
+inline constexpr char32_t replacement = U'\uFFFD';
+
+template <typename WideT>
+concept WideUnit = sizeof(WideT) == 2 || sizeof(WideT) == 4;
+
+template <typename WideT>
+inline constexpr bool is_utf16 = sizeof(WideT) == 2;
+
+/// exact number of output units for a UTF-8 input, and whether that input was well formed.
+/// pass `valid` back to `utf8_to_wide` so it can skip straight to the unchecked decoder.
+struct length_t {
+    usize units;
+    bool  valid;
+};
+
+/// decodes one scalar value from `[p, end)`; malformed input (truncation, overlong forms,
+/// surrogates, values past U+10FFFF) yields U+FFFD with a width of one byte.
+inline char32_t decode_utf8(const char8_t *p, const char8_t *end, usize &width) noexcept {
+    const u32 c = p[0];
+    width       = 1;
+
+    if (c < 0x80) {
+        return c;
+    }
+
+    const usize avail = static_cast<usize>(end - p);
+    auto        cont  = [&](usize i) { return i < avail && (p[i] & 0xC0) == 0x80; };
+
+    if (c >= 0xC2 && c <= 0xDF && cont(1)) {
+        width = 2;
+        return ((c & 0x1F) << 6) | (p[1] & 0x3F);
+    }
+
+    if (c >= 0xE0 && c <= 0xEF && cont(1) && cont(2)) {
+        const u32 cp = ((c & 0x0F) << 12) | ((p[1] & 0x3FU) << 6) | (p[2] & 0x3F);
+        if (cp >= 0x800 && (cp < 0xD800 || cp > 0xDFFF)) {
+            width = 3;
+            return cp;
+        }
+        return replacement;
+    }
+
+    if (c >= 0xF0 && c <= 0xF4 && cont(1) && cont(2) && cont(3)) {
+        const u32 cp = ((c & 0x07) << 18) | ((p[1] & 0x3FU) << 12) | ((p[2] & 0x3FU) << 6) |
+                       (p[3] & 0x3F);
+        if (cp >= 0x10000 && cp <= 0x10FFFF) {
+            width = 4;
+            return cp;
+        }
+    }
+
+    return replacement;
+}
+
+/// encodes `cp` into `out` (at least 4 bytes) and returns the number of bytes written
+inline usize encode_utf8(char32_t cp, char8_t *out) noexcept {
+    if (cp < 0x80) {
+        out[0] = static_cast<char8_t>(cp);
+        return 1;
+    }
+    if (cp < 0x800) {
+        out[0] = static_cast<char8_t>(0xC0 | (cp >> 6));
+        out[1] = static_cast<char8_t>(0x80 | (cp & 0x3F));
+        return 2;
+    }
+    if (cp < 0x10000) {
+        if (cp >= 0xD800 && cp <= 0xDFFF) {
+            cp = replacement;
+        }
+        out[0] = static_cast<char8_t>(0xE0 | (cp >> 12));
+        out[1] = static_cast<char8_t>(0x80 | ((cp >> 6) & 0x3F));
+        out[2] = static_cast<char8_t>(0x80 | (cp & 0x3F));
+        return 3;
+    }
+    if (cp > 0x10FFFF) {
+        return encode_utf8(replacement, out);
+    }
+    out[0] = static_cast<char8_t>(0xF0 | (cp >> 18));
+    out[1] = static_cast<char8_t>(0x80 | ((cp >> 12) & 0x3F));
+    out[2] = static_cast<char8_t>(0x80 | ((cp >> 6) & 0x3F));
+    out[3] = static_cast<char8_t>(0x80 | (cp & 0x3F));
+    return 4;
+}
+
+namespace scalar {
+    /// decodes one sequence of input already known to be valid UTF-8
+    HELIX_FORCE_INLINE char32_t decode_valid(const char8_t *p, usize &width) noexcept {
+        const u32 c = p[0];
+        if (c < 0x80) {
+            width = 1;
+            return c;
+        }
+        if (c < 0xE0) {
+            width = 2;
+            return ((c & 0x1F) << 6) | (p[1] & 0x3F);
+        }
+        if (c < 0xF0) {
+            width = 3;
+            return ((c & 0x0F) << 12) | ((p[1] & 0x3FU) << 6) | (p[2] & 0x3F);
+        }
+        width = 4;
+        return ((c & 0x07) << 18) | ((p[1] & 0x3FU) << 12) | ((p[2] & 0x3FU) << 6) |
+               (p[3] & 0x3F);
+    }
+
+    /// stores `cp` as one UTF-32 unit or one/two UTF-16 units, returns the units written
+    template <typename WideT>
+    HELIX_FORCE_INLINE usize put_wide(char32_t cp, WideT *out) noexcept {
+        if constexpr (is_utf16<WideT>) {
+            if (cp > 0xFFFF) {
+                cp -= 0x10000;
+                out[0] = static_cast<WideT>(0xD800 | (cp >> 10));
+                out[1] = static_cast<WideT>(0xDC00 | (cp & 0x3FF));
+                return 2;
+            }
+        }
+        out[0] = static_cast<WideT>(cp);
+        return 1;
+    }
+
+    /// reads the scalar value at `s[i]`, joining a UTF-16 surrogate pair when one is there;
+    /// a lone surrogate is returned as-is and later encoded as U+FFFD.
+    template <typename WideT>
+    HELIX_FORCE_INLINE char32_t get_wide(const WideT *s, usize &i, usize n) noexcept {
+        if constexpr (is_utf16<WideT>) {
+            const u32 hi = static_cast<u16>(s[i++]);
+            if (hi >= 0xD800 && hi <= 0xDBFF && i < n) {
+                const u32 lo = static_cast<u16>(s[i]);
+                if (lo >= 0xDC00 && lo <= 0xDFFF) {
+                    ++i;
+                    return 0x10000 + ((hi - 0xD800) << 10) + (lo - 0xDC00);
+                }
+            }
+            return hi;
+        } else {
+            return static_cast<u32>(s[i++]);
+        }
+    }
+
+    HELIX_FORCE_INLINE usize utf8_width(char32_t cp) noexcept {
+        return cp < 0x80 ? 1 : cp < 0x800 ? 2 : (cp < 0x10000 || cp > 0x10FFFF) ? 3 : 4;
+    }
+
+    inline usize first_invalid(const char8_t *s, usize n) noexcept {
+        for (usize i = 0; i < n;) {
+            usize width = 0;
+            decode_utf8(s + i, s + n, width);
+            if (width == 1 && s[i] >= 0x80) {
+                return i;
+            }
+            i += width;
+        }
+        return npos;
+    }
+
+    inline bool validate(const char8_t *s, usize n) noexcept { return first_invalid(s, n) == npos; }
+
+    /// output units for arbitrary input, counting every malformed byte as one U+FFFD
+    template <typename WideT>
+    usize wide_units(const char8_t *s, usize n) noexcept {
+        usize units = 0;
+        for (usize i = 0; i < n;) {
+            usize          width = 0;
+            const char32_t cp    = decode_utf8(s + i, s + n, width);
+            units += (is_utf16<WideT> && cp > 0xFFFF) ? 2 : 1;
+            i += width;
+        }
+        return units;
+    }
+
+    /// output units for valid input: one per lead byte, plus one per 4-byte lead for UTF-16
+    template <typename WideT>
+    usize count_valid(const char8_t *s, usize n) noexcept {
+        usize units = 0;
+        for (usize i = 0; i < n; ++i) {
+            units += static_cast<usize>((s[i] & 0xC0) != 0x80);
+            if constexpr (is_utf16<WideT>) {
+                units += static_cast<usize>(s[i] >= 0xF0);
+            }
+        }
+        return units;
+    }
+
+    template <typename WideT>
+    usize to_wide(const char8_t *s, usize n, WideT *out) noexcept {
+        usize at = 0;
+        for (usize i = 0; i < n;) {
+            usize width = 0;
+            at += put_wide(decode_utf8(s + i, s + n, width), out + at);
+            i += width;
+        }
+        return at;
+    }
+
+    /// decodes valid input from `s[i]` until at least `stop`; returns the new input position
+    template <typename WideT>
+    HELIX_FORCE_INLINE usize
+    to_wide_valid(const char8_t *s, usize i, usize stop, WideT *out, usize &at) noexcept {
+        while (i < stop) {
+            usize width = 0;
+            at += put_wide(decode_valid(s + i, width), out + at);
+            i += width;
+        }
+        return i;
+    }
+
+    template <typename WideT>
+    HELIX_FORCE_INLINE usize utf8_bytes(const WideT *s, usize i, usize stop, usize n,
+                                        usize &bytes) noexcept {
+        while (i < stop) {
+            bytes += utf8_width(get_wide(s, i, n));
+        }
+        return i;
+    }
+
+    template <typename WideT>
+    HELIX_FORCE_INLINE usize
+    to_utf8(const WideT *s, usize i, usize stop, usize n, char8_t *out, usize &at) noexcept {
+        while (i < stop) {
+            at += encode_utf8(get_wide(s, i, n), out + at);
+        }
+        return i;
+    }
+}  // namespace scalar
+
+#if _HELIX_SEARCH_X86
+/// nibble tables for the lookup validator; each bit is one error class and a byte pair is
+/// invalid when the three lookups agree on a bit (or a required continuation is missing).
+namespace tables {
+    inline constexpr u8 too_short  = 1 << 0;  // 11______ 0_______ / 11______ 11______
+    inline constexpr u8 too_long   = 1 << 1;  // 0_______ 10______
+    inline constexpr u8 overlong_3 = 1 << 2;  // 11100000 100_____
+    inline constexpr u8 too_large  = 1 << 3;  // 11110100 1001____ / 11110101+ 10______
+    inline constexpr u8 surrogate  = 1 << 4;  // 11101101 101_____
+    inline constexpr u8 overlong_2 = 1 << 5;  // 1100000_ 10______
+    inline constexpr u8 large_1000 = 1 << 6;  // 11110101+ 1000____
+    inline constexpr u8 overlong_4 = 1 << 6;  // 11110000 1000____
+    inline constexpr u8 two_conts  = 1 << 7;  // 10______ 10______
+    inline constexpr u8 carry      = too_short | too_long | two_conts;
+
+    alignas(16) inline constexpr u8 byte_1_high[16] = {
+        too_long, too_long, too_long, too_long, too_long, too_long, too_long, too_long,
+        two_conts, two_conts, two_conts, two_conts,
+        too_short | overlong_2,
+        too_short,
+        too_short | overlong_3 | surrogate,
+        too_short | too_large | large_1000 | overlong_4,
+    };
+
+    alignas(16) inline constexpr u8 byte_1_low[16] = {
+        carry | overlong_3 | overlong_2 | overlong_4,
+        carry | overlong_2,
+        carry,
+        carry,
+        carry | too_large,
+        carry | too_large | large_1000,
+        carry | too_large | large_1000,
+        carry | too_large | large_1000,
+        carry | too_large | large_1000,
+        carry | too_large | large_1000,
+        carry | too_large | large_1000,
+        carry | too_large | large_1000,
+        carry | too_large | large_1000,
+        carry | too_large | large_1000 | surrogate,
+        carry | too_large | large_1000,
+        carry | too_large | large_1000,
+    };
+
+    alignas(16) inline constexpr u8 byte_2_high[16] = {
+        too_short, too_short, too_short, too_short, too_short, too_short, too_short, too_short,
+        too_long | overlong_2 | two_conts | overlong_3 | large_1000 | overlong_4,
+        too_long | overlong_2 | two_conts | overlong_3 | too_large,
+        too_long | overlong_2 | two_conts | surrogate | too_large,
+        too_long | overlong_2 | two_conts | surrogate | too_large,
+        too_short, too_short, too_short, too_short,
+    };
+
+    /// a block ending in these positions with a lead byte at least this large is incomplete
+    alignas(32) inline constexpr u8 incomplete[32] = {
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 0xEF, 0xDF, 0xBF,
+    };
+}  // namespace tables
+
+namespace sse42 {
+    constexpr usize block = 16;
+
+    /// number of set bytes in a compare mask
+    _HELIX_TARGET_SSE42 HELIX_FORCE_INLINE u32 bits(__m128i mask) noexcept {
+        return static_cast<u32>(libcxx::popcount(static_cast<u32>(_mm_movemask_epi8(mask))));
+    }
+
+    struct validator {
+        __m128i error           = _mm_setzero_si128();
+        __m128i prev_input      = _mm_setzero_si128();
+        __m128i prev_incomplete = _mm_setzero_si128();
+    };
+
+    _HELIX_TARGET_SSE42 inline void check_block(validator &v, __m128i input) noexcept {
+        if (_mm_movemask_epi8(input) == 0) {
+            v.error = _mm_or_si128(v.error, v.prev_incomplete);
+        } else {
+            const __m128i nib   = _mm_set1_epi8(0x0F);
+            const __m128i prev1 = _mm_alignr_epi8(input, v.prev_input, 15);
+            const __m128i prev2 = _mm_alignr_epi8(input, v.prev_input, 14);
+            const __m128i prev3 = _mm_alignr_epi8(input, v.prev_input, 13);
+
+            const __m128i b1h = _mm_shuffle_epi8(
+                _mm_load_si128(reinterpret_cast<const __m128i *>(tables::byte_1_high)),
+                _mm_and_si128(_mm_srli_epi16(prev1, 4), nib));
+            const __m128i b1l = _mm_shuffle_epi8(
+                _mm_load_si128(reinterpret_cast<const __m128i *>(tables::byte_1_low)),
+                _mm_and_si128(prev1, nib));
+            const __m128i b2h = _mm_shuffle_epi8(
+                _mm_load_si128(reinterpret_cast<const __m128i *>(tables::byte_2_high)),
+                _mm_and_si128(_mm_srli_epi16(input, 4), nib));
+
+            const __m128i special = _mm_and_si128(_mm_and_si128(b1h, b1l), b2h);
+            const __m128i third   = _mm_subs_epu8(prev2, _mm_set1_epi8(0xE0 - 0x80));
+            const __m128i fourth  = _mm_subs_epu8(prev3, _mm_set1_epi8(0xF0 - 0x80));
+            const __m128i must23 =
+                _mm_and_si128(_mm_or_si128(third, fourth), _mm_set1_epi8(static_cast<char>(0x80)));
+
+            v.error           = _mm_or_si128(v.error, _mm_xor_si128(must23, special));
+            v.prev_incomplete = _mm_subs_epu8(
+                input, _mm_load_si128(reinterpret_cast<const __m128i *>(tables::incomplete + 16)));
+        }
+        v.prev_input = input;
+    }
+
+    _HELIX_TARGET_SSE42 inline bool validate(const char8_t *s, usize n) noexcept {
+        validator v;
+        usize     i = 0;
+
+        for (; i + block <= n; i += block) {
+            check_block(v, _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i)));
+        }
+        if (i < n) {
+            alignas(16) char8_t tail[block] = {};
+            libcxx::memcpy(tail, s + i, n - i);
+            check_block(v, _mm_load_si128(reinterpret_cast<const __m128i *>(tail)));
+        }
+
+        const __m128i error = _mm_or_si128(v.error, v.prev_incomplete);
+        return _mm_testz_si128(error, error) != 0;
+    }
+
+    template <typename WideT>
+    _HELIX_TARGET_SSE42 usize count_valid(const char8_t *s, usize n) noexcept {
+        const __m128i cont = _mm_set1_epi8(-65);  // 0xBF: continuation bytes compare below it
+        const __m128i lead = _mm_set1_epi8(static_cast<char>(0xF0));  // 4-byte leads and up
+        usize         units = 0;
+        usize         i     = 0;
+
+        for (; i + block <= n; i += block) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+            units += bits(_mm_cmpgt_epi8(v, cont));
+            if constexpr (is_utf16<WideT>) {
+                units += bits(_mm_cmpeq_epi8(_mm_max_epu8(v, lead), v));
+            }
+        }
+        return units + scalar::count_valid<WideT>(s + i, n - i);
+    }
+
+    template <typename WideT>
+    _HELIX_TARGET_SSE42 usize to_wide_valid(const char8_t *s, usize n, WideT *out) noexcept {
+        usize at = 0;
+        usize i  = 0;
+
+        while (i + block <= n) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+            if (_mm_movemask_epi8(v) != 0) {
+                i = scalar::to_wide_valid(s, i, i + block, out, at);
+                continue;
+            }
+
+            auto *dst = reinterpret_cast<__m128i *>(out + at);
+            if constexpr (is_utf16<WideT>) {
+                _mm_storeu_si128(dst, _mm_cvtepu8_epi16(v));
+                _mm_storeu_si128(dst + 1, _mm_cvtepu8_epi16(_mm_srli_si128(v, 8)));
+            } else {
+                _mm_storeu_si128(dst, _mm_cvtepu8_epi32(v));
+                _mm_storeu_si128(dst + 1, _mm_cvtepu8_epi32(_mm_srli_si128(v, 4)));
+                _mm_storeu_si128(dst + 2, _mm_cvtepu8_epi32(_mm_srli_si128(v, 8)));
+                _mm_storeu_si128(dst + 3, _mm_cvtepu8_epi32(_mm_srli_si128(v, 12)));
+            }
+            at += block;
+            i += block;
+        }
+
+        scalar::to_wide_valid(s, i, n, out, at);
+        return at;
+    }
+
+    /// loads 16 wide units; `ascii` is set when none of them is above U+007F
+    template <typename WideT>
+    _HELIX_TARGET_SSE42 HELIX_FORCE_INLINE __m128i load_narrow(const WideT *s,
+                                                               bool        &ascii) noexcept {
+        const auto *p = reinterpret_cast<const __m128i *>(s);
+        if constexpr (is_utf16<WideT>) {
+            const __m128i a = _mm_loadu_si128(p);
+            const __m128i b = _mm_loadu_si128(p + 1);
+            ascii = _mm_testz_si128(_mm_or_si128(a, b), _mm_set1_epi16(static_cast<short>(0xFF80)));
+            return _mm_packus_epi16(a, b);
+        } else {
+            const __m128i a = _mm_loadu_si128(p);
+            const __m128i b = _mm_loadu_si128(p + 1);
+            const __m128i c = _mm_loadu_si128(p + 2);
+            const __m128i d = _mm_loadu_si128(p + 3);
+            ascii = _mm_testz_si128(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d)),
+                                    _mm_set1_epi32(~0x7F));
+            return _mm_packus_epi16(_mm_packus_epi32(a, b), _mm_packus_epi32(c, d));
+        }
+    }
+
+    template <typename WideT>
+    _HELIX_TARGET_SSE42 usize utf8_length(const WideT *s, usize n) noexcept {
+        usize bytes = 0;
+        usize i     = 0;
+
+        while (i + block <= n) {
+            const auto *p = reinterpret_cast<const __m128i *>(s + i);
+            if constexpr (is_utf16<WideT>) {
+                const __m128i a = _mm_loadu_si128(p);
+                const __m128i b = _mm_loadu_si128(p + 1);
+                const __m128i sur_mask = _mm_set1_epi16(static_cast<short>(0xF800));
+                const __m128i sur_bits = _mm_set1_epi16(static_cast<short>(0xD800));
+                const __m128i sur =
+                    _mm_or_si128(_mm_cmpeq_epi16(_mm_and_si128(a, sur_mask), sur_bits),
+                                 _mm_cmpeq_epi16(_mm_and_si128(b, sur_mask), sur_bits));
+                if (_mm_movemask_epi8(sur) != 0) {
+                    i = scalar::utf8_bytes(s, i, i + block, n, bytes);
+                    continue;
+                }
+
+                // byte masks: each 16-bit lane counts twice
+                const __m128i c80  = _mm_set1_epi16(0x80);
+                const __m128i c800 = _mm_set1_epi16(0x800);
+                const u32     extra = bits(_mm_cmpeq_epi16(_mm_max_epu16(a, c80), a)) +
+                                    bits(_mm_cmpeq_epi16(_mm_max_epu16(b, c80), b)) +
+                                    bits(_mm_cmpeq_epi16(_mm_max_epu16(a, c800), a)) +
+                                    bits(_mm_cmpeq_epi16(_mm_max_epu16(b, c800), b));
+                bytes += block + extra / 2;
+            } else {
+                // 1 + [>= 0x80] + [>= 0x800] + [0x10000 ..= 0x10FFFF]; everything else is 3
+                const __m128i lim[4] = {_mm_set1_epi32(0x80),
+                                        _mm_set1_epi32(0x800),
+                                        _mm_set1_epi32(0x10000),
+                                        _mm_set1_epi32(0x110000)};
+                u32           extra  = 0;
+                for (usize k = 0; k < 4; ++k) {
+                    const __m128i v = _mm_loadu_si128(p + k);
+                    for (usize t = 0; t < 3; ++t) {
+                        extra += bits(_mm_cmpeq_epi32(_mm_max_epu32(v, lim[t]), v)) / 4;
+                    }
+                    extra -= bits(_mm_cmpeq_epi32(_mm_max_epu32(v, lim[3]), v)) / 4;
+                }
+                bytes += block + extra;
+            }
+            i += block;
+        }
+
+        scalar::utf8_bytes(s, i, n, n, bytes);
+        return bytes;
+    }
+
+    template <typename WideT>
+    _HELIX_TARGET_SSE42 usize to_utf8(const WideT *s, usize n, char8_t *out) noexcept {
+        usize at = 0;
+        usize i  = 0;
+
+        while (i + block <= n) {
+            bool          ascii  = false;
+            const __m128i narrow = load_narrow(s + i, ascii);
+            if (!ascii) {
+                i = scalar::to_utf8(s, i, i + block, n, out, at);
+                continue;
+            }
+
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + at), narrow);
+            at += block;
+            i += block;
+        }
+
+        scalar::to_utf8(s, i, n, n, out, at);
+        return at;
+    }
+}  // namespace sse42
+
+namespace avx2 {
+    constexpr usize block = 32;
+
+    _HELIX_TARGET_AVX2 HELIX_FORCE_INLINE u32 bits(__m256i mask) noexcept {
+        return static_cast<u32>(libcxx::popcount(static_cast<u32>(_mm256_movemask_epi8(mask))));
+    }
+
+    struct validator {
+        __m256i error;
+        __m256i prev_input;
+        __m256i prev_incomplete;
+    };
+
+    _HELIX_TARGET_AVX2 HELIX_FORCE_INLINE __m256i table(const u8 *t) noexcept {
+        return _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(t)));
+    }
+
+    _HELIX_TARGET_AVX2 inline void check_block(validator &v, __m256i input) noexcept {
+        if (_mm256_movemask_epi8(input) == 0) {
+            v.error = _mm256_or_si256(v.error, v.prev_incomplete);
+        } else {
+            const __m256i nib   = _mm256_set1_epi8(0x0F);
+            const __m256i carry = _mm256_permute2x128_si256(v.prev_input, input, 0x21);
+            const __m256i prev1 = _mm256_alignr_epi8(input, carry, 15);
+            const __m256i prev2 = _mm256_alignr_epi8(input, carry, 14);
+            const __m256i prev3 = _mm256_alignr_epi8(input, carry, 13);
+
+            const __m256i b1h = _mm256_shuffle_epi8(
+                table(tables::byte_1_high), _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nib));
+            const __m256i b1l =
+                _mm256_shuffle_epi8(table(tables::byte_1_low), _mm256_and_si256(prev1, nib));
+            const __m256i b2h = _mm256_shuffle_epi8(
+                table(tables::byte_2_high), _mm256_and_si256(_mm256_srli_epi16(input, 4), nib));
+
+            const __m256i special = _mm256_and_si256(_mm256_and_si256(b1h, b1l), b2h);
+            const __m256i third   = _mm256_subs_epu8(prev2, _mm256_set1_epi8(0xE0 - 0x80));
+            const __m256i fourth  = _mm256_subs_epu8(prev3, _mm256_set1_epi8(0xF0 - 0x80));
+            const __m256i must23  = _mm256_and_si256(_mm256_or_si256(third, fourth),
+                                                    _mm256_set1_epi8(static_cast<char>(0x80)));
+
+            v.error           = _mm256_or_si256(v.error, _mm256_xor_si256(must23, special));
+            v.prev_incomplete = _mm256_subs_epu8(
+                input, _mm256_load_si256(reinterpret_cast<const __m256i *>(tables::incomplete)));
+        }
+        v.prev_input = input;
+    }
+
+    _HELIX_TARGET_AVX2 inline bool validate(const char8_t *s, usize n) noexcept {
+        validator v{_mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256()};
+        usize     i = 0;
+
+        for (; i + block <= n; i += block) {
+            check_block(v, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i)));
+        }
+        if (i < n) {
+            alignas(32) char8_t tail[block] = {};
+            libcxx::memcpy(tail, s + i, n - i);
+            check_block(v, _mm256_load_si256(reinterpret_cast<const __m256i *>(tail)));
+        }
+
+        const __m256i error = _mm256_or_si256(v.error, v.prev_incomplete);
+        return _mm256_testz_si256(error, error) != 0;
+    }
+
+    template <typename WideT>
+    _HELIX_TARGET_AVX2 usize count_valid(const char8_t *s, usize n) noexcept {
+        const __m256i cont  = _mm256_set1_epi8(-65);
+        const __m256i lead  = _mm256_set1_epi8(static_cast<char>(0xF0));
+        usize         units = 0;
+        usize         i     = 0;
+
+        for (; i + block <= n; i += block) {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i));
+            units += bits(_mm256_cmpgt_epi8(v, cont));
+            if constexpr (is_utf16<WideT>) {
+                units += bits(_mm256_cmpeq_epi8(_mm256_max_epu8(v, lead), v));
+            }
+        }
+        return units + scalar::count_valid<WideT>(s + i, n - i);
+    }
+
+    template <typename WideT>
+    _HELIX_TARGET_AVX2 usize to_wide_valid(const char8_t *s, usize n, WideT *out) noexcept {
+        usize at = 0;
+        usize i  = 0;
+
+        while (i + block <= n) {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i));
+            if (_mm256_movemask_epi8(v) != 0) {
+                i = scalar::to_wide_valid(s, i, i + block, out, at);
+                continue;
+            }
+
+            const __m128i lo  = _mm256_castsi256_si128(v);
+            const __m128i hi  = _mm256_extracti128_si256(v, 1);
+            auto         *dst = reinterpret_cast<__m256i *>(out + at);
+            if constexpr (is_utf16<WideT>) {
+                _mm256_storeu_si256(dst, _mm256_cvtepu8_epi16(lo));
+                _mm256_storeu_si256(dst + 1, _mm256_cvtepu8_epi16(hi));
+            } else {
+                _mm256_storeu_si256(dst, _mm256_cvtepu8_epi32(lo));
+                _mm256_storeu_si256(dst + 1, _mm256_cvtepu8_epi32(_mm_srli_si128(lo, 8)));
+                _mm256_storeu_si256(dst + 2, _mm256_cvtepu8_epi32(hi));
+                _mm256_storeu_si256(dst + 3, _mm256_cvtepu8_epi32(_mm_srli_si128(hi, 8)));
+            }
+            at += block;
+            i += block;
+        }
+
+        scalar::to_wide_valid(s, i, n, out, at);
+        return at;
+    }
+
+    /// all-ones in every 32-bit lane of `v` that is `>= lim` (unsigned)
+    _HELIX_TARGET_AVX2 HELIX_FORCE_INLINE __m256i at_least(__m256i v, __m256i lim) noexcept {
+        return _mm256_cmpeq_epi32(_mm256_max_epu32(v, lim), v);
+    }
+
+    /// the wide -> UTF-8 direction works on 16 units per step; at that width the 128-bit pack
+    /// instructions already saturate the store port, so only the length pass uses 256 bits.
+    template <typename WideT>
+    _HELIX_TARGET_AVX2 usize utf8_length(const WideT *s, usize n) noexcept {
+        constexpr usize step  = is_utf16<WideT> ? 16 : 8;
+        usize           bytes = 0;
+        usize           i     = 0;
+
+        if constexpr (!is_utf16<WideT>) {
+            // 1 + [>= 0x80] + [>= 0x800] + [0x10000 ..= 0x10FFFF] per unit, accumulated per lane
+            // and folded every 2^24 steps, before a lane can overflow
+            const __m256i c80     = _mm256_set1_epi32(0x80);
+            const __m256i c800    = _mm256_set1_epi32(0x800);
+            const __m256i c10000  = _mm256_set1_epi32(0x10000);
+            const __m256i c110000 = _mm256_set1_epi32(0x110000);
+
+            while (i + step <= n) {
+                const usize stop = libcxx::min(n - (n - i) % step, i + (usize(1) << 24) * step);
+                __m256i     acc  = _mm256_setzero_si256();
+
+                for (; i < stop; i += step) {
+                    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i));
+                    acc = _mm256_sub_epi32(acc, at_least(v, c80));
+                    acc = _mm256_sub_epi32(acc, at_least(v, c800));
+                    acc = _mm256_sub_epi32(acc, at_least(v, c10000));
+                    acc = _mm256_add_epi32(acc, at_least(v, c110000));
+                }
+
+                alignas(32) u32 lanes[8];
+                _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), acc);
+                for (const u32 lane : lanes) {
+                    bytes += lane;
+                }
+            }
+            bytes += i;
+        } else {
+            const __m256i c80      = _mm256_set1_epi16(0x80);
+            const __m256i c800     = _mm256_set1_epi16(0x800);
+            const __m256i sur_mask = _mm256_set1_epi16(static_cast<short>(0xF800));
+            const __m256i sur_bits = _mm256_set1_epi16(static_cast<short>(0xD800));
+
+            while (i + step <= n) {
+                const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i));
+                if (_mm256_movemask_epi8(_mm256_cmpeq_epi16(_mm256_and_si256(v, sur_mask),
+                                                            sur_bits)) != 0) {
+                    i = scalar::utf8_bytes(s, i, i + step, n, bytes);
+                    continue;
+                }
+
+                // byte masks: each 16-bit lane counts twice
+                const u32 extra = bits(_mm256_cmpeq_epi16(_mm256_max_epu16(v, c80), v)) +
+                                  bits(_mm256_cmpeq_epi16(_mm256_max_epu16(v, c800), v));
+                bytes += step + extra / 2;
+                i += step;
+            }
+        }
+
+        scalar::utf8_bytes(s, i, n, n, bytes);
+        return bytes;
+    }
+}  // namespace avx2
+#endif
+
+/// index of the first byte that does not start a well-formed sequence, or `npos`
+inline usize first_invalid_utf8(const char8_t *s, usize n) noexcept {
+    return scalar::first_invalid(s, n);
+}
+
+inline bool is_valid_utf8(const char8_t *s, usize n) noexcept {
+#if _HELIX_SEARCH_X86
+    switch (search::active_isa()) {
+        case Isa::AVX2:
+            return avx2::validate(s, n);
+        case Isa::SSE42:
+            return sse42::validate(s, n);
+        case Isa::Scalar:
+            break;
+    }
+#endif
+    return scalar::validate(s, n);
+}
+
+/// exact number of `WideT` units `utf8_to_wide` writes for `[s, s + n)`
+template <typename WideT>
+    requires WideUnit<WideT>
+length_t utf8_to_wide_length(const char8_t *s, usize n) noexcept {
+    if (!is_valid_utf8(s, n)) {
+        return {scalar::wide_units<WideT>(s, n), false};
+    }
+
+#if _HELIX_SEARCH_X86
+    switch (search::active_isa()) {
+        case Isa::AVX2:
+            return {avx2::count_valid<WideT>(s, n), true};
+        case Isa::SSE42:
+            return {sse42::count_valid<WideT>(s, n), true};
+        case Isa::Scalar:
+            break;
+    }
+#endif
+    return {scalar::count_valid<WideT>(s, n), true};
+}
+
+/// decodes `[s, s + n)` into `out`, which must hold `utf8_to_wide_length(s, n).units` units;
+/// `valid` must be the flag that call returned. returns the number of units written.
+template <typename WideT>
+    requires WideUnit<WideT>
+usize utf8_to_wide(const char8_t *s, usize n, WideT *out, bool valid) noexcept {
+    if (!valid) {
+        return scalar::to_wide(s, n, out);
+    }
+
+#if _HELIX_SEARCH_X86
+    switch (search::active_isa()) {
+        case Isa::AVX2:
+            return avx2::to_wide_valid(s, n, out);
+        case Isa::SSE42:
+            return sse42::to_wide_valid(s, n, out);
+        case Isa::Scalar:
+            break;
+    }
+#endif
+    usize at = 0;
+    scalar::to_wide_valid(s, 0, n, out, at);
+    return at;
+}
+
+/// decodes as many whole code points of `[s, s + n)` as fit in `cap` units of `out` and returns
+/// the units written; meant for fixed buffers where truncation is preferable to failing.
+template <typename WideT>
+    requires WideUnit<WideT>
+usize utf8_to_wide_bounded(const char8_t *s, usize n, WideT *out, usize cap) noexcept {
+    // no byte decodes to more than one unit (a 4-byte sequence to at most two), so `n` units
+    // always fit the whole input
+    if (n <= cap) {
+        return utf8_to_wide(s, n, out, is_valid_utf8(s, n));
+    }
+
+    usize at = 0;
+    for (usize i = 0; i < n;) {
+        usize          width = 0;
+        const char32_t cp    = decode_utf8(s + i, s + n, width);
+        if (at + ((is_utf16<WideT> && cp > 0xFFFF) ? 2 : 1) > cap) {
+            break;
+        }
+        at += scalar::put_wide(cp, out + at);
+        i += width;
+    }
+    return at;
+}
+
+/// exact number of bytes `wide_to_utf8` writes for `[s, s + n)`
+template <typename WideT>
+    requires WideUnit<WideT>
+usize wide_to_utf8_length(const WideT *s, usize n) noexcept {
+#if _HELIX_SEARCH_X86
+    switch (search::active_isa()) {
+        case Isa::AVX2:
+            return avx2::utf8_length(s, n);
+        case Isa::SSE42:
+            return sse42::utf8_length(s, n);
+        case Isa::Scalar:
+            break;
+    }
+#endif
+    usize bytes = 0;
+    scalar::utf8_bytes(s, 0, n, n, bytes);
+    return bytes;
+}
+
+/// encodes `[s, s + n)` into `out`, which must hold `wide_to_utf8_length(s, n)` bytes.
+/// returns the number of bytes written.
+template <typename WideT>
+    requires WideUnit<WideT>
+usize wide_to_utf8(const WideT *s, usize n, char8_t *out) noexcept {
+#if _HELIX_SEARCH_X86
+    if (search::active_isa() != Isa::Scalar) {
+        return sse42::to_utf8(s, n, out);
+    }
+#endif
+    usize at = 0;
+    scalar::to_utf8(s, 0, n, n, out, at);
+    return at;
+}
+}  // namespace String::__internal::transcode
+
+H_STD_NAMESPACE_END
+H_NAMESPACE_END
+
+#endif  // _$_HX_CORE_M9TRANSCODE
@@ -0,0 +1,245 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///-------------------------------------------------------------------------------- Lib-Helix ---///
+
+#ifndef _$_HX_CORE_M4UTF8
+#define _$_HX_CORE_M4UTF8
+
+#include <include/config/config.hh>
+
+#include <include/c++/libc++.hh>
+#include <include/types/builtins/builtins.hh>
+#include <include/types/string/basic.hh>
+#include <include/types/string/transcode.hh>
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+namespace String {
+/// \class utf8
+///
+/// UTF-8 native string storage, exposed to helix code as `u8string`.
+///
+/// `string` stores `wchar_t` (4 bytes per unit on posix) and every `const char *` that enters it
+/// is transcoded; `utf8` keeps the bytes as they arrive, so construction from a literal or from
+/// subprocess output is a plain copy and a string of mostly ascii text costs a quarter of the
+/// memory. conversion to and from `string` is explicit and sized in one pass.
+///
+/// ### Layout
+/// the object is three words. short strings (up to `inline_capacity` bytes, 22 on 64-bit
+/// targets) live inside those words; the last byte holds the length and doubles as the storage
+/// tag. longer strings use `{ptr, size, cap}`, where the top bit of `cap` lands on that same
+/// byte and marks the heap form. on big-endian targets the heap words are reversed so the tag
+/// byte is always the most significant byte of `cap`.
+///
+/// ### Code points
+/// `code_points()` walks the bytes as unicode scalar values without allocating. malformed
+/// sequences decode to U+FFFD and consume a single byte, so iteration always makes progress.
+class utf8 {
+  public:
+    using char_t = char8_t;
+    using size_t = usize;
+    using view_t = libcxx::basic_string_view<char8_t>;
+
+    class code_point_range;
+
+  private:
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    struct heap_t {
+        usize    cap;
+        usize    size;
+        char8_t *ptr;
+    };
+    static constexpr usize tag_at   = 0;
+    static constexpr usize local_at = 1;
+#else
+    struct heap_t {
+        char8_t *ptr;
+        usize    size;
+        usize    cap;
+    };
+    static constexpr usize tag_at   = sizeof(heap_t) - 1;
+    static constexpr usize local_at = 0;
+#endif
+
+    static constexpr usize heap_flag = usize(1) << ((sizeof(usize) * 8) - 1);
+
+    union {
+        heap_t        heap;
+        unsigned char bytes[sizeof(heap_t)];
+    } rep;
+
+  public:
+    /// bytes that fit without allocating (the tag byte and the terminator are excluded)
+    static constexpr usize inline_capacity = sizeof(heap_t) - 2;
+    static constexpr usize npos            = static_cast<usize>(-1);
+
+    // Constructors
+    utf8() noexcept { reset(); }
+    utf8(const utf8 &other);
+    utf8(utf8 &&other) noexcept;
+    utf8(const char8_t *str);
+    utf8(const char8_t *str, usize len);
+    utf8(view_t view);
+    utf8(const char *str);
+    utf8(const char *str, usize len);
+    explicit utf8(const nstring &str);
+    explicit utf8(const string &str);
+    ~utf8();
+
+    // Assignment
+    utf8 &operator=(const utf8 &other);
+    utf8 &operator=(utf8 &&other) noexcept;
+    utf8 &operator=(view_t view);
+
+    // Basic Access
+    [[nodiscard]] bool is_heap() const noexcept { return (rep.bytes[tag_at] & 0x80U) != 0; }
+    [[nodiscard]] bool is_inline() const noexcept { return !is_heap(); }
+
+    [[nodiscard]] const char8_t *raw() const noexcept {
+        return is_heap() ? rep.heap.ptr : reinterpret_cast<const char8_t *>(rep.bytes + local_at);
+    }
+    [[nodiscard]] const char *c_str() const noexcept {
+        return reinterpret_cast<const char *>(raw());
+    }
+    [[nodiscard]] usize size() const noexcept {
+        return is_heap() ? rep.heap.size : static_cast<usize>(rep.bytes[tag_at]);
+    }
+    [[nodiscard]] usize length() const noexcept { return size(); }
+    [[nodiscard]] usize capacity() const noexcept {
+        return is_heap() ? (rep.heap.cap & ~heap_flag) : inline_capacity;
+    }
+    [[nodiscard]] bool   is_empty() const noexcept { return size() == 0; }
+    [[nodiscard]] bool   empty() const noexcept { return size() == 0; }
+    [[nodiscard]] view_t view() const noexcept { return {raw(), size()}; }
+
+    void hash(Hash::Hasher *hasher) const noexcept { hasher->write(*this); }
+
+    char8_t operator[](usize index) const noexcept { return raw()[index]; }
+
+    // Mutable Methods
+    void reserve(usize new_cap);
+    void clear() noexcept { set_size(0); }
+    void push_back(char8_t c);
+    void push(char32_t code_point);
+    void append(const char8_t *str, usize len);
+    void append(view_t view) { append(view.data(), view.size()); }
+    void append(const utf8 &other) { append(other.raw(), other.size()); }
+
+    utf8 &operator+=(const utf8 &other);
+    utf8 &operator+=(view_t view);
+    utf8 &operator+=(char32_t code_point);
+    utf8  operator+(const utf8 &other) const;
+    utf8  operator+(view_t view) const;
+
+    // Comparison Operators
+    bool operator==(const utf8 &other) const noexcept { return view() == other.view(); }
+    bool operator!=(const utf8 &other) const noexcept { return view() != other.view(); }
+    bool operator<(const utf8 &other) const noexcept { return view() < other.view(); }
+    bool operator>(const utf8 &other) const noexcept { return view() > other.view(); }
+    bool operator<=(const utf8 &other) const noexcept { return view() <= other.view(); }
+    bool operator>=(const utf8 &other) const noexcept { return view() >= other.view(); }
+
+    // Code Points
+    [[nodiscard]] code_point_range code_points() const noexcept;
+    [[nodiscard]] usize            code_point_count() const noexcept;
+
+    // Conversion
+    [[nodiscard]] string  to_string() const;
+    [[nodiscard]] nstring to_nstring() const { return {c_str(), size()}; }
+
+    string operator$cast(const string * /* p */) const { return to_string(); }
+
+    // Iterators (bytes)
+    const char8_t *begin() const noexcept { return raw(); }
+    const char8_t *end() const noexcept { return raw() + size(); }
+
+  private:
+    char8_t *mut_raw() noexcept {
+        return is_heap() ? rep.heap.ptr : reinterpret_cast<char8_t *>(rep.bytes + local_at);
+    }
+
+    void reset() noexcept { libcxx::memset(rep.bytes, 0, sizeof(rep.bytes)); }
+    void release() noexcept;
+    void set_size(usize len) noexcept;
+    void assign(const char8_t *str, usize len);
+    void grow(usize min_cap);
+};
+
+/// forward range over the code points of a `utf8` string (or any UTF-8 byte view).
+class utf8::code_point_range {
+    view_t source;
+
+  public:
+    class iterator {
+        const char8_t *pos;
+        const char8_t *stop;
+        char32_t       current = 0;
+        usize          width   = 0;
+
+        void decode() noexcept;
+
+      public:
+        using value_type      = char32_t;
+        using difference_type = isize;
+
+        iterator(const char8_t *pos, const char8_t *stop) noexcept
+            : pos(pos)
+            , stop(stop) {
+            decode();
+        }
+
+        char32_t operator*() const noexcept { return current; }
+
+        iterator &operator++() noexcept {
+            pos += width;
+            decode();
+            return *this;
+        }
+        void operator++(int) noexcept { ++*this; }
+
+        bool operator==(libcxx::default_sentinel_t /*unused*/) const noexcept {
+            return pos == stop;
+        }
+    };
+
+    explicit code_point_range(view_t source) noexcept
+        : source(source) {}
+
+    iterator begin() const noexcept { return {source.data(), source.data() + source.size()}; }
+    constexpr libcxx::default_sentinel_t end() const noexcept { return {}; }
+};
+
+#if defined(__HELIX_64BIT__)
+static_assert(sizeof(utf8) == 3 * sizeof(usize) && utf8::inline_capacity >= 22,
+              "utf8 must stay three words with at least 22 inline bytes");
+#endif
+}  // namespace String
+
+H_STD_NAMESPACE_END
+
+using u8string = std::String::utf8;
+
+H_NAMESPACE_END
+
+namespace std {
+template <>
+struct hash<helix::u8string> {
+    size_t operator()(const helix::u8string &s) const noexcept {
+        return static_cast<size_t>(helix::std::Hash::text(s));
+    }
+};
+}  // namespace std
+
+#endif  // _$_HX_CORE_M4UTF8
@@ -19,148 +19,143 @@
 #include <include/config/config.hh>
 
 #include <include/c++/libc++.hh>
+#include <include/types/builtins/primitives.hh>
+#include <include/types/type_erasure/type_id.hh>
 
 H_NAMESPACE_BEGIN
 H_STD_NAMESPACE_BEGIN
 
 /// \class TypeErasure
 ///
-/// `TypeErasure` is an abstract base class that provides a mechanism for type erasure.
-/// This class serves as the foundation for managing objects of arbitrary types without
-/// exposing their concrete implementation details. It is particularly useful for
-/// generic systems requiring heterogeneous collections, dynamic polymorphism, or
-/// runtime type inspection.
+/// `TypeErasure` holds one object of any copyable type by value, without exposing the type. It
+/// is useful for generic systems requiring heterogeneous collections or runtime type inspection.
 ///
 /// ### Design Details
-/// - **Abstract Interface**: `TypeErasure` defines an interface with pure virtual
-///   methods that subclasses must implement. These methods handle object destruction,
-///   type retrieval, cloning, and access.
-/// - **Dynamic Lifetime Management**: It ensures safe destruction and cleanup of
-///   objects, allowing proper lifecycle management within a type-erased context.
-/// - **Runtime Type Information**: The `type_info` method provides RTTI for the
-///   stored object, enabling dynamic type checks.
+/// - **Inline Storage**: Objects of up to `inline_size` bytes that are pointer-aligned and move
+///   without throwing live inside the `TypeErasure` itself; larger ones get one allocation.
+/// - **Static Dispatch**: Copying, moving and destroying go through a constant table of
+///   function pointers, one per stored type, instead of virtual calls. A null entry means the
+///   storage is copied as plain bytes or needs no cleanup.
+/// - **Type Identity**: `type()` is the stored type's `TypeId`, so `is<T>()` and `get<T>()`
+///   are a single pointer compare for an object erased in this module (see `TypeId`).
+///   `type_info()` is still there for the type's name.
 ///
 /// ### Usage
-/// `TypeErasure` is not meant to be used directly. Instead, it is subclassed to wrap
-/// specific object types. For example, `TypeErasureImpl<T>` is a concrete implementation
-/// that can store objects of type `T`.
-///
-/// ### Responsibilities
-/// - Provide an interface for type-erased storage and manipulation.
-/// - Abstract away the underlying type of stored objects while maintaining access
-///   to their functionality.
-///
-/// ### Interactions with FrameContext
-/// `TypeErasure` is a key component of the `FrameContext` class. It allows `FrameContext`
-/// to store and manage objects of arbitrary types while ensuring proper cleanup and
-/// exception handling.
-///
-/// ### Key Methods
-/// - `destroy()`: Safely destroys the stored object.
-/// - `type_info()`: Retrieves runtime type information of the stored object.
-/// - `clone()`: Creates a deep copy of the type-erased object.
-///
-/// ### Example
 /// \code{.cpp}
-/// // creating a typeerasure instance
-/// TypeErasure *erased = new TypeErasureImpl<MyType>(new MyType());
+/// TypeErasure erased(MyType{});
 ///
-/// // accessing type information
-/// const libcxx::type_info *info = erased->type_info();
+/// if (erased.is<MyType>()) {
+///     MyType *object = erased.get<MyType>();
+/// }
 ///
-/// // destroying the object
-/// erased->destroy();
-/// delete erased;
+/// TypeErasure copy = erased;  // copies the MyType
+/// erased.destroy();           // empty again; the destructor does the same
 /// \endcode
+///
+/// `FrameContext` does not use this class: it keeps the error object in its own shared block
+/// with its own per-type table, which adds what a panic needs (the reason and rethrowing).
 class TypeErasure {
   public:
-    constexpr virtual ~TypeErasure() = default;
-
-    constexpr TypeErasure()                                   = default;
-    constexpr TypeErasure(const TypeErasure &)                = default;
-    constexpr TypeErasure &operator=(const TypeErasure &)     = default;
-    constexpr TypeErasure(TypeErasure &&) noexcept            = default;
-    constexpr TypeErasure &operator=(TypeErasure &&) noexcept = default;
-
-    constexpr virtual void                                   destroy()         = 0;
-    constexpr virtual void                                  *operator*()       = 0;
-    [[nodiscard]] constexpr virtual const libcxx::type_info *type_info() const = 0;
-    [[nodiscard]] constexpr virtual TypeErasure             *clone() const     = 0;
-};
+    /// objects up to this size are stored inline if they are pointer-aligned and move without
+    /// throwing
+    static constexpr usize inline_size = 3 * sizeof(void *);
 
-/// \class TypeErasureImpl
-///
-/// \warning This class does not free the memory of the object it holds, it is the
-///          responsibility of the caller to free the memory.
-///
-/// `TypeErasureImpl` is a templated implementation of the `TypeErasure` interface. It
-/// provides type-erased storage and management for objects of type `T`. This class
-/// encapsulates the object, allowing it to be manipulated without exposing its type.
-///
-/// ### Design Details
-/// - **Type-Specific Storage**: `TypeErasureImpl` wraps an object of type `T`,
-///   providing type-erased functionality.
-/// - **Dynamic Behavior**: Implements methods for destruction, cloning, and access,
-///   ensuring the stored object can be safely managed within a type-erased context.
-/// - **Integration with FrameContext**: This class is used by `FrameContext` to
-///   manage objects dynamically, supporting panic handling and exception throwing.
-///
-/// ### Responsibilities
-/// - Manage the lifetime of an object of type `T`.
-/// - Provide a mechanism to retrieve runtime type information for `T`.
-/// - Enable cloning of the type-erased wrapper.
-///
-/// ### Implementation Notes
-/// - The `destroy()` method ensures the wrapped object is properly deleted.
-/// - The `clone()` method creates a deep copy of the wrapped object, maintaining
-///   type safety within the type-erased system.
-///
-/// ### Interactions
-/// `TypeErasureImpl` is used internally by `FrameContext` and is not typically
-/// exposed to end users. It enables `FrameContext` to work with heterogeneous types
-/// while maintaining strong exception safety guarantees.
-///
-/// \warning This class is NOT memory safe.
-///
-/// ### Example
-/// \code{.cpp}
-/// // wrapping an object of type mytype
-/// MyType *myObj = new MyType();
-/// TypeErasureImpl<MyType> erased(myObj);
-///
-/// // accessing runtime type information
-/// const libcxx::type_info *info = erased.type_info();
-///
-/// // safely destroying the object
-/// erased.destroy();
-/// \endcode
-template <typename T>
-class TypeErasureImpl : public TypeErasure {
   private:
-    T                       *object;
-    const libcxx::type_info *type;
-    bool                     is_destroyed = false;  // Guard against double deletion
+    struct Ops {
+        TypeId                   id;
+        const libcxx::type_info *type;
+        bool                     in_buffer;
+        void (*copy)(TypeErasure &, const TypeErasure &);
+        void (*move)(TypeErasure &, TypeErasure &) noexcept;
+        void (*destroy)(TypeErasure &) noexcept;
+    };
+
+    template <typename T>
+    static constexpr bool stored_inline = sizeof(T) <= inline_size &&
+                                          alignof(T) <= alignof(void *) &&
+                                          libcxx::is_nothrow_move_constructible_v<T>;
+
+    template <typename T>
+    static void copy_object(TypeErasure &dst, const TypeErasure &src);
+
+    template <typename T>
+    static void move_object(TypeErasure &dst, TypeErasure &src) noexcept;
+
+    template <typename T>
+    static void destroy_object(TypeErasure &erased) noexcept;
+
+    /// a heap object moves by handing over its pointer, and an inline trivially copyable one
+    /// by copying the buffer, so only the rest get a `move`
+    template <typename T>
+    static constexpr Ops make_ops() noexcept {
+        Ops ops{TypeId::of<T>(), &typeid(T), stored_inline<T>, nullptr, nullptr, nullptr};
+
+        if constexpr (!stored_inline<T> || !libcxx::is_trivially_copyable_v<T>) {
+            ops.copy    = &copy_object<T>;
+            ops.destroy = &destroy_object<T>;
+        }
+
+        if constexpr (stored_inline<T> && !libcxx::is_trivially_copyable_v<T>) {
+            ops.move = &move_object<T>;
+        }
+
+        return ops;
+    }
+
+    template <typename T>
+    static constexpr Ops ops_for = make_ops<T>();
+
+    template <typename T>
+    [[nodiscard]] T *target() const noexcept;
+
+    void copy_from(const TypeErasure &other);
+    void move_from(TypeErasure &other) noexcept;
+
+    const Ops *ops = nullptr;
+    union {
+        void *heap;
+        alignas(void *) unsigned char buffer[inline_size];
+    };
 
   public:
-    // Constructors
-    TypeErasureImpl(const TypeErasureImpl &other);
-    explicit TypeErasureImpl(T *obj);
+    TypeErasure() noexcept {}
+
+    template <typename T>
+        requires(!libcxx::is_same_v<libcxx::remove_cvref_t<T>, TypeErasure>)
+    explicit TypeErasure(T &&value);
+
+    TypeErasure(const TypeErasure &other);
+    TypeErasure(TypeErasure &&other) noexcept;
+    TypeErasure &operator=(const TypeErasure &other);
+    TypeErasure &operator=(TypeErasure &&other) noexcept;
+    ~TypeErasure();
+
+    /// replaces the stored object with a `T` built from `args`
+    template <typename T, typename... Args>
+    T &emplace(Args &&...args);
+
+    /// destroys the stored object, leaving the `TypeErasure` empty
+    void destroy() noexcept;
+
+    [[nodiscard]] bool                     has_value() const noexcept;
+    [[nodiscard]] TypeId                   type() const noexcept;
+    [[nodiscard]] const libcxx::type_info *type_info() const noexcept;
+
+    template <typename T>
+    [[nodiscard]] bool is() const noexcept;
 
-    // Assignment Operators
-    TypeErasureImpl &operator=(const TypeErasureImpl &other);
-    TypeErasureImpl &operator=(TypeErasureImpl &&other) noexcept;
+    /// the stored object if it is a `T`, otherwise null
+    template <typename T>
+    [[nodiscard]] T *get() noexcept;
 
-    // Move Constructor
-    TypeErasureImpl(TypeErasureImpl &&other) noexcept;
+    template <typename T>
+    [[nodiscard]] const T *get() const noexcept;
 
-    // Destructor
-    ~TypeErasureImpl() override;
+    [[nodiscard]] void       *operator*() noexcept;
+    [[nodiscard]] const void *operator*() const noexcept;
 
-    // Override Methods
-    void                                   destroy() override;
-    void                                  *operator*() override;
-    [[nodiscard]] const libcxx::type_info *type_info() const override;
-    [[nodiscard]] TypeErasure             *clone() const override;
+    /// a deep copy; throws for an empty `TypeErasure`
+    [[nodiscard]] TypeErasure clone() const;
 };
 
 H_STD_NAMESPACE_END
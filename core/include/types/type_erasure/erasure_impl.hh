@@ -26,83 +26,159 @@ H_NAMESPACE_BEGIN
 H_STD_NAMESPACE_BEGIN
 
 template <typename T>
-inline TypeErasureImpl<T>::TypeErasureImpl(const TypeErasureImpl &other)
-    : object(new T(*other.object))
-    , type(other.type)
-    , is_destroyed(other.is_destroyed) {}
+inline T *TypeErasure::target() const noexcept {
+    if constexpr (stored_inline<T>) {
+        return libcxx::launder(reinterpret_cast<T *>(const_cast<unsigned char *>(buffer)));
+    } else {
+        return static_cast<T *>(heap);
+    }
+}
 
 template <typename T>
-inline TypeErasureImpl<T> &TypeErasureImpl<T>::operator=(const TypeErasureImpl &other) {
-    if (this != &other) {
-        if (object != nullptr) {  // NOLINT(readability-delete-null-pointer)
-            delete object;
-        }
-        object       = new T(*other.object);  // NOLINT(cppcoreguidelines-owning-memory)
-        is_destroyed = other.is_destroyed;
-        type         = other.type;
+inline void TypeErasure::copy_object(TypeErasure &dst, const TypeErasure &src) {
+    if constexpr (stored_inline<T>) {
+        ::new (static_cast<void *>(dst.buffer)) T(*src.target<T>());
+    } else {
+        dst.heap = new T(*src.target<T>());  // NOLINT(cppcoreguidelines-owning-memory)
     }
-    return *this;
 }
 
 template <typename T>
-inline TypeErasureImpl<T>::TypeErasureImpl(TypeErasureImpl &&other) noexcept
-    : object(other.object)
-    , type(other.type)
-    , is_destroyed(other.is_destroyed) {
-    other.object       = nullptr;
-    other.is_destroyed = true;
+inline void TypeErasure::move_object(TypeErasure &dst, TypeErasure &src) noexcept {
+    T *from = src.target<T>();
+    ::new (static_cast<void *>(dst.buffer)) T(std::Memory::move(*from));
+    from->~T();
+}
+
+template <typename T>
+inline void TypeErasure::destroy_object(TypeErasure &erased) noexcept {
+    if constexpr (stored_inline<T>) {
+        erased.target<T>()->~T();
+    } else {
+        delete erased.target<T>();  // NOLINT(cppcoreguidelines-owning-memory)
+    }
+}
+
+inline void TypeErasure::copy_from(const TypeErasure &other) {
+    if (other.ops == nullptr) {
+        return;
+    }
+
+    if (other.ops->copy == nullptr) {
+        libcxx::memcpy(buffer, other.buffer, inline_size);
+    } else {
+        other.ops->copy(*this, other);
+    }
+
+    ops = other.ops;
+}
+
+inline void TypeErasure::move_from(TypeErasure &other) noexcept {
+    if (other.ops == nullptr) {
+        return;
+    }
+
+    if (other.ops->move == nullptr) {
+        libcxx::memcpy(buffer, other.buffer, inline_size);
+    } else {
+        other.ops->move(*this, other);
+    }
+
+    ops       = other.ops;
+    other.ops = nullptr;
 }
 
 template <typename T>
-inline TypeErasureImpl<T> &TypeErasureImpl<T>::operator=(TypeErasureImpl &&other) noexcept {
+    requires(!libcxx::is_same_v<libcxx::remove_cvref_t<T>, TypeErasure>)
+inline TypeErasure::TypeErasure(T &&value) {
+    emplace<libcxx::remove_cvref_t<T>>(std::Memory::forward<T>(value));
+}
+
+inline TypeErasure::TypeErasure(const TypeErasure &other) { copy_from(other); }
+
+inline TypeErasure::TypeErasure(TypeErasure &&other) noexcept { move_from(other); }
+
+inline TypeErasure &TypeErasure::operator=(const TypeErasure &other) {
     if (this != &other) {
-        if (object != nullptr) {  // NOLINT(readability-delete-null-pointer)
-            delete object;
-        }
-        object             = other.object;
-        is_destroyed       = other.is_destroyed;
-        other.object       = nullptr;
-        other.is_destroyed = true;
-        type               = other.type;
+        destroy();
+        copy_from(other);
     }
     return *this;
 }
 
-template <typename T>
-inline TypeErasureImpl<T>::TypeErasureImpl(T *obj)
-    : object(obj)
-    , type(&typeid(T)) {}
+inline TypeErasure &TypeErasure::operator=(TypeErasure &&other) noexcept {
+    if (this != &other) {
+        destroy();
+        move_from(other);
+    }
+    return *this;
+}
 
-template <typename T>
-inline void TypeErasureImpl<T>::destroy() {
-    if (!is_destroyed && object != nullptr) {
-        delete object;
-        object       = nullptr;
-        is_destroyed = true;
+inline TypeErasure::~TypeErasure() { destroy(); }
+
+template <typename T, typename... Args>
+inline T &TypeErasure::emplace(Args &&...args) {
+    destroy();
+
+    if constexpr (stored_inline<T>) {
+        ::new (static_cast<void *>(buffer)) T(std::Memory::forward<Args>(args)...);
+    } else {
+        // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+        heap = new T(std::Memory::forward<Args>(args)...);
+    }
+
+    ops = &ops_for<T>;
+    return *target<T>();
+}
+
+inline void TypeErasure::destroy() noexcept {
+    if (ops != nullptr) {
+        if (ops->destroy != nullptr) {
+            ops->destroy(*this);
+        }
+        ops = nullptr;
     }
 }
 
+inline bool TypeErasure::has_value() const noexcept { return ops != nullptr; }
+
+inline TypeId TypeErasure::type() const noexcept { return ops != nullptr ? ops->id : TypeId(); }
+
+inline const libcxx::type_info *TypeErasure::type_info() const noexcept {
+    return ops != nullptr ? ops->type : nullptr;
+}
+
 template <typename T>
-inline void *TypeErasureImpl<T>::operator*() {
-    return object;
+inline bool TypeErasure::is() const noexcept {
+    return ops != nullptr && ops->id == TypeId::of<T>();
 }
 
 template <typename T>
-inline const libcxx::type_info *TypeErasureImpl<T>::type_info() const {
-    return type;
+inline T *TypeErasure::get() noexcept {
+    return is<T>() ? target<T>() : nullptr;
 }
 
 template <typename T>
-inline TypeErasure *TypeErasureImpl<T>::clone() const {
-    if (object == nullptr) {
-        throw std::Error::RuntimeError(L"Cannot clone a null object.");
+inline const T *TypeErasure::get() const noexcept {
+    return is<T>() ? target<T>() : nullptr;
+}
+
+inline void *TypeErasure::operator*() noexcept {
+    if (ops == nullptr) {
+        return nullptr;
     }
-    return new TypeErasureImpl<T>(new T(*object));  // NOLINT(cppcoreguidelines-owning-memory)
+    return ops->in_buffer ? static_cast<void *>(buffer) : heap;
 }
 
-template <typename T>
-inline TypeErasureImpl<T>::~TypeErasureImpl() {
-    object = nullptr;  // Note: destroy() should be called explicitly to delete object
+inline const void *TypeErasure::operator*() const noexcept {
+    return **const_cast<TypeErasure *>(this);
+}
+
+inline TypeErasure TypeErasure::clone() const {
+    if (ops == nullptr) {
+        throw std::Error::RuntimeError(L"Cannot clone a null object.");
+    }
+    return *this;
 }
 
 H_STD_NAMESPACE_END
@@ -26,7 +26,7 @@ H_STD_NAMESPACE_BEGIN
 
 /// \fn erase_type
 ///
-/// Erases the type of an object `obj` and returns a `TypeErasure` wrapper.
+/// Erases the type of an object `obj` and returns a `TypeErasure` holding it.
 ///
 /// ### Purpose
 /// The `erase_type` function creates a type-erased wrapper for an object, allowing
@@ -34,19 +34,22 @@ H_STD_NAMESPACE_BEGIN
 /// for working with heterogeneous collections or dynamic polymorphism.
 ///
 /// ### Parameters
-/// - `obj`: A pointer to the object to be type-erased.
+/// - `obj`: A pointer to the object to be type-erased. The object is copied into the wrapper,
+///   inline if it is small, and `obj` stays with the caller.
 ///
 /// ### Returns
-/// A `TypeErasure` pointer that wraps the object, providing type-erased access.
+/// A `TypeErasure` that owns its copy of the object, providing type-erased access.
 ///
 /// ### Example
 /// ```cpp
-/// MyType *obj = new MyType();
-/// TypeErasure *erased = erase_type(obj);
+/// MyType obj;
+/// TypeErasure erased = erase_type(&obj);
 /// ```
 template <typename T>
-[[nodiscard]] TypeErasure *erase_type(T *obj) {
-    return new TypeErasureImpl<T>(obj);  // NOLINT(cppcoreguidelines-owning-memory)
+[[nodiscard]] TypeErasure erase_type(T *obj) {
+    TypeErasure erased;
+    erased.emplace<T>(*obj);
+    return erased;
 }
 
 H_STD_NAMESPACE_END
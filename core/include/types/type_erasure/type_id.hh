@@ -0,0 +1,74 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///-------------------------------------------------------------------------------- Lib-Helix ---///
+
+#ifndef _$_HX_CORE_M7TYPE_ID
+#define _$_HX_CORE_M7TYPE_ID
+
+#include <include/config/config.hh>
+
+#include <include/c++/libc++.hh>
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+/// \class TypeId
+///
+/// The identity of a type as the address of a per-type tag, for the checks the runtime makes on
+/// every error match (`$contains`, `catch` dispatch, `as` casts). `TypeId::of<T>()` is a
+/// constant and two ids of the same type from the same module are one pointer compare. cv and
+/// reference qualifiers are ignored, as with `typeid`.
+///
+/// Each shared object gets its own copy of the tag when symbols are hidden, as in release
+/// builds, so an error raised in one module would not match an id taken in another. The tag
+/// therefore holds the type's `type_info`, and ids whose tags differ fall back to comparing
+/// those, the same check `catch` makes across modules.
+///
+/// A default-constructed `TypeId` identifies no type.
+///
+/// ### Example
+/// \code{.cpp}
+/// constexpr TypeId id = TypeId::of<Error::RuntimeError>();
+/// if (error.type() == id) { ... }
+/// \endcode
+class TypeId {
+  public:
+    constexpr TypeId() noexcept = default;
+
+    template <typename T>
+    [[nodiscard]] static constexpr TypeId of() noexcept {
+        return TypeId(&tag<libcxx::remove_cvref_t<T>>);
+    }
+
+    constexpr bool operator==(const TypeId &rhs) const noexcept {
+        return id == rhs.id || (id != nullptr && rhs.id != nullptr && **id == **rhs.id);
+    }
+
+    explicit constexpr operator bool() const noexcept { return id != nullptr; }
+
+  private:
+    explicit constexpr TypeId(const libcxx::type_info *const *tag) noexcept
+        : id(tag) {}
+
+    // every tag points at a different `type_info`, so identical-code folding never merges two
+    template <typename T>
+    static constexpr const libcxx::type_info *tag = &typeid(T);
+
+    const libcxx::type_info *const *id = nullptr;
+};
+
+H_STD_NAMESPACE_END
+H_NAMESPACE_END
+
+#endif  // _$_HX_CORE_M7TYPE_ID
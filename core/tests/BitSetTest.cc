@@ -0,0 +1,183 @@
+#include <include/core.hh>
+
+#include <cstdio>
+#include <random>
+
+// differential test of the composite __BitSet integers: the 128-bit forms against the compiler's
+// __int128, and u256/i256 against a bit-serial reference over random operands of every length
+
+using helix::operator""_u256;
+using helix::operator""_i256;
+
+using ull      = unsigned long long;
+using sll      = signed long long;
+using u128_set = helix::__BitSet<helix::__BitSet<ull>, helix::__BitSet<ull>>;
+using i128_set = helix::__BitSet<helix::__BitSet<sll>, helix::__BitSet<sll>>;
+
+// every operation is constexpr, so a wrong answer here fails to compile
+static_assert(340282366920938463463374607431768211456_u256 / 18446744073709551616_u256 ==
+              u256(0ULL, 0ULL, 1ULL, 0ULL));
+static_assert(-7_i256 / i256(2LL) == i256(-3LL) && -7_i256 % i256(2LL) == i256(-1LL));
+static_assert((u256::max_value() * u256::max_value()) == u256(1ULL));
+static_assert(i256::min_value() < i256(0LL) && i256(0LL) < i256::max_value());
+static_assert((i256::min_value() >> 255) == i256(-1LL) && (u256(1ULL) << 256) == u256(0ULL));
+
+static int failures = 0;
+
+static void check(bool ok, const char *what, const u256 &a, const u256 &b) {
+    if (!ok && failures++ < 10) {
+        std::printf("FAIL %s: %s, ", what, a.to_cstr());
+        std::printf("%s\n", b.to_cstr());
+    }
+}
+
+namespace reference {
+using limbs = helix::std::Limbs::__internal::limbs<4>;
+
+limbs shl1(limbs a) {
+    for (int i = 3; i > 0; --i) {
+        a.w[i] = (a.w[i] << 1) | (a.w[i - 1] >> 63);
+    }
+    a.w[0] <<= 1;
+    return a;
+}
+
+bool less(const limbs &a, const limbs &b) {
+    for (int i = 3; i >= 0; --i) {
+        if (a.w[i] != b.w[i]) {
+            return a.w[i] < b.w[i];
+        }
+    }
+    return false;
+}
+
+limbs add(const limbs &a, const limbs &b) {
+    limbs r;
+    u64   carry = 0;
+    for (int i = 0; i < 4; ++i) {
+        const u64 s = a.w[i] + carry;
+        r.w[i]      = s + b.w[i];
+        carry       = (s < carry) + (r.w[i] < s);
+    }
+    return r;
+}
+
+limbs sub(const limbs &a, const limbs &b) {
+    limbs r;
+    u64   borrow = 0;
+    for (int i = 0; i < 4; ++i) {
+        r.w[i] = a.w[i] - b.w[i] - borrow;
+        borrow = (a.w[i] < b.w[i]) || (a.w[i] - b.w[i] < borrow);
+    }
+    return r;
+}
+
+limbs mul(const limbs &a, limbs b) {
+    limbs r;
+    for (int i = 0; i < 256; ++i) {
+        if ((a.w[i / 64] >> (i % 64)) & 1) {
+            r = add(r, b);
+        }
+        b = shl1(b);
+    }
+    return r;
+}
+
+void divmod(const limbs &n, const limbs &d, limbs &q, limbs &r) {
+    q = r = limbs{};
+    for (int i = 255; i >= 0; --i) {
+        r = shl1(r);
+        r.w[0] |= (n.w[i / 64] >> (i % 64)) & 1;
+        if (!less(r, d)) {
+            r = sub(r, d);
+            q.w[i / 64] |= u64(1) << (i % 64);
+        }
+    }
+}
+}  // namespace reference
+
+int main() {
+    std::mt19937_64 rng(0x256);
+
+    auto operand = [&] {
+        reference::limbs v;
+        for (auto &w : v.w) {
+            w = rng();
+        }
+        const unsigned keep = rng() % 257;
+        for (unsigned i = 0; i < 4; ++i) {
+            if (i * 64 >= keep) {
+                v.w[i] = 0;
+            } else if (keep - i * 64 < 64) {
+                v.w[i] &= (u64(1) << (keep - i * 64)) - 1;
+            }
+        }
+        return v;
+    };
+
+    constexpr int rounds = 200000;
+    for (int i = 0; i < rounds; ++i) {
+        const auto ra = operand();
+        auto       rb = operand();
+        if (helix::std::Limbs::__internal::is_zero(rb)) {
+            rb.w[0] = 1;
+        }
+        const u256 a = u256::from_limbs(ra);
+        const u256 b = u256::from_limbs(rb);
+
+        reference::limbs q, r;
+        reference::divmod(ra, rb, q, r);
+        check(a + b == u256::from_limbs(reference::add(ra, rb)), "u256 +", a, b);
+        check((a - b) + b == a, "u256 -", a, b);
+        check(a * b == u256::from_limbs(reference::mul(ra, rb)), "u256 *", a, b);
+        check(a / b == u256::from_limbs(q), "u256 /", a, b);
+        check(a % b == u256::from_limbs(r), "u256 %", a, b);
+        check((a < b) == reference::less(ra, rb), "u256 <", a, b);
+
+        const unsigned   shift   = rng() % 260;
+        reference::limbs shifted = ra;
+        for (unsigned s = 0; s < shift; ++s) {
+            shifted = reference::shl1(shifted);
+        }
+        const u256 low_bits = shift >= 256 ? ~u256(0ULL) : (u256(1ULL) << shift) - u256(1ULL);
+        check((a << shift) == u256::from_limbs(shifted), "u256 <<", a, b);
+        check(((a >> shift) << shift) == (a & ~low_bits), "u256 >>", a, b);
+
+        // signed: the quotient truncates toward zero and the remainder takes the dividend's sign
+        const i256 sa = (rng() & 1) ? -i256::from_limbs(ra) : i256::from_limbs(ra);
+        const i256 sb = (rng() & 1) ? -i256::from_limbs(rb) : i256::from_limbs(rb);
+        const i256 sq = sa / sb;
+        const i256 sr = sa % sb;
+        check(sq * sb + sr == sa, "i256 / %", a, b);
+        check(sr.abs() < sb.abs() || sb == i256::min_value(), "i256 % bound", a, b);
+        check(sr == i256(0LL) || (sr < i256(0LL)) == (sa < i256(0LL)), "i256 % sign", a, b);
+
+#if defined(__SIZEOF_INT128__)
+        using native  = unsigned __int128;
+        using snative = __int128;
+
+        const native   na = (native(ra.w[1]) << 64) | ra.w[0];
+        const native   nb = ((native(rb.w[1]) << 64) | rb.w[0]) | 1;
+        const u128_set ua(static_cast<ull>(na >> 64), static_cast<ull>(na));
+        const u128_set ub(static_cast<ull>(nb >> 64), static_cast<ull>(nb));
+        auto           to_native = [](const auto &v) {
+            return (native(u64(v.head.value)) << 64) | u64(v.tail.value);
+        };
+        check(to_native(ua * ub) == na * nb, "u128 *", a, b);
+        check(to_native(ua / ub) == na / nb, "u128 /", a, b);
+        check(to_native(ua % ub) == na % nb, "u128 %", a, b);
+
+        const snative  xa = (rng() & 1) ? -snative(na) : snative(na);
+        const snative  xb = (rng() & 1) ? -snative(nb) : snative(nb);
+        const i128_set ia(static_cast<sll>(native(xa) >> 64), static_cast<sll>(xa));
+        const i128_set ib(static_cast<sll>(native(xb) >> 64), static_cast<sll>(xb));
+        check(snative(to_native(ia / ib)) == xa / xb, "i128 /", a, b);
+        check(snative(to_native(ia % ib)) == xa % xb, "i128 %", a, b);
+        check((ia < ib) == (xa < xb), "i128 <", a, b);
+        check(snative(to_native(ia >> (shift % 128))) == xa >> (shift % 128), "i128 >>", a, b);
+#endif
+    }
+
+    std::printf("%d rounds, %d failures\n", rounds, failures);
+    return failures == 0 ? 0 : 1;
+}
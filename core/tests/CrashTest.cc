@@ -0,0 +1,103 @@
+#include <include/core.hh>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// crashes a child inside two traced functions and reads back the record its handler wrote: the
+// child must still die of SIGSEGV, and the record must hold the interrupted pc, both Helix frames
+// innermost first and the module map. `helix-symbolize` prints the record left in /tmp
+
+namespace helix {
+// read through a volatile pointer so the compiler cannot see the null coming
+static volatile int *volatile g_target = nullptr;
+
+[[gnu::noinline]] static int fault() {
+    __REGISTER_HELIX_TRACE_BLOCK__("CrashTest.hlx", 10, "fault", loc_fault);
+    return *g_target;
+}
+
+[[gnu::noinline]] static int caller() {
+    __REGISTER_HELIX_TRACE_BLOCK__("CrashTest.hlx", 20, "caller", loc_caller);
+    return fault() + 1;
+}
+}  // namespace helix
+
+int main() {
+    namespace crash = helix::std::Crash;
+
+    char path[] = "/tmp/helix-crash-XXXXXX";
+    const int fd = ::mkstemp(path);
+    if (fd < 0) {
+        std::printf("no temporary file\n");
+        return 1;
+    }
+
+    const pid_t child = ::fork();
+    if (child == 0) {
+        if (!crash::install(fd)) {
+            ::_exit(3);
+        }
+        ::_exit(helix::caller());
+    }
+
+    int status = 0;
+    ::waitpid(child, &status, 0);
+    const bool died = WIFSIGNALED(status) && WTERMSIG(status) == SIGSEGV;
+
+    ::std::string record;
+    char          buf[4096];
+    ::lseek(fd, 0, SEEK_SET);
+    for (ssize_t n; (n = ::read(fd, buf, sizeof(buf))) > 0;) {
+        record.append(buf, static_cast<usize>(n));
+    }
+    ::close(fd);
+
+    crash::Record::Header header{};
+    bool ok = died && record.size() > sizeof(header);
+    if (ok) {
+        ::std::memcpy(&header, record.data(), sizeof(header));
+        ok = ::std::memcmp(header.magic, crash::Record::magic, 8) == 0 &&
+             header.signal == SIGSEGV &&
+             header.fault_address == 0 && header.pid == static_cast<u64>(child);
+    }
+
+    u64           first_pc = 0;
+    ::std::string helix;
+    usize         maps = 0;
+    bool          end  = false;
+    for (usize at = sizeof(header); ok && at + sizeof(crash::Record::Section) <= record.size();) {
+        crash::Record::Section section{};
+        ::std::memcpy(&section, record.data() + at, sizeof(section));
+        at += sizeof(section);
+        if (section.tag == crash::Record::End) {
+            end = true;
+            break;
+        }
+        if (section.tag == crash::Record::Native && section.length >= 8) {
+            ::std::memcpy(&first_pc, record.data() + at, sizeof(first_pc));
+        } else if (section.tag == crash::Record::Helix) {
+            for (usize e = at; e < at + section.length;) {
+                crash::Record::HelixEntry entry{};
+                ::std::memcpy(&entry, record.data() + e, sizeof(entry));
+                e += sizeof(entry) + entry.file_length;
+                (helix += ::std::string(record.data() + e, entry.func_length)) += ' ';
+                e += entry.func_length;
+            }
+        } else if (section.tag == crash::Record::Maps) {
+            maps += section.length;
+        }
+        at += section.length;
+    }
+
+    ok = ok && end && first_pc == header.pc && first_pc != 0 && helix == "fault caller " &&
+         maps > 0;
+    std::printf("record %zu bytes, pc 0x%llx, helix frames: %s\n%s\n",
+                record.size(),
+                static_cast<unsigned long long>(header.pc),
+                helix.c_str(),
+                ok ? path : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,66 @@
+#include <include/runtime/__panic/dwarf_line.hh>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <execinfo.h>
+
+// resolves return addresses in this program through its own .debug_line: build with -g. every
+// call site below must map back to this file and the line it is on, and a second round of
+// lookups must be served from the index without touching the file again
+
+namespace lines = helix::std::Stacktrace::__internal;
+
+struct Site {
+    void *pc;
+    int   line;
+};
+
+[[gnu::noinline]] static Site here(int line) {
+    void *stack[2];
+    ::backtrace(stack, 2);
+    return {stack[1], line};
+}
+
+int main() {
+    Site sites[] = {
+        here(__LINE__),
+        here(__LINE__),
+        here(__LINE__),
+    };
+
+    int  failures = 0;
+    auto check    = [&] {
+        for (const Site &site : sites) {
+            lines::SourceLine src{};
+            const bool        found = lines::LineTables::instance().lookup(site.pc, src);
+            const char       *base  = found ? std::strrchr(src.file, '/') : nullptr;
+            const char       *name  = base != nullptr ? base + 1 : (found ? src.file : "");
+            if (!found || std::strcmp(name, "DwarfLineTest.cc") != 0 ||
+                src.line != static_cast<uint32_t>(site.line)) {
+                std::printf("FAIL %p: expected line %d, got %s:%u\n",
+                            site.pc,
+                            site.line,
+                            found ? src.file : "<none>",
+                            found ? src.line : 0);
+                ++failures;
+            }
+        }
+    };
+
+    const auto t0 = std::chrono::steady_clock::now();
+    check();  // maps and indexes the executable
+    const auto t1 = std::chrono::steady_clock::now();
+    constexpr int rounds = 100000;
+    for (int i = 0; i < rounds; ++i) {
+        check();
+    }
+    const auto t2 = std::chrono::steady_clock::now();
+
+    using us = std::chrono::duration<double, std::micro>;
+    std::printf("index %.1f us, lookup %.3f us, %d failures\n",
+                us(t1 - t0).count(),
+                us(t2 - t1).count() / (rounds * 3),
+                failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,115 @@
+#include <include/core.hh>
+
+#include <chrono>
+#include <cstdio>
+
+// per-call cost of a `finally`-protected scope next to the same scope unguarded: the cleanup
+// bumps a counter the body also reads, so it cannot be dropped, and each call is out of line
+
+// the guard this replaced: the cleanup boxed on the heap behind a virtual call
+namespace legacy {
+struct Callable {
+    virtual ~Callable()   = default;
+    virtual void invoke() = 0;
+};
+
+template <typename Fn>
+struct Boxed : Callable {
+    Fn fn;
+    explicit Boxed(Fn f)
+        : fn(f) {}
+    void invoke() override { fn(); }
+};
+
+class finally {
+  public:
+    template <typename Fn>
+    explicit finally(Fn fn)
+        : callable(new Boxed<Fn>(fn)) {}
+    finally(const finally &)            = delete;
+    finally &operator=(const finally &) = delete;
+    ~finally() {
+        callable->invoke();
+        delete callable;
+    }
+
+  private:
+    Callable *callable;
+};
+}  // namespace legacy
+
+namespace bench_fns {
+static u64 cleanups = 0;
+
+// stands in for a body the compiler cannot see through
+static inline u64 work(u64 x) {
+    asm volatile("" : : : "memory");
+    return x * 3 + 1 + cleanups;
+}
+
+[[gnu::noinline]] static u64 unguarded(u64 x) {
+    const u64 r = work(x);
+    ++cleanups;
+    return r;
+}
+
+[[gnu::noinline]] static u64 guarded(u64 x) {
+    helix::$finally guard([] { ++cleanups; });
+    return work(x);
+}
+
+[[gnu::noinline]] static u64 guarded_dismissed(u64 x) {
+    helix::$finally guard([] { ++cleanups; });
+    const u64 r = work(x);
+    guard.dismiss();
+    ++cleanups;
+    return r;
+}
+
+[[gnu::noinline]] static u64 guarded_erased(u64 x) {
+    helix::$finally<> guard([] { ++cleanups; });
+    return work(x);
+}
+
+[[gnu::noinline]] static u64 legacy_guarded(u64 x) {
+    legacy::finally guard([] { ++cleanups; });
+    return work(x);
+}
+}  // namespace bench_fns
+
+template <typename Fn>
+double bench(const char *name, u64 expected, Fn &&fn) {
+    constexpr u64 calls = 20'000'000;
+    u64           acc   = 0;
+
+    bench_fns::cleanups = 0;
+    auto start          = ::std::chrono::steady_clock::now();
+    for (u64 i = 0; i < calls; ++i) {
+        acc += fn(i);
+    }
+    asm volatile("" : : "r"(acc) : "memory");
+    auto   stop = ::std::chrono::steady_clock::now();
+    double ns   = ::std::chrono::duration<double, ::std::nano>(stop - start).count() / calls;
+
+    std::printf("  %-34s %7.2f ns/call%s\n", name, ns, acc == expected ? "" : "  (MISMATCH)");
+    return ns;
+}
+
+int main() {
+    u64 want = 0;
+    for (u64 i = 0; i < 20'000'000; ++i) {
+        want += i * 3 + 1 + i;
+    }
+
+    std::printf("scope with a cleanup\n");
+    const double off = bench("unguarded", want, bench_fns::unguarded);
+    const double now = bench("$finally<lambda>", want, bench_fns::guarded);
+    bench("$finally<lambda>, dismissed", want, bench_fns::guarded_dismissed);
+    const double erased = bench("$finally<> ($function)", want, bench_fns::guarded_erased);
+    const double old    = bench("legacy (heap + virtual)", want, bench_fns::legacy_guarded);
+    std::printf("  guard: %.2f ns, type-erased %.2f ns, legacy %.2f ns\n",
+                now - off,
+                erased - off,
+                old - off);
+    return 0;
+}
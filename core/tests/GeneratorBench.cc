@@ -0,0 +1,150 @@
+#include <include/core.hh>
+
+#include <chrono>
+#include <coroutine>
+#include <cstdio>
+#include <cstdlib>
+#include <memory_resource>
+#include <optional>
+
+// generator creation churn: a short `range`-style generator created, drained and destroyed in a
+// loop, as every `for x in range(n)` does. the global allocator is counted, so the table shows
+// how many allocations each generator still costs
+
+static u64 g_allocations = 0;
+
+void *operator new(size_t size) {
+    ++g_allocations;
+    if (void *p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw ::std::bad_alloc();
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+
+// the generator this replaced: the same promise with its frame from the global allocator
+namespace legacy {
+template <class T>
+class generator {
+  public:
+    struct promise_type {
+        static ::std::suspend_always initial_suspend() noexcept { return {}; }
+        static ::std::suspend_always final_suspend() noexcept { return {}; }
+
+        generator get_return_object() noexcept {
+            return generator{::std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+
+        ::std::suspend_always yield_value(T value) noexcept {
+            current = value;
+            return {};
+        }
+
+        void                     return_void() noexcept {}
+        [[noreturn]] static void unhandled_exception() { throw; }
+
+        ::std::optional<T> current;
+    };
+
+    explicit generator(::std::coroutine_handle<promise_type> h) noexcept
+        : handle(h) {}
+    generator(const generator &) = delete;
+    ~generator() { handle.destroy(); }
+
+    bool next() {
+        handle.resume();
+        return !handle.done();
+    }
+    T value() const { return *handle.promise().current; }
+
+  private:
+    ::std::coroutine_handle<promise_type> handle;
+};
+
+legacy::generator<u64> range(u64 n) {
+    for (u64 i = 0; i < n; ++i) {
+        co_yield i;
+    }
+}
+}  // namespace legacy
+
+namespace current {
+helix::$generator<u64> range(u64 n) {
+    for (u64 i = 0; i < n; ++i) {
+        co_yield i;
+    }
+}
+
+template <typename Alloc>
+helix::$generator<u64> range(::std::allocator_arg_t /*unused*/, Alloc /*unused*/, u64 n) {
+    for (u64 i = 0; i < n; ++i) {
+        co_yield i;
+    }
+}
+}  // namespace current
+
+template <typename Fn>
+double bench(const char *name, u64 expected, Fn &&fn) {
+    constexpr u64 rounds = 2'000'000;
+    u64           acc    = 0;
+
+    fn();  // the first generator fills the pool
+    const u64 before = g_allocations;
+    auto      start  = ::std::chrono::steady_clock::now();
+    for (u64 i = 0; i < rounds; ++i) {
+        acc += fn();
+    }
+    auto stop = ::std::chrono::steady_clock::now();
+
+    const double elapsed = ::std::chrono::duration<double, ::std::nano>(stop - start).count();
+    const double ns      = elapsed / rounds;
+    const double allocs  = static_cast<double>(g_allocations - before) / rounds;
+
+    std::printf("  %-28s %7.1f ns/generator %6.2f allocations%s\n",
+                name,
+                ns,
+                allocs,
+                acc == expected * rounds ? "" : "  (MISMATCH)");
+    return ns;
+}
+
+int main() {
+    constexpr u64 n    = 8;
+    constexpr u64 want = n * (n - 1) / 2;
+
+    std::printf("create, drain and destroy a %llu-element generator\n",
+                static_cast<unsigned long long>(n));
+    const double old = bench("legacy (global new)", want, [] {
+        u64  sum = 0;
+        auto gen = legacy::range(n);
+        while (gen.next()) {
+            sum += gen.value();
+        }
+        return sum;
+    });
+    const double now = bench("$generator (frame pool)", want, [] {
+        u64 sum = 0;
+        for (u64 x : current::range(n)) {
+            sum += x;
+        }
+        return sum;
+    });
+
+    // the allocator form, with frames from a pool resource over a fixed buffer
+    alignas(16) static unsigned char arena_buffer[4096];
+    ::std::pmr::monotonic_buffer_resource    upstream(arena_buffer, sizeof(arena_buffer));
+    ::std::pmr::unsynchronized_pool_resource arena(&upstream);
+    const ::std::pmr::polymorphic_allocator<> alloc(&arena);
+
+    const double pmr = bench("$generator (pmr arena)", want, [&] {
+        u64 sum = 0;
+        for (u64 x : current::range(::std::allocator_arg, alloc, n)) {
+            sum += x;
+        }
+        return sum;
+    });
+
+    std::printf("  speedup: %.2fx pooled, %.2fx with the pmr arena\n", old / now, old / pmr);
+    return 0;
+}
@@ -0,0 +1,86 @@
+#include <include/source/i128.tpp>
+#include <include/source/u128.tpp>
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// the shift-and-subtract division `u128.tpp` used before the native backend, kept as the
+// baseline; it also reads the wrong dividend bits, so its results do not match
+namespace legacy {
+u128 divide(const u128 &n, const u128 &divisor) {
+    if (divisor.high == 0 && divisor.low == 0)
+        return u128(0);
+    u128 quotient  = 0;
+    u128 remainder = 0;
+    for (int i = 127; i >= 0; --i) {
+        u64 carry      = (remainder.low >> 63) & 1;
+        remainder.low  = (remainder.low << 1) | ((n.high >> (i / 64)) & (1ULL << (i % 64)) ? 1 : 0);
+        remainder.high = (remainder.high << 1) | carry;
+        if (remainder >= divisor) {
+            remainder = remainder - divisor;
+            quotient  = quotient | (u128(1) << i);
+        }
+    }
+    return quotient;
+}
+}  // namespace legacy
+
+template <typename Fn>
+double bench(const char *name, u64 expected, Fn &&fn) {
+    constexpr int iterations = 5;
+    u64           result     = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        result = fn();
+        asm volatile("" : : "r"(result) : "memory");
+    }
+    auto   stop = std::chrono::steady_clock::now();
+    double ms   = std::chrono::duration<double, std::milli>(stop - start).count() / iterations;
+
+    std::printf("  %-28s %10.3f ms%s\n", name, ms, result == expected ? "" : "  (MISMATCH)");
+    return ms;
+}
+
+int main() {
+    // fixed-point money: 128-bit amounts in micro-units divided by 64-bit rates, plus a share
+    // of fully 128-bit divisors
+    std::mt19937_64   rng(42);
+    std::vector<u128> amounts, divisors;
+    for (int i = 0; i < (1 << 20); ++i) {
+        amounts.emplace_back(rng() >> 20, rng());
+        divisors.push_back(i % 4 == 0 ? u128(rng() >> 40, rng()) : u128(u64(0), rng() >> 8));
+    }
+
+    auto checksum = [&](auto &&divide) {
+        u64 sum = 0;
+        for (usize i = 0; i < amounts.size(); ++i) {
+            const u128 q = divide(amounts[i], divisors[i]);
+            sum += q.low ^ q.high;
+        }
+        return sum;
+    };
+
+    const u64 want = checksum([](const u128 &a, const u128 &b) { return a / b; });
+
+    std::printf("u128 / u128, %zu divisions\n", amounts.size());
+    double a = bench("legacy", want, [&] { return checksum(legacy::divide); });
+    double b = bench("backend", want, [&] {
+        return checksum([](const u128 &x, const u128 &y) { return x / y; });
+    });
+    std::printf("  speedup: %.1fx\n", a / b);
+
+    auto products = [&] {
+        u64 sum = 0;
+        for (usize i = 0; i < amounts.size(); ++i) {
+            sum += (amounts[i] * divisors[i]).high;
+        }
+        return sum;
+    };
+    std::printf("u128 * u128, %zu products\n", amounts.size());
+    bench("backend", products(), products);
+
+    return 0;
+}
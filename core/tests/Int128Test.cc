@@ -0,0 +1,93 @@
+#include <include/source/i128.tpp>
+#include <include/source/u128.tpp>
+
+#include <cstdio>
+#include <random>
+
+// differential test of u128/i128 against the compiler's __int128, plus the portable backend
+// that targets without __int128 use, over random operands of every bit length
+
+#if defined(__SIZEOF_INT128__)
+using native  = unsigned __int128;
+using snative = __int128;
+
+namespace wide = helix::std::Int128::__internal;
+
+static native  to_native(const u128 &v) { return (native(v.high) << 64) | v.low; }
+static snative to_native(const i128 &v) { return static_cast<snative>((native(v.high) << 64) | v.low); }
+static native  to_native(const wide::words &v) { return (native(v.high) << 64) | v.low; }
+static u128    to_u128(native v) { return {static_cast<u64>(v >> 64), static_cast<u64>(v)}; }
+static i128    to_i128(snative v) {
+    return {static_cast<u64>(native(v) >> 64), static_cast<u64>(native(v))};
+}
+
+// every operation is constexpr, so a wrong answer here fails to compile
+static_assert((u128(u64(0x1234), u64(0)) / u128(u64(0x1234))).low == 0 &&
+              (u128(u64(0x1234), u64(0)) / u128(u64(0x1234))).high == 1);
+static_assert((u128(u64(1), u64(5)) % u128(u64(1), u64(0))).low == 5);
+static_assert((i128(-7) / i128(2)).low == static_cast<u64>(-3));
+
+static int failures = 0;
+
+static void check(bool ok, const char *what, native a, native b) {
+    if (!ok && failures++ < 10) {
+        std::printf("FAIL %s: %016llx%016llx, %016llx%016llx\n",
+                    what,
+                    static_cast<unsigned long long>(a >> 64),
+                    static_cast<unsigned long long>(a),
+                    static_cast<unsigned long long>(b >> 64),
+                    static_cast<unsigned long long>(b));
+    }
+}
+
+int main() {
+    std::mt19937_64 rng(0x128);
+    auto            operand = [&] {
+        const native v = (native(rng()) << 64) | rng();
+        return v >> (rng() % 128);
+    };
+
+    constexpr int rounds = 2000000;
+    for (int i = 0; i < rounds; ++i) {
+        const native a = operand();
+        native       b = operand();
+        if (b == 0) {
+            b = 1;
+        }
+
+        const u128 ua = to_u128(a), ub = to_u128(b);
+        check(to_native(ua * ub) == a * b, "u128 *", a, b);
+        check(to_native(ua / ub) == a / b, "u128 /", a, b);
+        check(to_native(ua % ub) == a % b, "u128 %", a, b);
+
+        const int shift = static_cast<int>(rng() % 130);
+        check(to_native(ua << shift) == (shift >= 128 ? 0 : a << shift), "u128 <<", a, shift);
+        check(to_native(ua >> shift) == (shift >= 128 ? 0 : a >> shift), "u128 >>", a, shift);
+
+        const auto q = wide::portable::divmod({ua.high, ua.low}, {ub.high, ub.low});
+        check(to_native(q.quot) == a / b && to_native(q.rem) == a % b, "portable divmod", a, b);
+        const auto p = wide::portable::mul_64x64(ua.low, ub.low);
+        check(to_native(p) == native(ua.low) * ub.low, "portable mul", a, b);
+
+        const snative sa = (rng() & 1) ? -snative(a) : snative(a);
+        const snative sb = (rng() & 1) ? -snative(b) : snative(b);
+        const i128    ia = to_i128(sa), ib = to_i128(sb);
+        check(to_native(ia * ib) == snative(native(sa) * native(sb)), "i128 *", a, b);
+        check(to_native(ia / ib) == sa / sb, "i128 /", a, b);
+        check(to_native(ia % ib) == sa % sb, "i128 %", a, b);
+        check((ia < ib) == (sa < sb), "i128 <", a, b);
+        check(to_native(ia >> shift) == (shift >= 128 ? (sa < 0 ? -1 : 0) : sa >> shift),
+              "i128 >>",
+              a,
+              shift);
+    }
+
+    std::printf("%d rounds, %d failures\n", rounds, failures);
+    return failures == 0 ? 0 : 1;
+}
+#else
+int main() {
+    std::printf("no __int128 on this target, nothing to compare against\n");
+    return 0;
+}
+#endif
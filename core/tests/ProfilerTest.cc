@@ -0,0 +1,90 @@
+#include <include/core.hh>
+
+#include <cstdio>
+#include <ctime>
+#include <string>
+#include <thread>
+
+// profiles two traced call paths on two threads and checks that both land in the collapsed and
+// pprof output with about the share of CPU time each one burned
+
+namespace helix {
+static double cpu_seconds() {
+    timespec now{};
+    ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return static_cast<double>(now.tv_sec) + static_cast<double>(now.tv_nsec) * 1e-9;
+}
+
+/// burns `budget` seconds of this thread's CPU time, however busy the machine is
+[[gnu::noinline]] static double spin(double budget) {
+    __REGISTER_HELIX_TRACE_BLOCK__("ProfilerTest.hlx", 10, "spin", loc_spin);
+
+    volatile double acc   = 0;
+    const double    until = cpu_seconds() + budget;
+    while (cpu_seconds() < until) {
+        for (int i = 0; i < 1000; ++i) {
+            acc = acc + i * 0.5;
+        }
+    }
+    return acc;
+}
+
+[[gnu::noinline]] static double outer_short() {
+    __REGISTER_HELIX_TRACE_BLOCK__("ProfilerTest.hlx", 20, "outer_short", loc_short);
+    return spin(0.2);
+}
+
+[[gnu::noinline]] static double outer_long() {
+    __REGISTER_HELIX_TRACE_BLOCK__("ProfilerTest.hlx", 30, "outer_long", loc_long);
+    return spin(0.6);
+}
+}  // namespace helix
+
+/// the samples of every line starting with `path`, whatever native leaves follow it
+static unsigned long long count_of(const ::std::string &folded, const char *path) {
+    unsigned long long total = 0;
+    for (usize at = 0; at < folded.size();) {
+        const usize end = folded.find('\n', at);
+        if (folded.compare(at, ::std::strlen(path), path) == 0) {
+            total += ::std::stoull(folded.substr(folded.rfind(' ', end) + 1));
+        }
+        at = end + 1;
+    }
+    return total;
+}
+
+int main() {
+    namespace profiler = helix::std::Profiler;
+
+    if (!profiler::start({.frequency = 199, .native_depth = 2})) {
+        std::printf("profiler unavailable\n");
+        return 1;
+    }
+
+    ::std::thread worker([] {
+        profiler::attach();
+        helix::outer_short();
+        profiler::detach();
+    });
+    helix::outer_long();
+    worker.join();
+    profiler::stop();
+
+    const ::std::string folded = profiler::collapsed();
+    const ::std::string proto  = profiler::pprof();
+    const auto          stats  = profiler::stats();
+
+    const auto shorter = count_of(folded, "outer_short;spin");
+    const auto longer  = count_of(folded, "outer_long;spin");
+    std::printf("%s", folded.c_str());
+    std::printf("%llu samples, %llu dropped, pprof %zu bytes\n",
+                static_cast<unsigned long long>(stats.samples),
+                static_cast<unsigned long long>(stats.dropped),
+                proto.size());
+
+    // 199 Hz over 0.2 s and 0.6 s of CPU time, with plenty of room for a loaded machine
+    const bool ok = shorter > 10 && longer > 2 * shorter && proto.size() > 64 &&
+                    proto.find("outer_long") != ::std::string::npos;
+    std::printf("%s\n", ok ? "ok" : "FAIL");
+    return ok ? 0 : 1;
+}
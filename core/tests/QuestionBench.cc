@@ -0,0 +1,184 @@
+#include <include/core.hh>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// the `usize?` every string search returns, in the layout it has now and the one it replaced:
+// a tokenizer that walks a text with `find_first_of`, and the same walk keeping every result.
+// both sides run the same search engine; the legacy side calls it directly, so a single
+// result passed straight back is about even and the gap shows once results are kept
+
+namespace search = helix::std::String::__internal::search;
+
+// the layout this replaced: a union with a 96-byte Frame (context, reason and file strings,
+// line) and a state tag, with `T` value-initialized even for a null result
+namespace legacy {
+struct Frame {
+    void         *context[2];
+    helix::string reason;
+    helix::string file;
+    usize         line;
+    bool          show_trace;
+};
+
+template <class T>
+class question {
+    enum class State : char { Value, Null, Error };
+
+    union Storage {
+        Frame error;
+        T     value;
+
+        Storage() noexcept
+            : value() {}
+        ~Storage() noexcept {}
+    };
+
+    State   state = State::Null;
+    Storage data;
+
+  public:
+    question() noexcept = default;
+    question(const T &value)
+        : state(State::Value) {
+        new (&data.value) T(value);
+    }
+    question(const question &other)
+        : state(other.state) {
+        if (state == State::Value) {
+            new (&data.value) T(other.data.value);
+        } else if (state == State::Error) {
+            new (&data.error) Frame(other.data.error);
+        }
+    }
+    ~question() {
+        if (state == State::Error) {
+            data.error.~Frame();
+        }
+    }
+
+    [[nodiscard]] bool operator$question() const noexcept { return state == State::Value; }
+    [[nodiscard]] T    operator*() const { return data.value; }
+};
+
+[[gnu::noinline]] question<usize>
+find_first_of(const helix::string &s, const wchar_t *set, usize m, usize pos) {
+    if (m == 0 || pos >= s.size()) {
+        return {};
+    }
+    const usize at = search::find_first_of(s.raw(), s.size(), set, m, pos);
+    return at != search::npos ? question<usize>(at) : question<usize>();
+}
+}  // namespace legacy
+
+namespace current {
+[[gnu::noinline]] helix::$question<usize>
+find_first_of(const helix::string &s, const helix::string &set, usize pos) {
+    return s.find_first_of(set, pos);
+}
+}  // namespace current
+
+template <typename Fn>
+double bench(const char *name, usize expected, Fn &&fn) {
+    constexpr int rounds = 200;
+    usize         got    = 0;
+
+    auto start = ::std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        got += fn();
+    }
+    auto   stop = ::std::chrono::steady_clock::now();
+    double us   = ::std::chrono::duration<double, ::std::micro>(stop - start).count() / rounds;
+
+    std::printf(
+        "  %-30s %9.1f us/pass%s\n", name, us, got == expected * rounds ? "" : "  (MISMATCH)");
+    return us;
+}
+
+int main() {
+    std::printf("sizeof    usize?  i32?  string?  const char *?\n");
+    std::printf("  legacy  %6zu %5zu %8zu %14zu\n",
+                sizeof(legacy::question<usize>),
+                sizeof(legacy::question<i32>),
+                sizeof(legacy::question<helix::string>),
+                sizeof(legacy::question<const char *>));
+    std::printf("  now     %6zu %5zu %8zu %14zu\n",
+                sizeof(helix::$question<usize>),
+                sizeof(helix::$question<i32>),
+                sizeof(helix::$question<helix::string>),
+                sizeof(helix::$question<const char *>));
+
+    // ~256K characters of short words, so the search is short and the result type shows
+    ::std::wstring text;
+    while (text.size() < (256U << 10)) {
+        text += L"the quick brown fox jumps over a lazy dog; it was 12:04\n";
+    }
+    const helix::string hay(text.data(), text.size());
+    const helix::string set(L" \n;:");
+
+    usize words = 0;
+    for (usize pos = 0; (pos = text.find_first_of(L" \n;:", pos)) != ::std::wstring::npos; ++pos) {
+        ++words;
+    }
+    std::printf("tokenize (%zu separators)\n", words);
+
+    const double old = bench("legacy usize?", words, [&] {
+        usize count = 0;
+        usize pos   = 0;
+        for (;;) {
+            auto at = legacy::find_first_of(hay, set.raw(), set.size(), pos);
+            if (!at.operator$question()) {
+                break;
+            }
+            ++count;
+            pos = *at + 1;
+        }
+        return count;
+    });
+    const double now = bench("usize?", words, [&] {
+        usize count = 0;
+        usize pos   = 0;
+        for (;;) {
+            auto at = current::find_first_of(hay, set, pos);
+            if (!at.operator$question()) {
+                break;
+            }
+            ++count;
+            pos = *at + 1;
+        }
+        return count;
+    });
+    std::printf("  speedup: %.2fx\n", old / now);
+
+    std::printf("tokenize, keeping every result\n");
+    const double old_kept = bench("legacy usize?", words, [&] {
+        ::std::vector<legacy::question<usize>> found;
+        usize pos = 0;
+        for (;;) {
+            auto at = legacy::find_first_of(hay, set.raw(), set.size(), pos);
+            if (!at.operator$question()) {
+                break;
+            }
+            found.push_back(at);
+            pos = *at + 1;
+        }
+        return found.size();
+    });
+    const double now_kept = bench("usize?", words, [&] {
+        ::std::vector<helix::$question<usize>> found;
+        usize pos = 0;
+        for (;;) {
+            auto at = current::find_first_of(hay, set, pos);
+            if (!at.operator$question()) {
+                break;
+            }
+            found.push_back(at);
+            pos = *at + 1;
+        }
+        return found.size();
+    });
+    std::printf("  speedup: %.2fx\n", old_kept / now_kept);
+    return 0;
+}
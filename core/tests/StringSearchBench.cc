@@ -0,0 +1,131 @@
+#include <include/types/string/search.hh>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace search = helix::std::String::__internal::search;
+
+// the nested loops `String.tpp` used before the search engine, kept as the baseline
+namespace legacy {
+usize find_first_of(const wchar_t *s, usize n, const wchar_t *set, usize m, usize pos) {
+    for (usize i = pos; i < n; ++i) {
+        for (usize j = 0; j < m; ++j) {
+            if (s[i] == set[j]) {
+                return i;
+            }
+        }
+    }
+    return search::npos;
+}
+
+usize find_last_not_of(const wchar_t *s, usize n, const wchar_t *set, usize m, usize pos) {
+    if (pos >= n) {
+        pos = n - 1;
+    }
+    for (usize i = pos + 1; i > 0; --i) {
+        bool found = false;
+        for (usize j = 0; j < m && !found; ++j) {
+            found = s[i - 1] == set[j];
+        }
+        if (!found) {
+            return i - 1;
+        }
+    }
+    return search::npos;
+}
+
+usize rfind(const wchar_t *s, usize n, const wchar_t *nd, usize m, usize pos) {
+    if (pos >= n - m + 1) {
+        pos = n - m;
+    }
+    for (usize i = pos + 1; i > 0; --i) {
+        bool found = true;
+        for (usize j = 0; j < m && found; ++j) {
+            found = s[i - 1 + j] == nd[j];
+        }
+        if (found) {
+            return i - 1;
+        }
+    }
+    return search::npos;
+}
+}  // namespace legacy
+
+template <typename Fn>
+double bench(const char *name, usize expected, Fn &&fn) {
+    constexpr int iterations = 20;
+    usize         result     = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        result = fn();
+        asm volatile("" : : "r"(result) : "memory");
+    }
+    auto   stop = std::chrono::steady_clock::now();
+    double ms   = std::chrono::duration<double, std::milli>(stop - start).count() / iterations;
+
+    std::printf("  %-28s %10.3f ms%s\n", name, ms, result == expected ? "" : "  (MISMATCH)");
+    return ms;
+}
+
+int main() {
+    // ~4M characters of log-like text with the interesting bytes only at the far end
+    std::wstring line = L"2024-11-02T10:15:42Z INFO worker[17] request served in 12ms\n";
+    std::wstring hay;
+    while (hay.size() < (4U << 20)) {
+        hay += line;
+    }
+    hay += L"2024-11-02T10:15:43Z ERROR worker[17] |panic| at main.hlx:42\n";
+
+    const wchar_t *s = hay.data();
+    const usize    n = hay.size();
+
+    std::printf("isa: %d (0 = scalar, 1 = sse4.2, 2 = avx2), haystack: %zu chars\n",
+                static_cast<int>(search::active_isa()),
+                static_cast<size_t>(n));
+
+    const std::wstring set = L"|#$%";
+    std::printf("find_first_of(\"%ls\")\n", set.c_str());
+    usize want = hay.find_first_of(set);
+    double a   = bench("legacy", want, [&] { return legacy::find_first_of(s, n, set.data(), 4, 0); });
+    double b   = bench("engine", want, [&] {
+        return search::find_first_of(s, n, set.data(), set.size());
+    });
+    std::printf("  speedup: %.1fx\n", a / b);
+
+    const std::wstring ws = L" \t\r\n.:-0123456789TZ";
+    std::printf("find_last_not_of(<%zu chars>) over a trailing run\n", ws.size());
+    std::wstring tail = hay;
+    while (tail.size() < hay.size() + (1U << 20)) {
+        tail += L"0123456789 ";
+    }
+    want              = tail.find_last_not_of(ws);
+    a = bench("legacy", want, [&] {
+        return legacy::find_last_not_of(tail.data(), tail.size(), ws.data(), ws.size(), search::npos);
+    });
+    b = bench("engine", want, [&] {
+        return search::find_last_of(tail.data(), tail.size(), ws.data(), ws.size(), search::npos, true);
+    });
+    std::printf("  speedup: %.1fx\n", a / b);
+
+    const std::wstring needle = L"request served in 13ms";
+    std::printf("rfind(\"%ls\") (absent)\n", needle.c_str());
+    want = hay.rfind(needle);
+    a    = bench("legacy", want, [&] { return legacy::rfind(s, n, needle.data(), needle.size(), n); });
+    b    = bench("engine", want, [&] { return search::rfind(s, n, needle.data(), needle.size()); });
+    std::printf("  speedup: %.1fx\n", a / b);
+
+    for (const wchar_t *nd : {L"|panic|", L"served in 13ms"}) {
+        const usize m = std::char_traits<wchar_t>::length(nd);
+        std::printf("lfind(\"%ls\")\n", nd);
+        want = hay.find(nd);
+        a    = bench("basic_string_view::find", want, [&] {
+            return std::wstring_view(s, n).find(nd, 0, m);
+        });
+        b    = bench("engine", want, [&] { return search::find(s, n, nd, m); });
+        std::printf("  speedup: %.1fx\n", a / b);
+    }
+
+    return 0;
+}
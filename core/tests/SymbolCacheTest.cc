@@ -0,0 +1,65 @@
+#include <include/runtime/__panic/symbol_cache.hh>
+
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+// hammers the symbol cache from several threads: readers must only ever see the name that was
+// published for an address, never a torn or stale one, and an invalidation must drop everything
+
+namespace cache = helix::std::Stacktrace::__internal;
+
+static void name_of(usize pc, char *out) { std::snprintf(out, 64, "fn_%zx", pc); }
+
+int main() {
+    auto &symbols = cache::SymbolCache::instance();
+
+    constexpr usize addresses = 20000;  // more than the table holds, so slots get evicted
+    constexpr int   threads   = 8;
+    constexpr int   lookups   = 400000;
+
+    std::atomic<int>         failures{0};
+    std::atomic<usize>       hits{0};
+    std::vector<std::thread> workers;
+
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            std::mt19937_64 rng(t);
+            char            expected[64];
+            for (int i = 0; i < lookups; ++i) {
+                const usize    pc   = 0x1000 + (rng() % addresses) * 16;
+                const auto     addr = reinterpret_cast<const void *>(pc);
+                cache::Symbol  sym{};
+                if (symbols.find(addr, sym)) {
+                    name_of(pc, expected);
+                    if (std::strcmp(sym.func, expected) != 0 || sym.line != pc % 1000) {
+                        failures.fetch_add(1);
+                    }
+                    hits.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    name_of(pc, expected);
+                    if (!symbols.insert(addr, expected, "module.so", pc % 1000, sym) ||
+                        std::strcmp(sym.func, expected) != 0) {
+                        failures.fetch_add(1);
+                    }
+                }
+            }
+        });
+    }
+    for (auto &w : workers) {
+        w.join();
+    }
+
+    symbols.invalidate();
+    cache::Symbol sym{};
+    for (usize i = 0; i < addresses; ++i) {
+        if (symbols.find(reinterpret_cast<const void *>(0x1000 + i * 16), sym)) {
+            failures.fetch_add(1);
+        }
+    }
+
+    std::printf("%zu hits, %d failures\n", hits.load(), failures.load());
+    return failures.load() == 0 ? 0 : 1;
+}
@@ -0,0 +1,123 @@
+#include <include/runtime/__panic/stacktrace.hh>
+
+#include <chrono>
+#include <cstdio>
+
+// per-call cost of trace registration in a small leaf function at each trace level. every level
+// is measured in this one binary by using the macros each level keeps; build with
+// -DHELIX_TRACE_LEVEL=0 (or 1) and the traced rows fall to the `off` row. build with -fPIC to
+// see what the TLS model is worth as well.
+
+// the registration this replaced: a wide `Location` transcoded in a guarded static and a
+// general-dynamic thread-local head
+namespace legacy {
+struct Location {
+    const wchar_t *file;
+    const wchar_t *func;
+    uint32_t       line;
+    wchar_t        file_buf[1024];
+    wchar_t        func_buf[1024];
+
+    Location(const char *f, const char *fn, uint32_t l)
+        : file(file_buf)
+        , func(func_buf)
+        , line(l) {
+        std::mbstowcs(file_buf, f, 1023);
+        std::mbstowcs(func_buf, fn, 1023);
+    }
+};
+
+struct Frame {
+    const Location *loc;
+    Frame          *prev;
+};
+
+__attribute__((tls_model("global-dynamic"))) inline thread_local Frame *head = nullptr;
+
+struct RegisterFrame {
+    Frame frame;
+
+    explicit RegisterFrame(const Location *loc) noexcept
+        : frame{loc, head} {
+        head = &frame;
+    }
+    ~RegisterFrame() noexcept { head = frame.prev; }
+};
+}  // namespace legacy
+
+namespace helix {
+// stands in for a body the compiler cannot see through, so every frame really is linked
+static inline u64 work(u64 x) {
+    asm volatile("" : : : "memory");
+    return x * 3 + 1;
+}
+
+[[gnu::noinline]] static u64 untraced(u64 x) { return work(x); }
+
+[[gnu::noinline]] static u64 opted_out(u64 x) {
+    HELIX_NO_TRACE;
+    __REGISTER_HELIX_TRACE_BLOCK__("bench.hlx", 1, "opted_out", loc_opted_out);
+    return work(x);
+}
+
+[[gnu::noinline]] static u64 helix_traced(u64 x) {
+    __REGISTER_HELIX_TRACE_BLOCK__("bench.hlx", 2, "helix_traced", loc_helix_traced);
+    return work(x);
+}
+
+[[gnu::noinline]] static u64 runtime_leaf(u64 x) {
+    __REGISTER_HYBRID_TRACE_BLOCK__(loc_runtime_leaf);
+    return work(x);
+}
+
+// a Helix function that does its work in a runtime helper, as most of them do
+[[gnu::noinline]] static u64 helix_over_runtime(u64 x) {
+    __REGISTER_HELIX_TRACE_BLOCK__("bench.hlx", 3, "helix_over_runtime", loc_helix_over_runtime);
+    return runtime_leaf(x);
+}
+
+[[gnu::noinline]] static u64 untraced_over_runtime(u64 x) { return untraced(x); }
+
+[[gnu::noinline]] static u64 legacy_traced(u64 x) {
+    static legacy::Location loc{"bench.hlx", "legacy_traced", 4};
+    legacy::RegisterFrame   scope(&loc);
+    return work(x);
+}
+}  // namespace helix
+
+template <typename Fn>
+double bench(const char *name, u64 expected, Fn &&fn) {
+    constexpr u64 calls = 50'000'000;
+    u64           acc   = 0;
+
+    auto start = ::std::chrono::steady_clock::now();
+    for (u64 i = 0; i < calls; ++i) {
+        acc += fn(i);
+    }
+    asm volatile("" : : "r"(acc) : "memory");
+    auto   stop = ::std::chrono::steady_clock::now();
+    double ns   = ::std::chrono::duration<double, ::std::nano>(stop - start).count() / calls;
+
+    std::printf("  %-34s %7.2f ns/call%s\n", name, ns, acc == expected ? "" : "  (MISMATCH)");
+    return ns;
+}
+
+int main() {
+    u64 want = 0;
+    for (u64 i = 0; i < 50'000'000; ++i) {
+        want += i * 3 + 1;
+    }
+
+    std::printf("leaf call, trace level %d\n", HELIX_TRACE_LEVEL);
+    const double off = bench("off (untraced)", want, helix::untraced);
+    bench("HELIX_NO_TRACE", want, helix::opted_out);
+    const double lvl = bench("helix (Helix frame)", want, helix::helix_traced);
+    const double old = bench("legacy registration", want, helix::legacy_traced);
+    std::printf("  registration: %.2f ns, legacy %.2f ns\n", lvl - off, old - off);
+
+    std::printf("Helix function over a runtime helper\n");
+    const double base = bench("off / untraced", want, helix::untraced_over_runtime);
+    const double full = bench("full (Helix + hybrid frames)", want, helix::helix_over_runtime);
+    std::printf("  registration: %.2f ns\n", full - base);
+    return 0;
+}
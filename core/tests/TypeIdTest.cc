@@ -0,0 +1,77 @@
+#include <include/core.hh>
+
+#include <cstdio>
+#include <dlfcn.h>
+
+// type ids taken in a `dlopen`ed module must match the same types here, and only those: with
+// hidden symbols each module has its own copy of every tag, so this is the `type_info` fallback.
+// the same file is both sides, built with hidden visibility as a release build is:
+//   c++ -std=c++23 -fvisibility=hidden -fPIC -shared -DTYPE_ID_MODULE -I core \
+//       core/tests/TypeIdTest.cc -o libTypeIdModule.so
+//   c++ -std=c++23 -fvisibility=hidden -I core core/tests/TypeIdTest.cc -o TypeIdTest -ldl
+//   ./TypeIdTest ./libTypeIdModule.so
+
+namespace probe {
+struct Point {
+    int x;
+    int y;
+};
+struct Other {
+    int x;
+    int y;
+};
+}  // namespace probe
+
+#ifdef TYPE_ID_MODULE
+
+extern "C" [[gnu::visibility("default")]] void type_id_probe(helix::std::TypeId      *id,
+                                                            helix::std::TypeErasure *erased) {
+    probe::Point point{1, 2};
+    *id     = helix::std::TypeId::of<probe::Point>();
+    *erased = helix::std::erase_type(&point);
+}
+
+#else
+
+int main(int argc, char **argv) {
+    const char *path   = argc > 1 ? argv[1] : "./libTypeIdModule.so";
+    void       *module = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+    if (module == nullptr) {
+        std::printf("FAIL: %s\n", dlerror());
+        return 1;
+    }
+
+    using Probe = void (*)(helix::std::TypeId *, helix::std::TypeErasure *);
+    auto probe  = reinterpret_cast<Probe>(dlsym(module, "type_id_probe"));
+    if (probe == nullptr) {
+        std::printf("FAIL: %s\n", dlerror());
+        return 1;
+    }
+
+    helix::std::TypeId      id;
+    helix::std::TypeErasure erased;
+    probe(&id, &erased);
+
+    const helix::std::TypeId here = helix::std::TypeId::of<probe::Point>();
+    int                      failures = 0;
+    auto check = [&](bool ok, const char *what) {
+        std::printf("  %-40s %s\n", what, ok ? "ok" : "FAIL");
+        failures += ok ? 0 : 1;
+    };
+
+    check(id == here && here == id, "id from the module matches");
+    check(!(id == helix::std::TypeId::of<probe::Other>()), "a different type does not");
+    check(!(id == helix::std::TypeId()), "nor does the empty id");
+    check(erased.is<probe::Point>(), "erased in the module, is<T>() here");
+    check(!erased.is<probe::Other>(), "and not is<Other>()");
+    check(erased.get<probe::Point>() != nullptr && erased.get<probe::Point>()->y == 2,
+          "get<T>() reads the module's copy");
+
+    erased = helix::std::TypeErasure();  // its ops live in the module
+    dlclose(module);
+
+    std::printf("%s\n", failures == 0 ? "ok" : "FAIL");
+    return failures == 0 ? 0 : 1;
+}
+
+#endif
@@ -0,0 +1,415 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///-------------------------------------------------------------------------------- Lib-Helix ---///
+
+/// helix-symbolize: prints the crash records `Crash::install` wrote as stack traces.
+///
+///   helix-symbolize [record-file]      (standard input when no file is given)
+///
+/// native frames are named from the `.symtab` (or `.dynsym`) of the module each address falls in,
+/// as the record's copy of /proc/self/maps places it, with file:line from `.debug_line` when the
+/// module has it. run it where the crashed binaries are still at the paths in the record.
+
+#include <include/runtime/__panic/crash.hh>
+#include <include/runtime/__panic/dwarf_line.hh>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <cxxabi.h>
+#include <elf.h>
+#include <fcntl.h>
+#include <map>
+#include <memory>
+#include <signal.h>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace crash = helix::std::Crash;
+namespace lines = helix::std::Stacktrace::__internal;
+
+namespace {
+struct Style {
+    const char *bold         = "\033[1m";
+    const char *reset        = "\033[0m";
+    const char *red          = "\033[31m";
+    const char *cyan         = "\033[36m";
+    const char *light_green  = "\033[92m";
+    const char *light_cyan   = "\033[96m";
+    const char *light_yellow = "\033[93m";
+    const char *light_red    = "\033[91m";
+
+    static Style plain() { return {"", "", "", "", "", "", "", ""}; }
+};
+
+/// one module on disk: its function symbols, load segments and line table
+class Module {
+  public:
+    explicit Module(const std::string &path) {
+        table.load(path.c_str());
+
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return;
+        }
+        struct stat st{};
+        void       *map = MAP_FAILED;
+        if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+            map = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        ::close(fd);
+        if (map == MAP_FAILED) {
+            return;
+        }
+
+        const auto  *image = static_cast<const unsigned char *>(map);
+        const size_t size  = static_cast<size_t>(st.st_size);
+        if (size > EI_CLASS && std::memcmp(image, ELFMAG, SELFMAG) == 0) {
+            if (image[EI_CLASS] == ELFCLASS64) {
+                index<Elf64_Ehdr, Elf64_Shdr, Elf64_Phdr, Elf64_Sym>(image, size);
+            } else if (image[EI_CLASS] == ELFCLASS32) {
+                index<Elf32_Ehdr, Elf32_Shdr, Elf32_Phdr, Elf32_Sym>(image, size);
+            }
+        }
+        ::munmap(map, size);
+    }
+
+    /// the link-time address a file offset is loaded from
+    bool address_of(uint64_t offset, uint64_t &addr) const {
+        for (const Segment &seg : segments) {
+            if (offset >= seg.offset && offset < seg.offset + seg.size) {
+                addr = offset - seg.offset + seg.vaddr;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const std::string *function_at(uint64_t addr) const {
+        auto it = std::upper_bound(
+            symbols.begin(), symbols.end(), addr, [](uint64_t a, const Symbol &s) {
+                return a < s.addr;
+            });
+        if (it == symbols.begin()) {
+            return nullptr;
+        }
+        --it;
+        return addr < it->addr + std::max<uint64_t>(it->size, 1) ? &it->name : nullptr;
+    }
+
+    bool line_at(uint64_t addr, lines::SourceLine &out) const { return table.lookup(addr, out); }
+
+  private:
+    struct Segment {
+        uint64_t offset;
+        uint64_t size;
+        uint64_t vaddr;
+    };
+
+    struct Symbol {
+        uint64_t    addr;
+        uint64_t    size;
+        std::string name;
+    };
+
+    template <typename Ehdr, typename Shdr, typename Phdr, typename Sym>
+    void index(const unsigned char *image, size_t size) {
+        const auto *eh = reinterpret_cast<const Ehdr *>(image);
+        if (eh->e_phoff + size_t(eh->e_phnum) * sizeof(Phdr) <= size) {
+            const auto *ph = reinterpret_cast<const Phdr *>(image + eh->e_phoff);
+            for (int i = 0; i < eh->e_phnum; ++i) {
+                if (ph[i].p_type == PT_LOAD) {
+                    segments.push_back({ph[i].p_offset, ph[i].p_filesz, ph[i].p_vaddr});
+                }
+            }
+        }
+
+        if (eh->e_shoff == 0 || eh->e_shoff + size_t(eh->e_shnum) * sizeof(Shdr) > size) {
+            return;
+        }
+        const auto *sh = reinterpret_cast<const Shdr *>(image + eh->e_shoff);
+
+        // a stripped module still has its dynamic symbols
+        for (const uint32_t type : {uint32_t(SHT_SYMTAB), uint32_t(SHT_DYNSYM)}) {
+            for (int i = 0; i < eh->e_shnum; ++i) {
+                if (sh[i].sh_type != type || sh[i].sh_link >= eh->e_shnum ||
+                    sh[i].sh_offset + sh[i].sh_size > size) {
+                    continue;
+                }
+                const Shdr &strtab = sh[sh[i].sh_link];
+                if (strtab.sh_offset + strtab.sh_size > size) {
+                    continue;
+                }
+                const auto *syms  = reinterpret_cast<const Sym *>(image + sh[i].sh_offset);
+                const auto *names = reinterpret_cast<const char *>(image + strtab.sh_offset);
+                for (size_t n = 0; n < sh[i].sh_size / sizeof(Sym); ++n) {
+                    const unsigned kind = syms[n].st_info & 0xf;
+                    if ((kind != STT_FUNC && kind != STT_GNU_IFUNC) || syms[n].st_value == 0 ||
+                        syms[n].st_name >= strtab.sh_size) {
+                        continue;
+                    }
+                    symbols.push_back(
+                        {syms[n].st_value, syms[n].st_size, demangle(names + syms[n].st_name)});
+                }
+            }
+            if (!symbols.empty()) {
+                break;
+            }
+        }
+        std::sort(symbols.begin(), symbols.end(), [](const Symbol &a, const Symbol &b) {
+            return a.addr < b.addr;
+        });
+    }
+
+    static std::string demangle(const char *name) {
+        int   status    = 0;
+        char *demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+        if (status != 0 || demangled == nullptr) {
+            return name;
+        }
+        std::string out(demangled);
+        std::free(demangled);
+        return out;
+    }
+
+    lines::LineTable     table;
+    std::vector<Segment> segments;
+    std::vector<Symbol>  symbols;
+};
+
+/// one line of /proc/<pid>/maps that maps a file
+struct Mapping {
+    uint64_t    start;
+    uint64_t    end;
+    uint64_t    offset;
+    std::string path;
+};
+
+std::vector<Mapping> parse_maps(std::string_view text) {
+    std::vector<Mapping> out;
+    while (!text.empty()) {
+        const size_t          eol  = text.find('\n');
+        const std::string     line(text.substr(0, eol));
+        text.remove_prefix(eol == std::string_view::npos ? text.size() : eol + 1);
+
+        unsigned long long start = 0, end = 0, offset = 0;
+        char               perms[8] = {};
+        int                path_at  = 0;
+        if (std::sscanf(line.c_str(), "%llx-%llx %7s %llx %*s %*s %n", &start, &end, perms,
+                        &offset, &path_at) < 4 ||
+            path_at <= 0 || line[static_cast<size_t>(path_at)] != '/') {
+            continue;
+        }
+        out.push_back({start, end, offset, line.substr(static_cast<size_t>(path_at))});
+    }
+    return out;
+}
+
+struct Frame {
+    std::string func;
+    std::string file;
+    uint32_t    line = 0;
+    bool        module = false;  // `file` names a module rather than a source file
+};
+
+class Symbolizer {
+  public:
+    explicit Symbolizer(std::vector<Mapping> maps)
+        : maps(std::move(maps)) {}
+
+    /// `exact` is false for return addresses, which are looked up one byte back so they land in
+    /// the call instruction
+    Frame native(uint64_t pc, bool exact) {
+        Frame frame{"???", "???", 0, true};
+        for (const Mapping &map : maps) {
+            if (pc < map.start || pc >= map.end) {
+                continue;
+            }
+            frame.file = map.path;
+
+            const Module &module = load(map.path);
+            uint64_t      addr   = 0;
+            if (!module.address_of(pc - map.start + map.offset, addr)) {
+                break;
+            }
+            const uint64_t at = exact ? addr : addr - 1;
+            if (const std::string *name = module.function_at(at)) {
+                frame.func = *name;
+            } else {
+                char buf[64];
+                std::snprintf(buf, sizeof(buf), "???+0x%llx",
+                              static_cast<unsigned long long>(addr));
+                frame.func = buf;
+            }
+            lines::SourceLine src{};
+            if (module.line_at(at, src)) {
+                frame.file   = src.file;
+                frame.line   = src.line;
+                frame.module = false;
+            }
+            break;
+        }
+        return frame;
+    }
+
+  private:
+    const Module &load(const std::string &path) {
+        auto it = modules.find(path);
+        if (it == modules.end()) {
+            it = modules.emplace(path, std::make_unique<Module>(path)).first;
+        }
+        return *it->second;
+    }
+
+    std::vector<Mapping>                            maps;
+    std::map<std::string, std::unique_ptr<Module>> modules;
+};
+
+const char *signal_name(uint32_t sig) {
+    switch (sig) {
+        case SIGSEGV:
+            return "SIGSEGV";
+        case SIGBUS:
+            return "SIGBUS";
+        case SIGABRT:
+            return "SIGABRT";
+        default:
+            return "signal";
+    }
+}
+
+void print_frame(const Frame &frame, const Style &s) {
+    std::printf("    %s%s%s:\n", s.light_green, frame.func.c_str(), s.reset);
+    std::printf("      at %s%s%s", s.light_yellow, frame.file.c_str(), s.reset);
+    if (frame.line != 0) {
+        std::printf(":%s%u%s", s.light_yellow, frame.line, s.reset);
+    }
+    if (frame.module && frame.file != "???") {
+        std::printf("%s (elf)%s", s.light_cyan, s.reset);
+    }
+    std::printf("\n");
+}
+
+/// reads the next record from `in`; false at the end of the input or on a malformed record
+bool symbolize_one(std::FILE *in, const Style &s) {
+    crash::Record::Header header{};
+    if (std::fread(&header, sizeof(header), 1, in) != 1) {
+        return false;
+    }
+    if (std::memcmp(header.magic, crash::Record::magic, sizeof(header.magic)) != 0) {
+        std::fprintf(stderr, "helix-symbolize: not a crash record\n");
+        return false;
+    }
+
+    std::vector<uint64_t> pcs;
+    std::vector<Frame>    helix;
+    std::string           maps;
+    for (;;) {
+        crash::Record::Section section{};
+        if (std::fread(&section, sizeof(section), 1, in) != 1) {
+            std::fprintf(stderr, "helix-symbolize: truncated record\n");
+            return false;
+        }
+        if (section.tag == crash::Record::End) {
+            break;
+        }
+        std::string payload(section.length, '\0');
+        if (section.length != 0 && std::fread(payload.data(), section.length, 1, in) != 1) {
+            std::fprintf(stderr, "helix-symbolize: truncated record\n");
+            return false;
+        }
+
+        switch (section.tag) {
+            case crash::Record::Native:
+                pcs.resize(payload.size() / sizeof(uint64_t));
+                std::memcpy(pcs.data(), payload.data(), pcs.size() * sizeof(uint64_t));
+                break;
+            case crash::Record::Helix:
+                for (size_t at = 0; at + sizeof(crash::Record::HelixEntry) <= payload.size();) {
+                    crash::Record::HelixEntry entry{};
+                    std::memcpy(&entry, payload.data() + at, sizeof(entry));
+                    at += sizeof(entry);
+                    if (at + entry.file_length + entry.func_length > payload.size()) {
+                        break;
+                    }
+                    Frame frame;
+                    frame.file = payload.substr(at, entry.file_length);
+                    frame.func = payload.substr(at + entry.file_length, entry.func_length);
+                    frame.line = entry.line;
+                    helix.push_back(std::move(frame));
+                    at += entry.file_length + entry.func_length;
+                }
+                break;
+            case crash::Record::Maps:
+                maps += payload;
+                break;
+            default:
+                break;  // sections from a newer writer
+        }
+    }
+
+    // the same order as a panic's trace: native frames outermost first, then the Helix chain
+    Symbolizer symbolizer(parse_maps(maps));
+    std::printf(
+        "\n%s%sStack trace %s(most recent call last):%s\n", s.cyan, s.bold, s.reset, s.reset);
+    for (size_t i = pcs.size(); i-- > 0;) {
+        print_frame(symbolizer.native(pcs[i], i == 0 && pcs[i] == header.pc), s);
+    }
+    for (size_t i = helix.size(); i-- > 0;) {
+        print_frame(helix[i], s);
+    }
+
+    std::printf("\n%s%scrash%s: %s%s%s%s(pid %llu, thread %llu, fault address %s0x%llx%s)\n",
+                s.red,
+                s.bold,
+                s.reset,
+                s.light_red,
+                s.bold,
+                signal_name(header.signal),
+                s.reset,
+                static_cast<unsigned long long>(header.pid),
+                static_cast<unsigned long long>(header.tid),
+                s.light_green,
+                static_cast<unsigned long long>(header.fault_address),
+                s.reset);
+    return true;
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+    if (argc > 2) {
+        std::fprintf(stderr, "usage: %s [record-file]\n", argv[0]);
+        return 2;
+    }
+
+    std::FILE *in = argc == 2 ? std::fopen(argv[1], "rb") : stdin;
+    if (in == nullptr) {
+        std::perror(argv[1]);
+        return 1;
+    }
+
+    const Style style = ::isatty(STDOUT_FILENO) ? Style{} : Style::plain();
+    int         count = 0;
+    while (symbolize_one(in, style)) {
+        ++count;
+    }
+    if (in != stdin) {
+        std::fclose(in);
+    }
+    return count > 0 ? 0 : 1;
+}
@@ -82,4 +82,13 @@ core_setup()
 
 -- Main library target
 target("lib-helix")
-    set_targetdir("$(buildir)/$(mode)/$(arch)-" .. abi .. "-$(os)/lib")
\ No newline at end of file
+    set_targetdir("$(buildir)/$(mode)/$(arch)-" .. abi .. "-$(os)/lib")
+
+-- Offline symbolizer for the records written by std::Crash::install
+if not is_plat("windows") then
+    target("helix-symbolize")
+        set_kind("binary")
+        set_languages("c++23")
+        add_files("core/tools/helix-symbolize.cc")
+        set_targetdir("$(buildir)/$(mode)/$(arch)-" .. abi .. "-$(os)/bin")
+end